@@ -0,0 +1,94 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include "../src/jeu.h"
+#include "../src/soumission.h"
+
+
+/**
+ * @brief Mesure la contention sur un deck partagé : plusieurs fils vident le même deck
+ *        en même temps, pour 1, 2, 4... fils jusqu'au nombre de coeurs (ou plus si demandé).
+ *        Usage : bench_deck [nbAnimaux] [nbFilsMax]
+ */
+
+/**
+ * @struct Tireur
+ * @brief Contexte d'un fil qui pioche dans le deck partagé
+ */
+typedef struct {
+    Deck* deck;
+    Alea alea;      /* Générateur propre au fil */
+    long nbTirees;
+} Tireur;
+
+static char* nomsBench[MAX_ANIMAUX] = {
+    "LION", "OURS", "ELEPHANT", "TIGRE", "ZEBRE", "GIRAFE", "SINGE", "PHOQUE", "CHAMEAU", "LAMA"
+};
+
+/**
+ * @brief Pioche jusqu'à épuisement du deck
+ */
+static int vider(void* arg) {
+    Tireur* t = (Tireur*)arg;
+    while (tirerCarteAvec(t->deck, &t->alea) != NULL) {
+        t->nbTirees++;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 8;
+    int filsMax = (argc > 2) ? atoi(argv[2]) : nombreCoeurs();
+    if (n < 2 || n > MAX_ANIMAUX || filsMax < 1) {
+        fprintf(stderr, "Usage: %s [nbAnimaux 2..%d] [nbFilsMax]\n", argv[0], MAX_ANIMAUX);
+        return EXIT_FAILURE;
+    }
+
+    ConfigJeu config;
+    config.nbAnimaux = n;
+    config.nbOrdres = 0;
+    config.nbMacros = 0;
+    for (int i = 0; i < n; i++) config.nomsAnimaux[i] = nomsBench[i];
+
+    Deck deck;
+    genererToutesPositions(&config, &deck);
+    printf("%d animaux, %d cartes\n", n, deck.nbPositions);
+
+    thrd_t* fils = (thrd_t*)malloc(sizeof(thrd_t) * filsMax);
+    Tireur* tireurs = (Tireur*)malloc(sizeof(Tireur) * filsMax);
+    if (fils == NULL || tireurs == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante.\n");
+        return EXIT_FAILURE;
+    }
+
+    double debitSeul = 0;
+    for (int nbFils = 1; nbFils <= filsMax; nbFils = (nbFils * 2 > filsMax && nbFils != filsMax) ? filsMax : nbFils * 2) {
+        reinitialiserDeck(&deck);
+
+        unsigned long long debut = horodatageNs();
+        for (int i = 0; i < nbFils; i++) {
+            tireurs[i].deck = &deck;
+            initAlea(&tireurs[i].alea, (uint64_t)i + 1);
+            tireurs[i].nbTirees = 0;
+            thrd_create(&fils[i], vider, &tireurs[i]);
+        }
+        long total = 0;
+        for (int i = 0; i < nbFils; i++) {
+            thrd_join(fils[i], NULL);
+            total += tireurs[i].nbTirees;
+        }
+        double secondes = (double)(horodatageNs() - debut) / 1e9;
+
+        double debit = total / secondes;
+        if (nbFils == 1) debitSeul = debit;
+        printf("%3d fils : %10.0f tirages/s  acceleration x%.2f  %s\n", nbFils, debit, debit / debitSeul,
+               total == deck.nbPositions ? "ok" : "ERREUR : cartes tirees en double ou perdues");
+        if (nbFils == filsMax) break;
+    }
+
+    free(tireurs);
+    free(fils);
+    libererDeck(&deck);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,287 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include "../src/jeu.h"
+#include "../src/soumission.h"
+
+
+/**
+ * @brief Microbenchmarks du moteur : ordres, séquences, copie et comparaison d'états, génération
+ *        des positions et vidage du deck. Les résultats sont écrits en JSON sur la sortie standard.
+ *        Usage : bench_moteur [nbAnimauxMax]   (génération des positions de 3 à nbAnimauxMax, 8 par défaut)
+ *        Les allocations ne sont comptées que si le programme est lié avec
+ *        -DCOMPTER_ALLOCATIONS -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+ */
+
+/**
+ * @def DUREE_MIN_NS
+ * @brief Durée mesurée minimale de chaque benchmark
+ */
+#define DUREE_MIN_NS 200000000ULL
+
+/**
+ * @def LOT_ETATS
+ * @brief Nombre d'états préparés hors chronomètre avant chaque passe mesurée
+ */
+#define LOT_ETATS 256
+
+
+/**
+ * @struct Mesure
+ * @brief Résultat d'un benchmark
+ */
+typedef struct {
+    const char* nom;
+    int nbAnimaux;
+    long iterations;
+    double nsParOp;
+    double allocationsParOp;
+    long picRss;              /* Pic de mémoire résidente à la fin de la mesure, en Ko */
+} Mesure;
+
+static char* nomsBench[MAX_ANIMAUX] = {
+    "LION", "OURS", "ELEPHANT", "TIGRE", "ZEBRE", "GIRAFE", "SINGE", "PHOQUE", "CHAMEAU", "LAMA"
+};
+
+static long nbAllocations = 0;
+
+#ifdef COMPTER_ALLOCATIONS
+void* __real_malloc(size_t taille);
+void* __real_calloc(size_t nb, size_t taille);
+void* __real_realloc(void* p, size_t taille);
+
+void* __wrap_malloc(size_t taille) {
+    nbAllocations++;
+    return __real_malloc(taille);
+}
+
+void* __wrap_calloc(size_t nb, size_t taille) {
+    nbAllocations++;
+    return __real_calloc(nb, taille);
+}
+
+void* __wrap_realloc(void* p, size_t taille) {
+    nbAllocations++;
+    return __real_realloc(p, taille);
+}
+#define ALLOCATIONS_COMPTEES 1
+#else
+#define ALLOCATIONS_COMPTEES 0
+#endif
+
+/**
+ * @brief Pic de mémoire résidente du processus
+ * @return long Le pic en kilo-octets
+ */
+static long picRssKo(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return -1;
+    return (long)(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * @brief Écrit une mesure au format JSON
+ * @param[in] m La mesure
+ * @param[in] derniere 1 si aucune mesure ne suit
+ */
+static void ecrireMesure(const Mesure* m, int derniere) {
+    printf("    {\"nom\": \"%s\", \"animaux\": %d, \"iterations\": %ld, \"ns_par_op\": %.2f, ",
+           m->nom, m->nbAnimaux, m->iterations, m->nsParOp);
+    if (ALLOCATIONS_COMPTEES) printf("\"allocations_par_op\": %.2f, ", m->allocationsParOp);
+    else printf("\"allocations_par_op\": null, ");
+    printf("\"pic_rss_ko\": %ld}%s\n", m->picRss, derniere ? "" : ",");
+}
+
+/**
+ * @brief Construit l'état de départ des benchmarks : la moitié des animaux sur chaque podium,
+ *        pour que tous les ordres soient possibles
+ * @param[out] e L'état
+ * @param[in] n Nombre d'animaux
+ */
+static void etatDeDepart(EtatJeu* e, int n) {
+    initEtat(e);
+    for (int i = 0; i < n / 2; i++) empiler(&e->podiumBleu, nomsBench[i]);
+    for (int i = n / 2; i < n; i++) empiler(&e->podiumRouge, nomsBench[i]);
+}
+
+
+/* Opérations mesurées sur un lot d'états : arg est propre à chaque opération */
+typedef void (*Operation)(EtatJeu* e, const void* arg);
+
+static void opCommande(EtatJeu* e, const void* arg) {
+    int (*commande)(EtatJeu*) = *(int (* const*)(EtatJeu*))arg;
+    commande(e);
+}
+
+static void opSequence(EtatJeu* e, const void* arg) {
+    executerSequence(e, (const char*)arg);
+}
+
+static void opCopie(EtatJeu* e, const void* arg) {
+    copierEtat((const EtatJeu*)arg, e);
+}
+
+static volatile int puitsComparaison;
+
+static void opComparaison(EtatJeu* e, const void* arg) {
+    puitsComparaison += estMemeEtat(e, (const EtatJeu*)arg);
+}
+
+/**
+ * @brief Applique une opération à chaque état d'un lot remis à neuf hors chronomètre, jusqu'à
+ *        atteindre DUREE_MIN_NS de temps mesuré
+ * @param[in] nom Nom du benchmark
+ * @param[in] depart État recopié dans chaque case du lot avant chaque passe
+ * @param[in] n Nombre d'animaux
+ * @param[in] op L'opération
+ * @param[in] arg Son argument
+ * @return Mesure Le résultat
+ */
+static Mesure mesurerSurLot(const char* nom, const EtatJeu* depart, int n, Operation op, const void* arg) {
+    static EtatJeu lot[LOT_ETATS];
+    unsigned long long duree = 0;
+    long allocations = 0;
+    long iterations = 0;
+
+    for (int i = 0; i < LOT_ETATS; i++) initEtat(&lot[i]);
+
+    while (duree < DUREE_MIN_NS) {
+        for (int i = 0; i < LOT_ETATS; i++) copierEtat(depart, &lot[i]);
+
+        long allocAvant = nbAllocations;
+        unsigned long long debut = horodatageNs();
+        for (int i = 0; i < LOT_ETATS; i++) op(&lot[i], arg);
+        duree += horodatageNs() - debut;
+        allocations += nbAllocations - allocAvant;
+        iterations += LOT_ETATS;
+    }
+
+    for (int i = 0; i < LOT_ETATS; i++) libererEtat(&lot[i]);
+
+    Mesure m = { nom, n, iterations, (double)duree / iterations, (double)allocations / iterations, picRssKo() };
+    return m;
+}
+
+/**
+ * @brief Génère toutes les positions jusqu'à atteindre DUREE_MIN_NS (au moins une fois)
+ * @param[in] config Configuration à n animaux
+ * @return Mesure Le résultat, par génération complète
+ */
+static Mesure mesurerGeneration(const ConfigJeu* config) {
+    unsigned long long duree = 0;
+    long allocations = 0;
+    long iterations = 0;
+
+    while (duree < DUREE_MIN_NS || iterations == 0) {
+        Deck deck;
+        long allocAvant = nbAllocations;
+        unsigned long long debut = horodatageNs();
+        genererToutesPositions(config, &deck);
+        duree += horodatageNs() - debut;
+        allocations += nbAllocations - allocAvant;
+        iterations++;
+        libererDeck(&deck);
+    }
+
+    Mesure m = { "genererToutesPositions", config->nbAnimaux, iterations, (double)duree / iterations,
+                 (double)allocations / iterations, picRssKo() };
+    return m;
+}
+
+/**
+ * @brief Vide entièrement le deck, carte par carte, jusqu'à atteindre DUREE_MIN_NS
+ * @param[in,out] deck Deck généré, remis à neuf hors chronomètre avant chaque vidage
+ * @param[in] n Nombre d'animaux
+ * @return Mesure Le résultat, par carte tirée
+ */
+static Mesure mesurerTirage(Deck* deck, int n) {
+    unsigned long long duree = 0;
+    long allocations = 0;
+    long iterations = 0;
+
+    amorcerDeck(deck, 1);
+    while (duree < DUREE_MIN_NS) {
+        reinitialiserDeck(deck);
+
+        long allocAvant = nbAllocations;
+        unsigned long long debut = horodatageNs();
+        while (tirerNouvelleCarte(deck) != NULL) iterations++;
+        duree += horodatageNs() - debut;
+        allocations += nbAllocations - allocAvant;
+    }
+
+    Mesure m = { "tirerNouvelleCarte", n, iterations, (double)duree / iterations, (double)allocations / iterations,
+                 picRssKo() };
+    return m;
+}
+
+int main(int argc, char* argv[]) {
+    int nMax = (argc > 1) ? atoi(argv[1]) : 8;
+    if (nMax < 3 || nMax > MAX_ANIMAUX) {
+        fprintf(stderr, "Usage: %s [nbAnimauxMax 3..%d]\n", argv[0], MAX_ANIMAUX);
+        return EXIT_FAILURE;
+    }
+
+    ConfigJeu config;
+    config.nbOrdres = 0;
+    config.nbMacros = 0;
+    for (int i = 0; i < MAX_ANIMAUX; i++) config.nomsAnimaux[i] = nomsBench[i];
+
+    /* Séquence typique d'un joueur, et plus longue séquence valide qui tient sur une ligne */
+    const char* realiste = "KISONILOMA";
+    char pireCas[LEN_CMD];
+    pireCas[0] = '\0';
+    while (strlen(pireCas) + 8 < LEN_CMD - 16) strcat(pireCas, "NIMASOSO");
+
+    Mesure mesures[64];
+    int nb = 0;
+
+    static const int tailles[] = { 4, MAX_ANIMAUX };
+    for (size_t t = 0; t < sizeof(tailles) / sizeof(tailles[0]); t++) {
+        int n = tailles[t];
+        EtatJeu depart;
+        etatDeDepart(&depart, n);
+
+        static const char* nomsCommandes[] = { "commandeKI", "commandeLO", "commandeSO", "commandeNI", "commandeMA" };
+        int (*commandes[])(EtatJeu*) = { commandeKI, commandeLO, commandeSO, commandeNI, commandeMA };
+        for (int c = 0; c < 5; c++) {
+            mesures[nb++] = mesurerSurLot(nomsCommandes[c], &depart, n, opCommande, &commandes[c]);
+        }
+        mesures[nb++] = mesurerSurLot("executerSequence/realiste", &depart, n, opSequence, realiste);
+        mesures[nb++] = mesurerSurLot("executerSequence/pire_cas", &depart, n, opSequence, pireCas);
+        mesures[nb++] = mesurerSurLot("copierEtat", &depart, n, opCopie, &depart);
+        mesures[nb++] = mesurerSurLot("estMemeEtat", &depart, n, opComparaison, &depart);
+
+        libererEtat(&depart);
+    }
+
+    for (int n = 3; n <= nMax; n++) {
+        config.nbAnimaux = n;
+        mesures[nb++] = mesurerGeneration(&config);
+    }
+
+    config.nbAnimaux = nMax;
+    Deck deck;
+    genererToutesPositions(&config, &deck);
+    mesures[nb++] = mesurerTirage(&deck, nMax);
+    libererDeck(&deck);
+
+    printf("{\n  \"bench\": \"moteur\",\n  \"allocations_comptees\": %s,\n  \"mesures\": [\n",
+           ALLOCATIONS_COMPTEES ? "true" : "false");
+    for (int i = 0; i < nb; i++) ecrireMesure(&mesures[i], i == nb - 1);
+    printf("  ],\n  \"pic_rss_ko\": %ld\n}\n", picRssKo());
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/noyaux.h"
+#include "../src/soumission.h"
+
+
+/**
+ * @brief Compare le noyau spécialisé de chaque nombre d'animaux au noyau générique : rang,
+ *        etatDeRang, voisins par les cinq ordres et parcours en largeur complet depuis l'état
+ *        canonique. Les deux noyaux sont d'abord vérifiés l'un contre l'autre sur les mêmes
+ *        états. Usage : bench_noyaux [nbAnimauxMax]   (de 3 à nbAnimauxMax, 9 par défaut)
+ */
+
+/**
+ * @def NB_RANGS
+ * @brief Nombre de rangs tirés au hasard pour les mesures unitaires
+ */
+#define NB_RANGS 65536
+
+/**
+ * @def DUREE_MIN_NS
+ * @brief Durée mesurée minimale de chaque opération unitaire
+ */
+#define DUREE_MIN_NS 100000000ULL
+
+static const int tousOrdres[NB_ORDRES_CONNUS] = { ORDRE_KI, ORDRE_LO, ORDRE_SO, ORDRE_NI, ORDRE_MA };
+
+static volatile uint32_t puits;
+
+
+/**
+ * @brief Durée moyenne d'une opération sur les rangs tirés, en ns
+ * @param[in] k Le noyau
+ * @param[in] n Nombre d'animaux
+ * @param[in] rangs Les rangs tirés
+ * @param[in] op 0 rang, 1 etatDeRang, 2 voisins
+ */
+static double mesurer(const Noyau* k, int n, const uint32_t* rangs, const EtatCompact* etats, int op) {
+    long iterations = 0;
+    uint32_t acc = 0;
+    unsigned long long debut = horodatageNs(), duree;
+
+    do {
+        for (int i = 0; i < NB_RANGS; i++) {
+            if (op == 0) acc += k->rangEtat(&etats[i]);
+            else if (op == 1) {
+                EtatCompact e;
+                k->etatDeRang(rangs[i], n, &e);
+                acc += e.animaux[i % n];
+            }
+            else {
+                uint32_t voisins[NB_ORDRES_CONNUS];
+                k->voisins(rangs[i], n, tousOrdres, NB_ORDRES_CONNUS, voisins);
+                acc += voisins[i % NB_ORDRES_CONNUS];
+            }
+        }
+        iterations += NB_RANGS;
+        duree = horodatageNs() - debut;
+    } while (duree < DUREE_MIN_NS);
+
+    puits = acc;
+    return (double)duree / (double)iterations;
+}
+
+/**
+ * @brief Parcours en largeur complet depuis l'état canonique de hauteur 0
+ * @return double Durée en secondes
+ */
+static double parcourir(const Noyau* k, int n, uint32_t nbEtats, uint8_t* vu, uint32_t* file) {
+    unsigned long long debut = horodatageNs();
+    for (uint32_t r = 0; r < nbEtats; r++) vu[r] = 0;
+
+    uint32_t tete = 0, fin = 0;
+    file[fin++] = 0;
+    vu[0] = 1;
+    while (tete < fin) {
+        uint32_t voisins[NB_ORDRES_CONNUS];
+        k->voisins(file[tete++], n, tousOrdres, NB_ORDRES_CONNUS, voisins);
+        for (int o = 0; o < NB_ORDRES_CONNUS; o++) {
+            uint32_t q = voisins[o];
+            if (q == RANG_IMPOSSIBLE || vu[q]) continue;
+            vu[q] = 1;
+            file[fin++] = q;
+        }
+    }
+    puits = fin;
+    return (double)(horodatageNs() - debut) / 1e9;
+}
+
+/**
+ * @brief Vérifie que les deux noyaux donnent les mêmes résultats sur les rangs tirés
+ * @return int Nombre de différences
+ */
+static int verifier(const Noyau* spe, const Noyau* gen, int n, const uint32_t* rangs) {
+    int erreurs = 0;
+    for (int i = 0; i < NB_RANGS; i++) {
+        EtatCompact a, b;
+        spe->etatDeRang(rangs[i], n, &a);
+        gen->etatDeRang(rangs[i], n, &b);
+        erreurs += !gen->estMemeEtat(&a, &b) || !spe->estMemeEtat(&a, &b);
+        erreurs += spe->rangEtat(&a) != rangs[i];
+
+        uint32_t va[NB_ORDRES_CONNUS], vb[NB_ORDRES_CONNUS];
+        spe->voisins(rangs[i], n, tousOrdres, NB_ORDRES_CONNUS, va);
+        gen->voisins(rangs[i], n, tousOrdres, NB_ORDRES_CONNUS, vb);
+        for (int o = 0; o < NB_ORDRES_CONNUS; o++) {
+            erreurs += va[o] != vb[o];
+            EtatCompact x = a, y = b;
+            int rx = spe->appliquerOrdre(&x, tousOrdres[o]), ry = gen->appliquerOrdre(&y, tousOrdres[o]);
+            erreurs += rx != ry || !gen->estMemeEtat(&x, &y);
+        }
+    }
+    return erreurs;
+}
+
+int main(int argc, char* argv[]) {
+    int nMax = (argc > 1) ? atoi(argv[1]) : 9;
+    if (nMax < NOYAU_MIN || nMax > MAX_ANIMAUX) {
+        fprintf(stderr, "Usage: %s [nbAnimauxMax %d..%d]\n", argv[0], NOYAU_MIN, MAX_ANIMAUX);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t* rangs = (uint32_t*)malloc(sizeof(uint32_t) * NB_RANGS);
+    EtatCompact* etats = (EtatCompact*)malloc(sizeof(EtatCompact) * NB_RANGS);
+    uint8_t* vu = (uint8_t*)malloc(nbEtatsPossibles(nMax));
+    uint32_t* file = (uint32_t*)malloc(sizeof(uint32_t) * nbEtatsPossibles(nMax));
+    if (rangs == NULL || etats == NULL || vu == NULL || file == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante.\n");
+        return EXIT_FAILURE;
+    }
+
+    const Noyau* gen = noyauGenerique();
+    int echec = 0;
+    printf("  n | noyau      | rang (ns) | etatDeRang (ns) | voisins (ns) | parcours (s) | gain parcours\n");
+    for (int n = NOYAU_MIN; n <= nMax; n++) {
+        const Noyau* spe = choisirNoyau(n);
+        uint32_t nbEtats = nbEtatsPossibles(n);
+        Alea alea;
+        initAlea(&alea, (uint64_t)n);
+        for (int i = 0; i < NB_RANGS; i++) {
+            rangs[i] = tirerBorne(&alea, nbEtats);
+            etatDeRang(rangs[i], n, &etats[i]);
+        }
+
+        int erreurs = verifier(spe, gen, n, rangs);
+        echec |= (erreurs != 0 || spe->nbAnimaux != n);
+
+        double parcours[2];
+        const Noyau* noyaux[2] = { gen, spe };
+        for (int v = 0; v < 2; v++) {
+            const Noyau* k = noyaux[v];
+            double r = mesurer(k, n, rangs, etats, 0);
+            double d = mesurer(k, n, rangs, etats, 1);
+            double w = mesurer(k, n, rangs, etats, 2);
+            parcours[v] = parcourir(k, n, nbEtats, vu, file);
+            printf("%3d | %-10s | %9.2f | %15.2f | %12.2f | %12.3f |", n, v == 0 ? "generique" : "specialise", r, d, w, parcours[v]);
+            if (v == 1) printf(" x%.2f%s", parcours[0] / parcours[1], erreurs ? "  ERREUR" : "");
+            printf("\n");
+        }
+    }
+
+    free(file);
+    free(vu);
+    free(etats);
+    free(rangs);
+    return echec ? EXIT_FAILURE : EXIT_SUCCESS;
+}
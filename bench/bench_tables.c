@@ -0,0 +1,221 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/moteur.h"
+#include "../src/roue.h"
+#include "../src/composantes.h"
+#include "../src/memoire.h"
+#include "../src/soumission.h"
+
+
+/**
+ * @brief Mène de nombreuses parties depuis un seul fil par le moteur : chaque table a son
+ *        contexte, son deck (positions partagées) et ses joueurs, qui soumettent à tour de rôle
+ *        des séquences tirées au hasard. Une partie finie recommence avec son deck remis à neuf.
+ *        Chaque tour a un délai, suivi par une seule roue pour toutes les tables sur une horloge
+ *        simulée (un top toutes les SOUMISSIONS_PAR_TOP soumissions) : un tour échu passe par
+ *        expirerTour. Compilé avec -DCOMPTER_ALLOCATIONS et les options --wrap, vérifie aussi
+ *        qu'aucune soumission ni aucune minuterie n'alloue.
+ *        Usage : bench_tables [nbAnimaux] [nbTables] [nbSoumissions] [delaiTour en tops, 0 sans délai]
+ */
+
+/**
+ * @def JOUEURS_PAR_TABLE
+ * @brief Joueurs inscrits à chaque table
+ */
+#define JOUEURS_PAR_TABLE 3
+
+/**
+ * @def ORDRES_PAR_SEQUENCE
+ * @brief Longueur maximale des séquences tirées
+ */
+#define ORDRES_PAR_SEQUENCE 4
+
+/**
+ * @def SOUMISSIONS_PAR_TOP
+ * @brief Soumissions reçues, toutes tables confondues, pendant un top de l'horloge simulée
+ */
+#define SOUMISSIONS_PAR_TOP 100
+
+/**
+ * @struct Table
+ * @brief Une partie menée par le banc
+ */
+typedef struct {
+    Registre registre;
+    Classement classement;
+    Deck deck;
+    Alea alea;
+    ContexteJeu ctx;
+    Minuterie finTour;
+} Table;
+
+static char* nomsBench[MAX_ANIMAUX] = {
+    "LION", "OURS", "ELEPHANT", "TIGRE", "ZEBRE", "GIRAFE", "SINGE", "PHOQUE", "CHAMEAU", "LAMA"
+};
+
+static char* ordresBench[] = { "KI", "LO", "SO", "NI", "MA" };
+
+static char* joueursBench[JOUEURS_PAR_TABLE] = { "A", "B", "C" };
+
+static unsigned long long nbAllocations = 0;
+
+#ifdef COMPTER_ALLOCATIONS
+void* __real_malloc(size_t taille);
+void* __real_calloc(size_t nb, size_t taille);
+void* __real_realloc(void* p, size_t taille);
+
+void* __wrap_malloc(size_t taille) {
+    nbAllocations++;
+    return __real_malloc(taille);
+}
+
+void* __wrap_calloc(size_t nb, size_t taille) {
+    nbAllocations++;
+    return __real_calloc(nb, taille);
+}
+
+void* __wrap_realloc(void* p, size_t taille) {
+    nbAllocations++;
+    return __real_realloc(p, taille);
+}
+#define ALLOCATIONS_COMPTEES 1
+#else
+#define ALLOCATIONS_COMPTEES 0
+#endif
+
+/**
+ * @brief Tire une séquence de 1 à ORDRES_PAR_SEQUENCE ordres connus
+ */
+static void tirerSequence(Alea* alea, char* sequence) {
+    int nb = 1 + (int)tirerBorne(alea, ORDRES_PAR_SEQUENCE);
+    for (int i = 0; i < nb; i++) {
+        const char* ordre = ordresBench[tirerBorne(alea, 5)];
+        sequence[2 * i] = ordre[0];
+        sequence[2 * i + 1] = ordre[1];
+    }
+    sequence[2 * nb] = '\0';
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 5;
+    int nbTables = (argc > 2) ? atoi(argv[2]) : 1000;
+    long nbSoumissions = (argc > 3) ? atol(argv[3]) : 2000000;
+    int delaiTour = (argc > 4) ? atoi(argv[4]) : 20;
+    if (n < 3 || n > MAX_ANIMAUX || nbTables < 1 || nbSoumissions < 1 || delaiTour < 0) {
+        fprintf(stderr, "Usage: %s [nbAnimaux 3..%d] [nbTables] [nbSoumissions] [delaiTour]\n", argv[0], MAX_ANIMAUX);
+        return EXIT_FAILURE;
+    }
+
+    ConfigJeu config;
+    config.nbAnimaux = n;
+    config.nbOrdres = 5;
+    config.nbMacros = 0;
+    for (int i = 0; i < n; i++) config.nomsAnimaux[i] = nomsBench[i];
+    for (int i = 0; i < 5; i++) config.ordres[i] = ordresBench[i];
+    config.noyau = choisirNoyau(n);
+
+    Deck modele;
+    genererToutesPositions(&config, &modele);
+    calculerComposantes(&modele, &config, nombreCoeurs());
+
+    CacheEffets effets;
+    initCacheEffets(&effets, EFFETS_CAPACITE);
+
+    Table* tables = (Table*)malloc(sizeof(Table) * nbTables);
+    if (tables == NULL) {
+        fprintf(stderr, "Memoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+    RoueTemps roue;
+    initRoue(&roue, 0);
+
+    for (int t = 0; t < nbTables; t++) {
+        Table* tb = &tables[t];
+        initRegistre(&tb->registre);
+        for (int j = 0; j < JOUEURS_PAR_TABLE; j++) ajouterJoueur(&tb->registre, joueursBench[j]);
+        initClassement(&tb->classement, &tb->registre);
+        partagerPositions(&modele, &tb->deck);
+        initAlea(&tb->alea, (uint64_t)t + 1);
+        ContexteJeu ctx = { &config, &tb->registre, &tb->classement, &tb->deck, &tb->alea, &effets, NULL, 0, 0,
+                            NULL, NULL, 0, NULL, NULL, 0 };
+        tb->ctx = ctx;
+        commencerPartie(&tb->ctx);
+        initMinuterie(&tb->finTour, tb, 0);
+        if (delaiTour > 0) armerMinuterie(&roue, &tb->finTour, (uint64_t)delaiTour);
+    }
+
+    long nbEvenements = 0, nbTours = 0, nbParties = 0, nbRefus = 0, nbEchus = 0;
+    unsigned long long allocations = 0;
+    char sequence[2 * ORDRES_PAR_SEQUENCE + 1];
+    EvenementJeu evts[JEU_EVENEMENTS_MAX];
+
+    unsigned long long debut = horodatageNs();
+    for (long i = 0; i < nbSoumissions; i++) {
+        uint64_t top = (uint64_t)(i / SOUMISSIONS_PAR_TOP);
+        unsigned long long avant = nbAllocations;
+
+        /* Les tours échus finissent comme ceux où tous ont échoué */
+        if (delaiTour > 0 && i % SOUMISSIONS_PAR_TOP == 0) {
+            Minuterie* m = avancerRoue(&roue, top);
+            while (m != NULL) {
+                Minuterie* suivante = m->suivante;
+                Table* tb = (Table*)m->donnees;
+                int nb = expirerTour(&tb->ctx, evts);
+                if (nb > 0 && evts[nb - 1].type == EVENEMENT_FIN_PARTIE) {
+                    nbParties++;
+                    reinitialiserDeck(&tb->deck);
+                    commencerPartie(&tb->ctx);
+                }
+                armerMinuterie(&roue, m, top + (uint64_t)delaiTour);
+                nbEchus++;
+                nbTours++;
+                m = suivante;
+            }
+        }
+
+        Table* tb = &tables[i % nbTables];
+        int joueur = (int)tirerBorne(&tb->alea, JOUEURS_PAR_TABLE);
+        tirerSequence(&tb->alea, sequence);
+
+        int nb = soumettre(&tb->ctx, joueur, sequence, evts);
+        if (nb > 0 && delaiTour > 0) {
+            int type = evts[nb - 1].type;
+            if (type == EVENEMENT_NOUVEAU_TOUR || type == EVENEMENT_FIN_PARTIE) {
+                armerMinuterie(&roue, &tb->finTour, top + (uint64_t)delaiTour);
+            }
+        }
+        allocations += nbAllocations - avant;
+
+        if (nb < 0) {
+            nbRefus++;
+            continue;
+        }
+        nbEvenements += nb;
+        int type = evts[nb - 1].type;
+        if (type == EVENEMENT_NOUVEAU_TOUR || type == EVENEMENT_FIN_PARTIE) nbTours++;
+        if (type == EVENEMENT_FIN_PARTIE) {
+            nbParties++;
+            reinitialiserDeck(&tb->deck);
+            commencerPartie(&tb->ctx);
+        }
+    }
+    double secondes = (double)(horodatageNs() - debut) / 1e9;
+
+    printf("%d animaux, %d tables sur un fil : %ld soumissions en %.3f s (%.0f soumissions/s, %.0f ns chacune)\n", n,
+           nbTables, nbSoumissions, secondes, (double)nbSoumissions / secondes, secondes * 1e9 / (double)nbSoumissions);
+    printf("%ld evenements, %ld tours dont %ld echus (delai de %d tops), %ld parties finies, %ld refus\n", nbEvenements,
+           nbTours, nbEchus, delaiTour, nbParties, nbRefus);
+    if (ALLOCATIONS_COMPTEES) printf("Allocations pendant les soumissions et les minuteries : %llu\n", allocations);
+    ecrireCacheEffets(&effets, stdout);
+
+    for (int t = 0; t < nbTables; t++) {
+        libererDeck(&tables[t].deck);
+        libererClassement(&tables[t].classement);
+        libererRegistre(&tables[t].registre);
+    }
+    free(tables);
+    libererCacheEffets(&effets);
+    libererDeck(&modele);
+    return ALLOCATIONS_COMPTEES && allocations != 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/jeu.h"
+#include "../src/composantes.h"
+#include "../src/distances.h"
+#include "../src/solveur.h"
+#include "../src/soumission.h"
+
+
+/**
+ * @brief Mesure la durée d'un tirage par bande de difficulté : pour chaque distance, des
+ *        objectifs sont tirés à la suite comme dans une partie (l'objectif devient la position
+ *        de départ suivante). Les premiers tirages de chaque bande sont vérifiés par le solveur.
+ *        Échoue si une bande dépasse BUDGET_TIRAGE_US au 99e centile ou donne une fausse distance.
+ *        Usage : bench_tirage [nbAnimaux] [nbTirages] [nbVerifies]
+ */
+
+/* Durée maximale d'un tirage au 99e centile, en microsecondes */
+#define BUDGET_TIRAGE_US 1000.0
+
+static char* nomsBench[MAX_ANIMAUX] = {
+    "LION", "OURS", "ELEPHANT", "TIGRE", "ZEBRE", "GIRAFE", "SINGE", "PHOQUE", "CHAMEAU", "LAMA"
+};
+
+static char* ordresBench[] = { "KI", "LO", "SO", "NI", "MA" };
+
+static int comparerDurees(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 9;
+    int nbTirages = (argc > 2) ? atoi(argv[2]) : 200;
+    int nbVerifies = (argc > 3) ? atoi(argv[3]) : 3;
+    if (n < 3 || n > MAX_ANIMAUX || nbTirages < 1) {
+        fprintf(stderr, "Usage: %s [nbAnimaux 3..%d] [nbTirages] [nbVerifies]\n", argv[0], MAX_ANIMAUX);
+        return EXIT_FAILURE;
+    }
+
+    ConfigJeu config;
+    config.nbAnimaux = n;
+    config.nbOrdres = 5;
+    config.nbMacros = 0;
+    for (int i = 0; i < n; i++) config.nomsAnimaux[i] = nomsBench[i];
+    for (int i = 0; i < 5; i++) config.ordres[i] = ordresBench[i];
+    config.noyau = choisirNoyau(n);
+
+    Deck deck;
+    genererToutesPositions(&config, &deck);
+    calculerComposantes(&deck, &config, nombreCoeurs());
+
+    unsigned long long debut = horodatageNs();
+    Distances distances;
+    calculerDistances(&distances, &deck, &config, nombreCoeurs());
+    printf("%d animaux, %d cartes, distances calculees en %.2f s sur %d fils\n", n, deck.nbPositions,
+           (double)(horodatageNs() - debut) / 1e9, nombreCoeurs());
+
+    int distanceMax = 0;
+    for (int h = 0; h <= n; h++) {
+        if (distances.niveaux[h].distanceMax > distanceMax) distanceMax = distances.niveaux[h].distanceMax;
+    }
+
+    Solveur solveur;
+    initSolveur(&solveur, &config);
+    unsigned long long* durees = (unsigned long long*)malloc(sizeof(unsigned long long) * nbTirages);
+    if (durees == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante.\n");
+        return EXIT_FAILURE;
+    }
+
+    int echecs = 0;
+    printf("bande | tirages | vides | p50 (us) | p99 (us) | max (us) | verifies\n");
+    for (int d = 1; d <= distanceMax; d++) {
+        reinitialiserDeck(&deck);
+        Alea alea;
+        initAlea(&alea, (uint64_t)d);
+        EtatJeu* courant = tirerCarteAvec(&deck, &alea);
+
+        int vides = 0, verifies = 0, justes = 0;
+        for (int t = 0; t < nbTirages; t++) {
+            unsigned long long t0 = horodatageNs();
+            EtatJeu* objectif = tirerCarteDifficulte(&distances, &deck, &alea, &config, courant, d, d);
+            durees[t] = horodatageNs() - t0;
+
+            if (objectif == NULL) {
+                /* Aucune carte à cette distance depuis cette hauteur : on change de départ */
+                vides++;
+                courant = tirerCarteAvec(&deck, &alea);
+                continue;
+            }
+            if (verifies < nbVerifies) {
+                EtatCompact depart, arrivee;
+                int coups[COUPS_MAX];
+                compacterEtat(&config, courant, &depart);
+                compacterEtat(&config, objectif, &arrivee);
+                verifies++;
+                justes += (resoudre(&solveur, &depart, &arrivee, coups) == d);
+            }
+            courant = objectif;
+        }
+
+        qsort(durees, (size_t)nbTirages, sizeof(unsigned long long), comparerDurees);
+        double p99 = durees[(long long)nbTirages * 99 / 100] / 1e3;
+        int horsBudget = (p99 > BUDGET_TIRAGE_US);
+        echecs += horsBudget + (justes != verifies);
+        printf("%5d | %7d | %5d | %8.1f | %8.1f | %8.1f | %d/%d%s%s\n", d, nbTirages, vides, durees[nbTirages / 2] / 1e3,
+               p99, durees[nbTirages - 1] / 1e3, justes, verifies, justes == verifies ? "" : "  ERREUR",
+               horsBudget ? "  HORS BUDGET" : "");
+    }
+
+    free(durees);
+    libererSolveur(&solveur);
+    libererDistances(&distances);
+    libererDeck(&deck);
+    if (echecs > 0) {
+        printf("%d bande(s) en echec (budget p99 : %.0f us)\n", echecs, BUDGET_TIRAGE_US);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,812 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "../src/jeu.h"
+#include "../src/etatcompact.h"
+#include "../src/soumission.h"
+#include "../src/effets.h"
+#include "../src/alea.h"
+
+
+/**
+ * @brief Test différentiel du moteur : le moteur à piles de jeu.c sert de référence, chaque
+ *        autre moteur doit rendre le même verdict et le même état final sur des cas tirés au
+ *        hasard (ordres inconnus, longueurs impaires, podiums vides compris). Un cas qui diverge
+ *        est réduit avant d'être affiché. Avant le tirage, des séquences plus longues qu'une clé
+ *        du cache des effets sont jugées comme le ferait le moteur de partie, et comparées à la
+ *        référence ; puis des séquences de macros, avec des tables tirées au hasard, sont
+ *        comparées à leur développement en ordres de base.
+ *        Usage : fuzz_moteur [secondes (0 = sans fin)] [graine] [nbFils]
+ */
+
+/**
+ * @def LONGUEUR_MAX
+ * @brief Nombre maximum d'ordres d'une séquence tirée
+ */
+#define LONGUEUR_MAX 12
+
+/**
+ * @def ORDRES_LONGS
+ * @brief Nombre d'ordres des séquences longues, au-delà de EFFETS_ORDRES_MAX
+ */
+#define ORDRES_LONGS 150
+
+/**
+ * @def NB_CAS_LONGS
+ * @brief Nombre de séquences longues vérifiées
+ */
+#define NB_CAS_LONGS 256
+
+/**
+ * @def NB_TABLES_MACROS
+ * @brief Nombre de tables de macros tirées au hasard
+ */
+#define NB_TABLES_MACROS 512
+
+/**
+ * @def CAS_PAR_TABLE
+ * @brief Nombre de séquences jouées avec chaque table de macros
+ */
+#define CAS_PAR_TABLE 256
+
+/**
+ * @def ORDRES_PAR_MACRO
+ * @brief Nombre maximum d'ordres et de macros dans la suite d'une macro tirée
+ */
+#define ORDRES_PAR_MACRO 6
+
+/**
+ * @def DEVELOPPEMENT_MAX
+ * @brief Nombre maximum d'ordres de base d'une macro une fois développée
+ */
+#define DEVELOPPEMENT_MAX 64
+
+/**
+ * @def CAS_PAR_LOT
+ * @brief Nombre de cas joués entre deux lectures de l'horloge et du drapeau d'arrêt
+ */
+#define CAS_PAR_LOT 4096
+
+
+/**
+ * @struct Cas
+ * @brief Un cas de test : état de départ et séquence, en représentation compacte commune
+ */
+typedef struct {
+    EtatCompact depart;
+    char sequence[2 * LONGUEUR_MAX + 2];
+} Cas;
+
+/**
+ * @struct Moteur
+ * @brief Un moteur à comparer. Chaque fil crée sa propre instance
+ */
+typedef struct {
+    const char* nom;
+    void* (*creer)(const ConfigJeu* config);
+    void (*charger)(void* m, const EtatCompact* depart);
+    int (*executer)(void* m, const char* seq);        /* Même convention que executerSequence */
+    void (*lire)(void* m, EtatCompact* fin);
+    void (*detruire)(void* m);
+} Moteur;
+
+/**
+ * @struct Resultat
+ * @brief Ce qu'un moteur rend pour un cas
+ */
+typedef struct {
+    int verdict;
+    EtatCompact fin;
+} Resultat;
+
+
+/* Moteur de référence : piles chaînées de jeu.c */
+typedef struct {
+    const ConfigJeu* config;
+    EtatJeu etat;
+} MoteurPiles;
+
+static void* creerPiles(const ConfigJeu* config) {
+    MoteurPiles* m = (MoteurPiles*)malloc(sizeof(MoteurPiles));
+    if (m == NULL) return NULL;
+    m->config = config;
+    initEtat(&m->etat);
+    return m;
+}
+
+static void chargerPiles(void* m, const EtatCompact* depart) {
+    MoteurPiles* p = (MoteurPiles*)m;
+    developperEtat(p->config, depart, &p->etat);
+}
+
+static int executerPiles(void* m, const char* seq) {
+    return executerSequence(&((MoteurPiles*)m)->etat, seq);
+}
+
+static void lirePiles(void* m, EtatCompact* fin) {
+    MoteurPiles* p = (MoteurPiles*)m;
+    compacterEtat(p->config, &p->etat, fin);
+}
+
+static void detruirePiles(void* m) {
+    libererEtat(&((MoteurPiles*)m)->etat);
+    free(m);
+}
+
+/* Moteur compact d'etatcompact.c, utilisé par le solveur */
+static void* creerCompact(const ConfigJeu* config) {
+    (void)config;
+    return malloc(sizeof(EtatCompact));
+}
+
+static void chargerCompact(void* m, const EtatCompact* depart) {
+    *(EtatCompact*)m = *depart;
+}
+
+static int executerCompact(void* m, const char* seq) {
+    return executerSequenceCompacte((EtatCompact*)m, seq);
+}
+
+static void lireCompact(void* m, EtatCompact* fin) {
+    *fin = *(EtatCompact*)m;
+}
+
+static void detruireCompact(void* m) {
+    free(m);
+}
+
+/* Cache des effets des juges, volontairement petit pour que les effets soient souvent évincés */
+#define CAPACITE_EFFETS_FUZZ 64
+
+typedef struct {
+    CacheEffets cache;
+    EtatCompact etat;
+} MoteurEffets;
+
+static void* creerEffets(const ConfigJeu* config) {
+    (void)config;
+    MoteurEffets* m = (MoteurEffets*)malloc(sizeof(MoteurEffets));
+    if (m == NULL) return NULL;
+    initCacheEffets(&m->cache, CAPACITE_EFFETS_FUZZ);
+    return m;
+}
+
+static void chargerEffets(void* m, const EtatCompact* depart) {
+    ((MoteurEffets*)m)->etat = *depart;
+}
+
+/**
+ * @brief Applique un effet réussi à l'état du moteur
+ */
+static void appliquerEffet(MoteurEffets* m, const EffetSequence* e) {
+    EtatCompact avant = m->etat;
+    for (int i = 0; i < avant.nb; i++) m->etat.animaux[i] = avant.animaux[e->origine[i]];
+    m->etat.hauteur = e->hauteur;
+}
+
+static int executerEffets(void* m, const char* seq) {
+    MoteurEffets* me = (MoteurEffets*)m;
+    EffetSequence e;
+    int res = effetSequence(&me->cache, me->etat.hauteur, me->etat.nb, NULL, seq, &e);
+    if (res == 1) {
+        appliquerEffet(me, &e);
+        return 1;
+    }
+
+    /* Les ordres exécutés avant l'arrêt forment une séquence réussie : son effet donne l'état final de la référence */
+    char prefixe[2 * LONGUEUR_MAX + 2];
+    memcpy(prefixe, seq, 2 * (size_t)e.nbExecutes);
+    prefixe[2 * e.nbExecutes] = '\0';
+    EffetSequence p;
+    if (effetSequence(&me->cache, me->etat.hauteur, me->etat.nb, NULL, prefixe, &p) == 1) appliquerEffet(me, &p);
+    return res;
+}
+
+static void lireEffets(void* m, EtatCompact* fin) {
+    *fin = ((MoteurEffets*)m)->etat;
+}
+
+static void detruireEffets(void* m) {
+    libererCacheEffets(&((MoteurEffets*)m)->cache);
+    free(m);
+}
+
+/* Le premier moteur est la référence */
+static const Moteur moteurs[] = {
+    { "piles", creerPiles, chargerPiles, executerPiles, lirePiles, detruirePiles },
+    { "compact", creerCompact, chargerCompact, executerCompact, lireCompact, detruireCompact },
+    { "effets", creerEffets, chargerEffets, executerEffets, lireEffets, detruireEffets },
+};
+#define NB_MOTEURS ((int)(sizeof(moteurs) / sizeof(moteurs[0])))
+
+
+static char* nomsFuzz[MAX_ANIMAUX] = {
+    "LION", "OURS", "ELEPHANT", "TIGRE", "ZEBRE", "GIRAFE", "SINGE", "PHOQUE", "CHAMEAU", "LAMA"
+};
+
+/* Lettres des ordres inconnus : proches des vraies pour tomber sur des préfixes valides */
+static const char lettresFausses[] = "KILOSNMAkilosnmaXZ ";
+
+
+/**
+ * @brief Tire un cas : de 0 à MAX_ANIMAUX animaux, coupure quelconque (podiums vides compris),
+ *        séquence surtout faite d'ordres valides avec quelques ordres inconnus et parfois une
+ *        lettre de trop
+ * @param[in,out] alea Le générateur du fil
+ * @param[out] c Le cas
+ */
+static void tirerCas(Alea* alea, Cas* c) {
+    int n = (int)tirerBorne(alea, MAX_ANIMAUX + 1);
+    c->depart.nb = (uint8_t)n;
+    c->depart.hauteur = (uint8_t)tirerBorne(alea, (uint32_t)n + 1);
+    for (int i = 0; i < n; i++) c->depart.animaux[i] = (uint8_t)i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)tirerBorne(alea, (uint32_t)i + 1);
+        uint8_t t = c->depart.animaux[i];
+        c->depart.animaux[i] = c->depart.animaux[j];
+        c->depart.animaux[j] = t;
+    }
+
+    int nbOrdres = (int)tirerBorne(alea, LONGUEUR_MAX + 1);
+    int k = 0;
+    for (int i = 0; i < nbOrdres; i++) {
+        if (tirerBorne(alea, 16) != 0) {
+            const char* ordre = NOMS_ORDRES[tirerBorne(alea, NB_ORDRES_CONNUS)];
+            c->sequence[k++] = ordre[0];
+            c->sequence[k++] = ordre[1];
+        }
+        else {
+            c->sequence[k++] = lettresFausses[tirerBorne(alea, sizeof(lettresFausses) - 1)];
+            c->sequence[k++] = lettresFausses[tirerBorne(alea, sizeof(lettresFausses) - 1)];
+        }
+    }
+    if (tirerBorne(alea, 16) == 0) c->sequence[k++] = lettresFausses[tirerBorne(alea, sizeof(lettresFausses) - 1)];
+    c->sequence[k] = '\0';
+}
+
+/**
+ * @brief Joue un cas sur un moteur
+ * @param[in] m Le moteur
+ * @param[in,out] instance Son instance
+ * @param[in] c Le cas
+ * @param[out] r Le résultat
+ */
+static void jouerCas(const Moteur* m, void* instance, const Cas* c, Resultat* r) {
+    m->charger(instance, &c->depart);
+    r->verdict = m->executer(instance, c->sequence);
+    m->lire(instance, &r->fin);
+}
+
+/**
+ * @brief Indique si un moteur diverge de la référence sur un cas
+ * @return int 1 en cas de divergence
+ */
+static int diverge(const Moteur* m, void* instance, void* reference, const Cas* c) {
+    Resultat attendu, obtenu;
+    jouerCas(&moteurs[0], reference, c, &attendu);
+    jouerCas(m, instance, c, &obtenu);
+    return attendu.verdict != obtenu.verdict || !estMemeEtatCompact(&attendu.fin, &obtenu.fin);
+}
+
+/**
+ * @brief Retire un animal de l'état de départ en renumérotant les autres
+ * @param[in,out] c Le cas
+ * @param[in] position Case de l'animal retiré
+ */
+static void retirerAnimal(Cas* c, int position) {
+    uint8_t retire = c->depart.animaux[position];
+    for (int i = position; i + 1 < c->depart.nb; i++) c->depart.animaux[i] = c->depart.animaux[i + 1];
+    c->depart.nb--;
+    if (position < c->depart.hauteur) c->depart.hauteur--;
+    for (int i = 0; i < c->depart.nb; i++) {
+        if (c->depart.animaux[i] > retire) c->depart.animaux[i]--;
+    }
+}
+
+/**
+ * @brief Réduit un cas divergent tant qu'il diverge encore : retrait d'ordres, de lettres isolées,
+ *        d'animaux, puis abaissement de la coupure, jusqu'à ce qu'aucune réduction ne soit possible
+ * @param[in,out] c Le cas
+ */
+static void reduireCas(const Moteur* m, void* instance, void* reference, Cas* c) {
+    int progres = 1;
+    while (progres) {
+        progres = 0;
+
+        for (size_t largeur = 2; largeur >= 1; largeur--) {
+            for (size_t i = 0; i + largeur <= strlen(c->sequence); ) {
+                Cas essai = *c;
+                memmove(essai.sequence + i, essai.sequence + i + largeur, strlen(essai.sequence + i + largeur) + 1);
+                if (diverge(m, instance, reference, &essai)) {
+                    *c = essai;
+                    progres = 1;
+                }
+                else {
+                    i++;
+                }
+            }
+        }
+
+        for (int p = 0; p < c->depart.nb; ) {
+            Cas essai = *c;
+            retirerAnimal(&essai, p);
+            if (diverge(m, instance, reference, &essai)) {
+                *c = essai;
+                progres = 1;
+            }
+            else {
+                p++;
+            }
+        }
+
+        while (c->depart.hauteur > 0) {
+            Cas essai = *c;
+            essai.depart.hauteur--;
+            if (!diverge(m, instance, reference, &essai)) break;
+            *c = essai;
+            progres = 1;
+        }
+    }
+}
+
+/**
+ * @brief Écrit un état compact : podium bleu du bas vers le haut, puis rouge du haut vers le bas
+ */
+static void ecrireEtatCompact(FILE* f, const EtatCompact* e) {
+    fprintf(f, "bleu [");
+    for (int i = 0; i < e->hauteur; i++) fprintf(f, " %s", nomsFuzz[e->animaux[i]]);
+    fprintf(f, " ] rouge [");
+    for (int i = e->hauteur; i < e->nb; i++) fprintf(f, " %s", nomsFuzz[e->animaux[i]]);
+    fprintf(f, " ]");
+}
+
+
+/**
+ * @brief Tire une séquence longue d'ordres possibles depuis un départ : un ordre impossible
+ *        n'est gardé que si aucun ne l'est
+ * @param[in,out] alea Le générateur
+ * @param[in] depart L'état de départ
+ * @param[out] sequence Les 2 * ORDRES_LONGS lettres
+ */
+static void tirerSequenceLongue(Alea* alea, const EtatCompact* depart, char* sequence) {
+    EtatCompact e = *depart;
+    for (int i = 0; i < ORDRES_LONGS; i++) {
+        int ordre = (int)tirerBorne(alea, NB_ORDRES_CONNUS);
+        for (int essai = 0; essai < NB_ORDRES_CONNUS; essai++) {
+            EtatCompact essaye = e;
+            if (appliquerOrdre(&essaye, (ordre + essai) % NB_ORDRES_CONNUS)) {
+                ordre = (ordre + essai) % NB_ORDRES_CONNUS;
+                e = essaye;
+                break;
+            }
+        }
+        sequence[2 * i] = NOMS_ORDRES[ordre][0];
+        sequence[2 * i + 1] = NOMS_ORDRES[ordre][1];
+    }
+    sequence[2 * ORDRES_LONGS] = '\0';
+}
+
+/**
+ * @brief Juge des séquences de 2 * ORDRES_LONGS lettres par jugerParEffet, avec le cache, et
+ *        compare à la référence : même verdict, objectif atteint, et objectif que donneraient
+ *        les seuls EFFETS_ORDRES_MAX premiers ordres refusé s'il est différent. Une variante
+ *        porte un ordre inconnu au-delà de la clé
+ * @param[in] config La configuration
+ * @param[in] graine La graine
+ * @return int Nombre de séquences mal jugées
+ */
+static int verifierSequencesLongues(const ConfigJeu* config, uint64_t graine) {
+    Alea alea;
+    initAlea(&alea, graine);
+    CacheEffets cache;
+    initCacheEffets(&cache, CAPACITE_EFFETS_FUZZ);
+
+    int nbErreurs = 0;
+    char sequence[2 * ORDRES_LONGS + 1];
+    char prefixe[2 * EFFETS_ORDRES_MAX + 1];
+    for (int k = 0; k < 2 * NB_CAS_LONGS; k++) {
+        Cas c;
+        tirerCas(&alea, &c);
+        tirerSequenceLongue(&alea, &c.depart, sequence);
+        if (k % 2 == 1) {
+            int i = EFFETS_ORDRES_MAX + (int)tirerBorne(&alea, ORDRES_LONGS - EFFETS_ORDRES_MAX);
+            sequence[2 * i] = 'X';
+            sequence[2 * i + 1] = 'Z';
+        }
+        memcpy(prefixe, sequence, sizeof(prefixe) - 1);
+        prefixe[sizeof(prefixe) - 1] = '\0';
+
+        EtatJeu depart, arrivee, arriveePrefixe;
+        initEtat(&depart);
+        initEtat(&arrivee);
+        initEtat(&arriveePrefixe);
+        developperEtat(config, &c.depart, &depart);
+        developperEtat(config, &c.depart, &arrivee);
+        developperEtat(config, &c.depart, &arriveePrefixe);
+        int attendu = executerSequenceConfig(&arrivee, sequence, config);
+        executerSequenceConfig(&arriveePrefixe, prefixe, config);
+
+        int bonneSolution, faux = 0;
+        faux |= jugerParEffet(&cache, &depart, &arrivee, config, sequence, &bonneSolution) != attendu;
+        faux |= attendu == 1 && !bonneSolution;
+        if (attendu == 1 && !estMemeEtat(&arrivee, &arriveePrefixe)) {
+            jugerParEffet(&cache, &depart, &arriveePrefixe, config, sequence, &bonneSolution);
+            faux |= bonneSolution;
+        }
+        if (faux && nbErreurs == 0) {
+            printf("Sequence longue mal jugee (verdict attendu %d) :\n  depart : ", attendu);
+            ecrireEtatCompact(stdout, &c.depart);
+            printf("\n  sequence : \"%s\"\n", sequence);
+        }
+        nbErreurs += faux;
+
+        libererEtat(&depart);
+        libererEtat(&arrivee);
+        libererEtat(&arriveePrefixe);
+    }
+
+    libererCacheEffets(&cache);
+    return nbErreurs;
+}
+
+
+/**
+ * @struct TableMacros
+ * @brief Configuration tirée au hasard avec ses macros, et la place de leurs noms et de leurs suites
+ */
+typedef struct {
+    ConfigJeu config;
+    char noms[MAX_MACROS][3];
+    char suites[MAX_MACROS][2 * ORDRES_PAR_MACRO + 1];
+    int developpees[MAX_MACROS];     /* Ordres de base de chaque macro développée */
+} TableMacros;
+
+static char* ordresFuzz[NB_ORDRES_CONNUS] = { "KI", "LO", "SO", "NI", "MA" };
+
+/**
+ * @brief Tire une table de macros comme validerConfiguration les accepte : noms libres de deux
+ *        majuscules, suites d'ordres de base et de macros définies avant, puis la compile
+ * @param[in,out] alea Le générateur
+ * @param[out] t La table
+ */
+static void tirerTableMacros(Alea* alea, TableMacros* t) {
+    ConfigJeu* config = &t->config;
+    config->nbAnimaux = 2 + (int)tirerBorne(alea, MAX_ANIMAUX - 1);
+    for (int i = 0; i < config->nbAnimaux; i++) config->nomsAnimaux[i] = nomsFuzz[i];
+    config->nbOrdres = NB_ORDRES_CONNUS;
+    for (int i = 0; i < NB_ORDRES_CONNUS; i++) config->ordres[i] = ordresFuzz[i];
+    config->nbMacros = 1 + (int)tirerBorne(alea, MAX_MACROS);
+
+    for (int m = 0; m < config->nbMacros; m++) {
+        /* Un nom ni ordre de base ni déjà pris */
+        int libre = 0;
+        while (!libre) {
+            t->noms[m][0] = (char)('A' + tirerBorne(alea, 26));
+            t->noms[m][1] = (char)('A' + tirerBorne(alea, 26));
+            t->noms[m][2] = '\0';
+            libre = 1;
+            for (int k = 0; k < NB_ORDRES_CONNUS; k++) libre &= strcmp(t->noms[m], NOMS_ORDRES[k]) != 0;
+            for (int k = 0; k < m; k++) libre &= strcmp(t->noms[m], t->noms[k]) != 0;
+        }
+
+        /* Une macro précédente sur trois, tant que le développement reste borné */
+        int nbElements = 1 + (int)tirerBorne(alea, ORDRES_PAR_MACRO);
+        t->developpees[m] = 0;
+        for (int i = 0; i < nbElements; i++) {
+            const char* element = NOMS_ORDRES[tirerBorne(alea, NB_ORDRES_CONNUS)];
+            int longueur = 1;
+            if (m > 0 && tirerBorne(alea, 3) == 0) {
+                int k = (int)tirerBorne(alea, (uint32_t)m);
+                if (t->developpees[m] + t->developpees[k] <= DEVELOPPEMENT_MAX) {
+                    element = t->noms[k];
+                    longueur = t->developpees[k];
+                }
+            }
+            t->suites[m][2 * i] = element[0];
+            t->suites[m][2 * i + 1] = element[1];
+            t->developpees[m] += longueur;
+        }
+        t->suites[m][2 * nbElements] = '\0';
+        config->macros[m].nom = t->noms[m];
+        config->macros[m].expansion = t->suites[m];
+    }
+
+    if (!validerConfiguration(config)) {
+        fprintf(stderr, "Erreur fatale : Table de macros tiree refusee.\n");
+        exit(EXIT_FAILURE);
+    }
+    compilerMacros(config);
+}
+
+/**
+ * @brief Tire une séquence de macros, d'ordres de base et de quelques ordres inconnus, avec
+ *        parfois une lettre de trop, depuis un départ qui a les animaux de la table
+ * @param[in,out] alea Le générateur
+ * @param[in] t La table
+ * @param[out] c Le cas
+ */
+static void tirerCasMacros(Alea* alea, const TableMacros* t, Cas* c) {
+    int n = t->config.nbAnimaux;
+    c->depart.nb = (uint8_t)n;
+    c->depart.hauteur = (uint8_t)tirerBorne(alea, (uint32_t)n + 1);
+    for (int i = 0; i < n; i++) c->depart.animaux[i] = (uint8_t)i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)tirerBorne(alea, (uint32_t)i + 1);
+        uint8_t x = c->depart.animaux[i];
+        c->depart.animaux[i] = c->depart.animaux[j];
+        c->depart.animaux[j] = x;
+    }
+
+    int nbElements = (int)tirerBorne(alea, LONGUEUR_MAX + 1);
+    int k = 0;
+    for (int i = 0; i < nbElements; i++) {
+        uint32_t choix = tirerBorne(alea, 16);
+        if (choix == 0) {
+            c->sequence[k++] = lettresFausses[tirerBorne(alea, sizeof(lettresFausses) - 1)];
+            c->sequence[k++] = lettresFausses[tirerBorne(alea, sizeof(lettresFausses) - 1)];
+            continue;
+        }
+        const char* element = (choix < 8) ? NOMS_ORDRES[tirerBorne(alea, NB_ORDRES_CONNUS)]
+                                          : t->noms[tirerBorne(alea, (uint32_t)t->config.nbMacros)];
+        c->sequence[k++] = element[0];
+        c->sequence[k++] = element[1];
+    }
+    if (tirerBorne(alea, 16) == 0) c->sequence[k++] = lettresFausses[tirerBorne(alea, sizeof(lettresFausses) - 1)];
+    c->sequence[k] = '\0';
+}
+
+/**
+ * @brief Remplace chaque macro d'une séquence par sa suite, récursivement, jusqu'aux seuls
+ *        ordres de base. Les ordres inconnus et une lettre de trop sont recopiés tels quels
+ * @param[in] config Configuration compilée
+ * @param[in] sequence La séquence
+ * @param[in,out] dest Reçoit le développement
+ * @param[in,out] k Position d'écriture dans dest
+ */
+static void developperMacros(const ConfigJeu* config, const char* sequence, char* dest, size_t* k) {
+    size_t len = strlen(sequence);
+    for (size_t i = 0; i < len; i += 2) {
+        int code = (i + 1 < len) ? codeCommande(sequence + i, config) : 0;
+        if (code > NB_ORDRES_CONNUS) {
+            developperMacros(config, config->macros[code - 1 - NB_ORDRES_CONNUS].expansion, dest, k);
+            continue;
+        }
+        dest[(*k)++] = sequence[i];
+        if (i + 1 < len) dest[(*k)++] = sequence[i + 1];
+    }
+    dest[*k] = '\0';
+}
+
+/**
+ * @brief Joue des séquences avec des tables de macros tirées au hasard. La référence exécute
+ *        sur les piles la séquence développée en ordres de base ; les piles (commandeMacro),
+ *        l'état compact (appliquerMacro) et le cache des effets, dont les clés portent les codes
+ *        des macros, jouent la séquence telle quelle et doivent rendre le même verdict, et le
+ *        même état quand la séquence réussit. Une macro qui échoue n'applique aucun de ses
+ *        ordres : en cas d'échec, seuls les états des piles et du compact sont comparés
+ * @param[in] graine La graine
+ * @return int Nombre de cas divergents
+ */
+static int verifierMacros(uint64_t graine) {
+    Alea alea;
+    initAlea(&alea, graine ^ 0x9E3779B97F4A7C15ULL);
+
+    int nbErreurs = 0;
+    char developpee[2 * LONGUEUR_MAX * DEVELOPPEMENT_MAX + 2];
+    for (int t = 0; t < NB_TABLES_MACROS; t++) {
+        TableMacros table;
+        tirerTableMacros(&alea, &table);
+        const ConfigJeu* config = &table.config;
+
+        /* Un cache par table : ses clés ne disent pas de quelle table viennent les codes */
+        CacheEffets cache;
+        initCacheEffets(&cache, CAPACITE_EFFETS_FUZZ);
+
+        for (int k = 0; k < CAS_PAR_TABLE; k++) {
+            Cas c;
+            tirerCasMacros(&alea, &table, &c);
+            size_t longueur = 0;
+            developperMacros(config, c.sequence, developpee, &longueur);
+
+            EtatJeu reference, piles;
+            initEtat(&reference);
+            initEtat(&piles);
+            developperEtat(config, &c.depart, &reference);
+            developperEtat(config, &c.depart, &piles);
+            int attendu = executerSequence(&reference, developpee);
+            int verdictPiles = executerSequenceConfig(&piles, c.sequence, config);
+
+            EtatCompact finReference, finPiles, compact = c.depart;
+            compacterEtat(config, &reference, &finReference);
+            compacterEtat(config, &piles, &finPiles);
+            int verdictCompact = executerSequenceCompacteConfig(&compact, c.sequence, config);
+
+            /* Deux fois : l'effet calculé puis l'effet trouvé dans le cache */
+            int faux = 0;
+            for (int fois = 0; fois < 2; fois++) {
+                EffetSequence e;
+                EtatCompact effet = c.depart;
+                int verdictEffet = effetSequence(&cache, c.depart.hauteur, c.depart.nb, config, c.sequence, &e);
+                if (verdictEffet == 1) {
+                    for (int i = 0; i < effet.nb; i++) effet.animaux[i] = c.depart.animaux[e.origine[i]];
+                    effet.hauteur = e.hauteur;
+                }
+                faux |= verdictEffet != attendu || (attendu == 1 && !estMemeEtatCompact(&effet, &finReference));
+            }
+
+            faux |= verdictPiles != attendu || verdictCompact != attendu || !estMemeEtatCompact(&finPiles, &compact);
+            faux |= attendu == 1 && !estMemeEtatCompact(&finPiles, &finReference);
+
+            if (faux && nbErreurs == 0) {
+                printf("Divergence avec macros (verdict attendu %d, piles %d, compact %d) :\n  macros :", attendu,
+                       verdictPiles, verdictCompact);
+                for (int m = 0; m < config->nbMacros; m++) printf(" %s=%s", config->macros[m].nom, config->macros[m].expansion);
+                printf("\n  depart : ");
+                ecrireEtatCompact(stdout, &c.depart);
+                printf("\n  sequence : \"%s\"\n  developpee : \"%s\"\n", c.sequence, developpee);
+            }
+            nbErreurs += faux;
+
+            libererEtat(&reference);
+            libererEtat(&piles);
+        }
+        libererCacheEffets(&cache);
+    }
+    return nbErreurs;
+}
+
+
+/**
+ * @struct Fuzzeur
+ * @brief État partagé par les fils
+ */
+typedef struct {
+    const ConfigJeu* config;
+    uint64_t graine;
+    unsigned long long finNs;        /* Instant d'arrêt, 0 pour ne jamais s'arrêter */
+    atomic_int arret;
+    atomic_llong nbCas;
+    mtx_t verrou;                    /* Protège la divergence retenue */
+    int aDivergence;
+    int moteurFautif;
+    Cas divergence;
+} Fuzzeur;
+
+typedef struct {
+    Fuzzeur* fuzzeur;
+    int indice;
+} Travailleur;
+
+/**
+ * @brief Boucle d'un fil : tire des cas et les joue sur tous les moteurs
+ * @param[in] arg Le Travailleur
+ * @return int 0
+ */
+static int boucleFuzz(void* arg) {
+    Travailleur* t = (Travailleur*)arg;
+    Fuzzeur* fz = t->fuzzeur;
+
+    Alea alea;
+    initAlea(&alea, fz->graine ^ (uint64_t)(t->indice + 1) * 0xD1B54A32D192ED03ULL);
+
+    void* instances[NB_MOTEURS];
+    for (int i = 0; i < NB_MOTEURS; i++) {
+        instances[i] = moteurs[i].creer(fz->config);
+        if (instances[i] == NULL) {
+            fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le moteur %s.\n", moteurs[i].nom);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    Cas c;
+    Resultat attendu, obtenu;
+    while (!atomic_load_explicit(&fz->arret, memory_order_relaxed)) {
+        for (int k = 0; k < CAS_PAR_LOT; k++) {
+            tirerCas(&alea, &c);
+            jouerCas(&moteurs[0], instances[0], &c, &attendu);
+
+            for (int i = 1; i < NB_MOTEURS; i++) {
+                jouerCas(&moteurs[i], instances[i], &c, &obtenu);
+                if (attendu.verdict == obtenu.verdict && estMemeEtatCompact(&attendu.fin, &obtenu.fin)) continue;
+
+                reduireCas(&moteurs[i], instances[i], instances[0], &c);
+                mtx_lock(&fz->verrou);
+                if (!fz->aDivergence) {
+                    fz->aDivergence = 1;
+                    fz->moteurFautif = i;
+                    fz->divergence = c;
+                }
+                mtx_unlock(&fz->verrou);
+                atomic_store(&fz->arret, 1);
+                break;
+            }
+        }
+        atomic_fetch_add_explicit(&fz->nbCas, CAS_PAR_LOT, memory_order_relaxed);
+        if (fz->finNs != 0 && horodatageNs() >= fz->finNs) atomic_store(&fz->arret, 1);
+    }
+
+    for (int i = 0; i < NB_MOTEURS; i++) moteurs[i].detruire(instances[i]);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    double secondes = (argc > 1) ? atof(argv[1]) : 10.0;
+    uint64_t graine = (argc > 2) ? (uint64_t)strtoull(argv[2], NULL, 10) : (uint64_t)horodatageNs();
+    int nbFils = (argc > 3) ? atoi(argv[3]) : nombreCoeurs();
+    if (secondes < 0 || nbFils < 1) {
+        fprintf(stderr, "Usage: %s [secondes (0 = sans fin)] [graine] [nbFils]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ConfigJeu config;
+    config.nbAnimaux = MAX_ANIMAUX;
+    config.nbOrdres = 0;
+    config.nbMacros = 0;
+    for (int i = 0; i < MAX_ANIMAUX; i++) config.nomsAnimaux[i] = nomsFuzz[i];
+
+    int longuesFausses = verifierSequencesLongues(&config, graine);
+    printf("%d sequences de %d caracteres, %d mal jugees\n", 2 * NB_CAS_LONGS, 2 * ORDRES_LONGS, longuesFausses);
+    if (longuesFausses > 0) return EXIT_FAILURE;
+
+    int macrosFausses = verifierMacros(graine);
+    printf("%d tables de macros, %d sequences, %d divergentes\n", NB_TABLES_MACROS, NB_TABLES_MACROS * CAS_PAR_TABLE,
+           macrosFausses);
+    if (macrosFausses > 0) return EXIT_FAILURE;
+
+    Fuzzeur fz;
+    fz.config = &config;
+    fz.graine = graine;
+    atomic_init(&fz.arret, 0);
+    atomic_init(&fz.nbCas, 0);
+    mtx_init(&fz.verrou, mtx_plain);
+    fz.aDivergence = 0;
+
+    fprintf(stderr, "Graine : %llu, %d fils, %d moteurs compares a %s\n", (unsigned long long)graine, nbFils,
+            NB_MOTEURS - 1, moteurs[0].nom);
+
+    unsigned long long debut = horodatageNs();
+    fz.finNs = (secondes > 0) ? debut + (unsigned long long)(secondes * 1e9) : 0;
+
+    thrd_t* fils = (thrd_t*)malloc(sizeof(thrd_t) * nbFils);
+    Travailleur* travailleurs = (Travailleur*)malloc(sizeof(Travailleur) * nbFils);
+    if (fils == NULL || travailleurs == NULL) return EXIT_FAILURE;
+    for (int i = 0; i < nbFils; i++) {
+        travailleurs[i].fuzzeur = &fz;
+        travailleurs[i].indice = i;
+        if (thrd_create(&fils[i], boucleFuzz, &travailleurs[i]) != thrd_success) return EXIT_FAILURE;
+    }
+    for (int i = 0; i < nbFils; i++) thrd_join(fils[i], NULL);
+
+    double duree = (horodatageNs() - debut) / 1e9;
+    long long nbCas = atomic_load(&fz.nbCas);
+    printf("%lld cas en %.1f s (%.0f cas/s)\n", nbCas, duree, duree > 0 ? nbCas / duree : 0.0);
+
+    int code = EXIT_SUCCESS;
+    if (fz.aDivergence) {
+        const Cas* c = &fz.divergence;
+        printf("Divergence de %s, cas reduit :\n  depart : ", moteurs[fz.moteurFautif].nom);
+        ecrireEtatCompact(stdout, &c->depart);
+        printf("\n  sequence : \"%s\"\n", c->sequence);
+
+        int temoins[2] = { 0, fz.moteurFautif };
+        for (int k = 0; k < 2; k++) {
+            const Moteur* m = &moteurs[temoins[k]];
+            void* instance = m->creer(&config);
+            Resultat r;
+            jouerCas(m, instance, c, &r);
+            printf("  %-8s : verdict %d, ", m->nom, r.verdict);
+            ecrireEtatCompact(stdout, &r.fin);
+            printf("\n");
+            m->detruire(instance);
+        }
+        code = EXIT_FAILURE;
+    }
+
+    free(travailleurs);
+    free(fils);
+    mtx_destroy(&fz.verrou);
+    return code;
+}
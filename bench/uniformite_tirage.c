@@ -0,0 +1,257 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../src/jeu.h"
+#include "../src/composantes.h"
+#include "../src/distances.h"
+#include "../src/solveur.h"
+#include "../src/soumission.h"
+
+
+/**
+ * @brief Vérifie que les tirages sont uniformes parmi les cartes libres d'un deck en partie
+ *        utilisé : des plages de cartes de longueurs variées sont réservées, de sorte qu'une
+ *        recherche qui avancerait jusqu'à la première carte libre favoriserait nettement celles
+ *        qui suivent une longue plage. Chaque tirage est compté puis le deck est remis dans son
+ *        état de départ ; l'écart aux effectifs attendus est mesuré par un khi-deux. Sont
+ *        vérifiés le tirage sur le deck entier, dans une composante, et par bande de difficulté
+ *        (une bande listée parmi les états proches, une parmi les états lointains et une bande
+ *        trouvée dans la table).
+ *        Le programme se termine en erreur si un khi-deux dépasse son seuil.
+ *        Usage : uniformite_tirage [nbAnimaux] [tiragesParCarte] [graine]
+ */
+
+static char* nomsBench[MAX_ANIMAUX] = {
+    "LION", "OURS", "ELEPHANT", "TIGRE", "ZEBRE", "GIRAFE", "SINGE", "PHOQUE", "CHAMEAU", "LAMA"
+};
+
+static char* ordresBench[] = { "KI", "LO", "SO", "NI", "MA" };
+
+/* Sans KI ni LO, le deck se découpe en nombreuses composantes */
+static char* ordresComposantes[] = { "SO", "NI", "MA" };
+
+
+/**
+ * @struct Tirage
+ * @brief Tirage vérifié : tirerCarteAtteignable, ou tirerCarteDifficulte si distances est donné
+ */
+typedef struct {
+    const char* nom;
+    const EtatJeu* depuis;
+    const Distances* distances;
+    const ConfigJeu* config;
+    int distance;                /* Bande réduite à cette seule distance */
+} Tirage;
+
+
+/**
+ * @brief Seuil du khi-deux à nbClasses - 1 degrés de liberté, à environ 4 écarts-types
+ *        (approximation de Wilson-Hilferty) : un tirage uniforme ne le dépasse presque jamais
+ */
+static double seuilKhiDeux(int nbClasses) {
+    double k = nbClasses > 1 ? nbClasses - 1 : 1;
+    double t = 1.0 - 2.0 / (9.0 * k) + 4.0 * sqrt(2.0 / (9.0 * k));
+    return k * t * t * t;
+}
+
+/**
+ * @brief Réserve des plages de cartes de longueurs tirées au hasard, une sur deux, les plages
+ *        libres étant dix fois plus courtes
+ * @param[in,out] deck Le deck, plein
+ * @param[in,out] alea Le générateur
+ * @param[in] plageMax Longueur maximale d'une plage réservée
+ */
+static void entamerDeck(Deck* deck, Alea* alea, int plageMax) {
+    int i = 0, reservee = 1;
+    while (i < deck->nbPositions) {
+        int longueur = 1 + (int)tirerBorne(alea, (uint32_t)(reservee ? plageMax : plageMax / 10 + 1));
+        for (int k = 0; k < longueur && i < deck->nbPositions; k++, i++) {
+            if (reservee) prendreCarte(deck, i);
+        }
+        reservee = !reservee;
+    }
+}
+
+/**
+ * @brief Tire de nombreuses cartes depuis le même état du deck et compare leurs effectifs à
+ *        ceux d'un tirage uniforme parmi les cartes possibles
+ * @param[in] t Le tirage
+ * @param[in,out] deck Le deck, dans l'état etat
+ * @param[in,out] alea Le générateur
+ * @param[in] etat Marqueurs du deck, remis après chaque tirage
+ * @param[in] possibles 1 pour chaque carte libre que le tirage peut donner
+ * @param[in] tiragesParCarte Effectif attendu de chaque carte possible
+ * @param[out] effectifs Effectif de chaque carte
+ * @return int 1 si le khi-deux reste sous son seuil
+ */
+static int verifier(const Tirage* t, Deck* deck, Alea* alea, const uint64_t* etat, const char* possibles,
+                    int tiragesParCarte, long* effectifs) {
+    int nbPossibles = 0;
+    for (int i = 0; i < deck->nbPositions; i++) {
+        effectifs[i] = 0;
+        nbPossibles += possibles[i];
+    }
+    long nbTirages = (long)nbPossibles * tiragesParCarte;
+
+    long horsPlage = 0;
+    for (long k = 0; k < nbTirages; k++) {
+        EtatJeu* carte = (t->distances == NULL)
+            ? tirerCarteAtteignable(deck, alea, t->depuis)
+            : tirerCarteDifficulte(t->distances, deck, alea, t->config, t->depuis, t->distance, t->distance);
+        int i = (carte == NULL) ? -1 : (int)(carte - deck->positions);
+        if (i < 0 || !possibles[i]) horsPlage++;
+        else effectifs[i]++;
+        restaurerDeck(deck, etat);
+    }
+
+    double attendu = (double)tiragesParCarte;
+    double khiDeux = 0;
+    for (int i = 0; i < deck->nbPositions; i++) {
+        if (!possibles[i]) continue;
+        double ecart = (double)effectifs[i] - attendu;
+        khiDeux += ecart * ecart / attendu;
+    }
+    double seuil = seuilKhiDeux(nbPossibles);
+    int juste = nbPossibles > 0 && horsPlage == 0 && khiDeux <= seuil;
+
+    printf("%-16s | %7d | %9ld | %10.1f | %10.1f | %s\n", t->nom, nbPossibles, nbTirages, khiDeux, seuil,
+           juste ? "ok" : (horsPlage ? "ERREUR (carte hors plage ou deja tiree)" : "ERREUR"));
+    return juste;
+}
+
+/**
+ * @brief Relève les marqueurs du deck
+ */
+static void releverEtat(const Deck* deck, uint64_t* etat) {
+    for (int m = 0; m < deck->nbMots; m++) etat[m] = atomic_load(&deck->estUtilisee[m]);
+}
+
+/**
+ * @brief Vérifie le tirage par bande depuis une carte du deck : une bande réduite à une distance
+ *        listée parmi les états proches, la plus peuplée des distances listées parmi les états
+ *        lointains, puis la plus peuplée entre les deux. Les cartes possibles sont les cartes
+ *        libres dont le solveur trouve la distance demandée
+ * @return int 1 si les trois khi-deux restent sous leur seuil
+ */
+static int verifierBandes(Deck* deck, Alea* alea, const ConfigJeu* config, const uint64_t* etat, char* possibles,
+                          int tiragesParCarte, long* effectifs) {
+    Distances distances;
+    calculerDistances(&distances, deck, config, nombreCoeurs());
+    Solveur solveur;
+    initSolveur(&solveur, config);
+
+    const EtatJeu* depuis = &deck->positions[0];
+    EtatCompact depart;
+    compacterEtat(config, depuis, &depart);
+    const Niveaux* niv = &distances.niveaux[depart.hauteur];
+
+    /* La bande la plus peuplée parmi les états proches, parmi les lointains, puis entre les deux */
+    int listee = 0, lointaine = -1, balayee = -1;
+    for (int k = 1; k <= niv->distanceMax; k++) {
+        if (k < niv->nbNiveauxProches) {
+            if (niv->nombre[k] > niv->nombre[listee]) listee = k;
+        }
+        else if (k >= niv->premierNiveauLointain) {
+            if (lointaine < 0 || niv->nombre[k] > niv->nombre[lointaine]) lointaine = k;
+        }
+        else if (balayee < 0 || niv->nombre[k] > niv->nombre[balayee]) balayee = k;
+    }
+
+    int* distance = (int*)malloc(sizeof(int) * deck->nbPositions);
+    if (distance == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < deck->nbPositions; i++) {
+        distance[i] = -1;
+        if ((etat[i / 64] >> (i % 64)) & 1) continue;
+        EtatCompact arrivee;
+        int coups[COUPS_MAX];
+        compacterEtat(config, &deck->positions[i], &arrivee);
+        distance[i] = resoudre(&solveur, &depart, &arrivee, coups);
+    }
+
+    int juste = 1;
+    int bandes[3] = { listee, lointaine, balayee };
+    const char* noms[3] = { "bande listee", "bande lointaine", "bande balayee" };
+    for (int b = 0; b < 3; b++) {
+        if (bandes[b] < 0) {
+            printf("%-16s | aucune distance de ce genre\n", noms[b]);
+            continue;
+        }
+        for (int i = 0; i < deck->nbPositions; i++) possibles[i] = (distance[i] == bandes[b]);
+        Tirage t = { noms[b], depuis, &distances, config, bandes[b] };
+        juste &= verifier(&t, deck, alea, etat, possibles, tiragesParCarte, effectifs);
+    }
+
+    free(distance);
+    libererSolveur(&solveur);
+    libererDistances(&distances);
+    return juste;
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 7;
+    int tiragesParCarte = (argc > 2) ? atoi(argv[2]) : 50;
+    uint64_t graine = (argc > 3) ? (uint64_t)strtoull(argv[3], NULL, 10) : 1;
+    if (n < 3 || n > 7 || tiragesParCarte < 10) {
+        fprintf(stderr, "Usage: %s [nbAnimaux 3..7] [tiragesParCarte >= 10] [graine]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ConfigJeu config;
+    config.nbAnimaux = n;
+    config.nbOrdres = 5;
+    config.nbMacros = 0;
+    for (int i = 0; i < n; i++) config.nomsAnimaux[i] = nomsBench[i];
+    for (int i = 0; i < 5; i++) config.ordres[i] = ordresBench[i];
+    config.noyau = choisirNoyau(n);
+
+    Deck deck;
+    genererToutesPositions(&config, &deck);
+    Alea alea;
+    initAlea(&alea, graine);
+    entamerDeck(&deck, &alea, 300);
+
+    uint64_t* etat = (uint64_t*)malloc(sizeof(uint64_t) * deck.nbMots);
+    long* effectifs = (long*)malloc(sizeof(long) * deck.nbPositions);
+    char* possibles = (char*)malloc((size_t)deck.nbPositions);
+    if (etat == NULL || effectifs == NULL || possibles == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante.\n");
+        return EXIT_FAILURE;
+    }
+    releverEtat(&deck, etat);
+
+    printf("%d animaux, %d cartes dont %d libres\n", n, deck.nbPositions, atomic_load(&deck.nbRestantes));
+    printf("tirage           | cartes  | tirages   | khi-deux   | seuil      |\n");
+    for (int i = 0; i < deck.nbPositions; i++) possibles[i] = !((etat[i / 64] >> (i % 64)) & 1);
+    Tirage entier = { "deck entier", NULL, NULL, &config, 0 };
+    int juste = verifier(&entier, &deck, &alea, etat, possibles, tiragesParCarte, effectifs);
+    juste &= verifierBandes(&deck, &alea, &config, etat, possibles, tiragesParCarte, effectifs);
+    libererDeck(&deck);
+
+    /* Tirage borné à la plus grande composante d'un deck qui en a beaucoup */
+    config.nbOrdres = 3;
+    for (int i = 0; i < 3; i++) config.ordres[i] = ordresComposantes[i];
+    genererToutesPositions(&config, &deck);
+    calculerComposantes(&deck, &config, nombreCoeurs());
+    entamerDeck(&deck, &alea, 6);
+    releverEtat(&deck, etat);
+
+    int k = 0;
+    for (int c = 1; c < deck.nbComposantes; c++) {
+        if (deck.debutComposantes[c + 1] - deck.debutComposantes[c] > deck.debutComposantes[k + 1] - deck.debutComposantes[k]) k = c;
+    }
+    for (int i = 0; i < deck.nbPositions; i++) {
+        possibles[i] = i >= deck.debutComposantes[k] && i < deck.debutComposantes[k + 1] && !((etat[i / 64] >> (i % 64)) & 1);
+    }
+    Tirage composante = { "composante", &deck.positions[deck.debutComposantes[k]], NULL, &config, 0 };
+    juste &= verifier(&composante, &deck, &alea, etat, possibles, tiragesParCarte, effectifs);
+
+    free(possibles);
+    free(effectifs);
+    free(etat);
+    libererDeck(&deck);
+    return juste ? EXIT_SUCCESS : EXIT_FAILURE;
+}
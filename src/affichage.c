@@ -0,0 +1,280 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "affichage.h"
+#include "sondes.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Agrandit le tampon pour pouvoir ajouter n octets
+ */
+static void reserverOctets(Rendu* r, size_t n) {
+    if (r->longueur + n <= r->capacite) return;
+
+    size_t capacite = (r->capacite > 0) ? r->capacite : 1024;
+    while (capacite < r->longueur + n) capacite *= 2;
+
+    char* nouv = (char*)reallouerMem(MEM_DIVERS, r->octets, capacite);
+    if (nouv == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour l'affichage.\n");
+        exit(EXIT_FAILURE);
+    }
+    r->octets = nouv;
+    r->capacite = capacite;
+}
+
+/**
+ * @brief Ajoute n octets au tampon
+ */
+static void ajouter(Rendu* r, const char* s, size_t n) {
+    reserverOctets(r, n);
+    memcpy(r->octets + r->longueur, s, n);
+    r->longueur += n;
+}
+
+/**
+ * @brief Ajoute n espaces au tampon
+ */
+static void ajouterEspaces(Rendu* r, size_t n) {
+    reserverOctets(r, n);
+    memset(r->octets + r->longueur, ' ', n);
+    r->longueur += n;
+}
+
+/**
+ * @brief Prépare le rendu
+ * @param[out] r Le rendu
+ * @param[in] config La configuration
+ * @param[in] avecCache 1 pour activer le cache des colonnes
+ */
+void initRendu(Rendu* r, const ConfigJeu* config, int avecCache) {
+    r->octets = NULL;
+    r->longueur = 0;
+    r->capacite = 0;
+    r->config = config;
+    r->avecCache = avecCache;
+    r->cache[0].etat = NULL;
+    r->cache[1].etat = NULL;
+
+    for (int i = 0; i < config->nbAnimaux; i++) {
+        size_t len = strlen(config->nomsAnimaux[i]);
+        size_t taille = (len < LARGEUR_COLONNE) ? LARGEUR_COLONNE : len;
+
+        r->cellules[i] = (char*)allouerMem(MEM_DIVERS, taille);
+        if (r->cellules[i] == NULL) {
+            fprintf(stderr, "Erreur fatale : Memoire insuffisante pour l'affichage.\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(r->cellules[i], config->nomsAnimaux[i], len);
+        memset(r->cellules[i] + len, ' ', taille - len);
+        r->tailleCellule[i] = taille;
+        r->tailleNom[i] = len;
+    }
+}
+
+/**
+ * @brief Libère le rendu
+ * @param[in,out] r Le rendu
+ */
+void libererRendu(Rendu* r) {
+    for (int i = 0; i < r->config->nbAnimaux; i++) {
+        libererMem(r->cellules[i]);
+        r->cellules[i] = NULL;
+    }
+    libererMem(r->octets);
+    r->octets = NULL;
+    r->longueur = 0;
+    r->capacite = 0;
+}
+
+/**
+ * @brief Retrouve l'indice d'un animal dans la configuration. Les états du deck pointent
+ *        directement sur les noms de la configuration, la comparaison de pointeurs suffit
+ *        presque toujours
+ */
+static int indiceAnimal(const Rendu* r, const char* nom) {
+    for (int i = 0; i < r->config->nbAnimaux; i++) {
+        if (r->config->nomsAnimaux[i] == nom) return i;
+    }
+    for (int i = 0; i < r->config->nbAnimaux; i++) {
+        if (strcmp(r->config->nomsAnimaux[i], nom) == 0) return i;
+    }
+    return 0;
+}
+
+/**
+ * @brief Décode une pile en indices d'animaux, du bas vers le haut
+ */
+static int decoderPile(const Rendu* r, const Pile* p, int* tab) {
+    int h = taillePile(p);
+    int k = h - 1;
+    for (Cellule* c = p->tete; c != NULL && k >= 0; c = c->suivant) {
+        tab[k--] = indiceAnimal(r, c->valeur);
+    }
+    return h;
+}
+
+/**
+ * @brief Renvoie les colonnes d'un état, en les reprenant du cache si possible
+ */
+static const Colonnes* colonnesDe(Rendu* r, const EtatJeu* e, int emplacement) {
+    if (r->avecCache) {
+        for (int i = 0; i < 2; i++) {
+            if (r->cache[i].etat == e) {
+                /* Le départ d'un tour est souvent l'arrivée du tour précédent */
+                if (i != emplacement) {
+                    Colonnes tmp = r->cache[emplacement];
+                    r->cache[emplacement] = r->cache[i];
+                    r->cache[i] = tmp;
+                }
+                return &r->cache[emplacement];
+            }
+        }
+    }
+
+    Colonnes* c = &r->cache[emplacement];
+    c->etat = e;
+    c->hBleu = decoderPile(r, &e->podiumBleu, c->bleu);
+    c->hRouge = decoderPile(r, &e->podiumRouge, c->rouge);
+    return c;
+}
+
+/**
+ * @brief Compose la trame du duel
+ * @param[in,out] r Le rendu
+ * @param[in] depart État actuel
+ * @param[in] arrivee État objectif
+ * @return size_t Longueur de la trame
+ */
+size_t composerDuel(Rendu* r, const EtatJeu* depart, const EtatJeu* arrivee) {
+    const Colonnes* g = colonnesDe(r, depart, 0);
+    const Colonnes* d = colonnesDe(r, arrivee, 1);
+
+    int maxH = g->hBleu;
+    if (g->hRouge > maxH) maxH = g->hRouge;
+    if (d->hBleu > maxH) maxH = d->hBleu;
+    if (d->hRouge > maxH) maxH = d->hRouge;
+
+    r->longueur = 0;
+
+    for (int k = maxH - 1; k >= 0; k--) {
+        if (k < g->hBleu) ajouter(r, r->cellules[g->bleu[k]], r->tailleCellule[g->bleu[k]]);
+        else              ajouterEspaces(r, LARGEUR_COLONNE);
+
+        if (k < g->hRouge) ajouter(r, r->cellules[g->rouge[k]], r->tailleCellule[g->rouge[k]]);
+        else               ajouterEspaces(r, LARGEUR_COLONNE);
+
+        ajouterEspaces(r, 10);
+
+        if (k < d->hBleu) ajouter(r, r->cellules[d->bleu[k]], r->tailleCellule[d->bleu[k]]);
+        else              ajouterEspaces(r, LARGEUR_COLONNE);
+
+        /* La dernière colonne n'est pas complétée d'espaces */
+        if (k < d->hRouge) ajouter(r, r->cellules[d->rouge[k]], r->tailleNom[d->rouge[k]]);
+
+        ajouter(r, "\n", 1);
+    }
+
+    static const char socles[] =
+        "----        ----           ==>    ----        ----        \n"
+        "BLEU        ROUGE                 BLEU        ROUGE       \n"
+        "\n";
+    ajouter(r, socles, sizeof(socles) - 1);
+    return r->longueur;
+}
+
+/**
+ * @brief Compose la liste des ordres
+ * @param[in,out] r Le rendu
+ * @return size_t Longueur de la trame
+ */
+size_t composerOrdres(Rendu* r) {
+    const ConfigJeu* config = r->config;
+    r->longueur = 0;
+
+    for (int i = 0; i < config->nbOrdres; i++) {
+        const char* o = config->ordres[i];
+        ajouter(r, o, strlen(o));
+        ajouter(r, " ", 1);
+
+        const char* effet = "";
+        if (strcmp(o, "KI") == 0)      effet = "(B -> R)";
+        else if (strcmp(o, "LO") == 0) effet = "(B <- R)";
+        else if (strcmp(o, "SO") == 0) effet = "(B <-> R)";
+        else if (strcmp(o, "NI") == 0) effet = "(B ^)";
+        else if (strcmp(o, "MA") == 0) effet = "(R ^)";
+        ajouter(r, effet, strlen(effet));
+
+        if (i < config->nbOrdres - 1) ajouter(r, " | ", 3);
+    }
+    for (int i = 0; i < config->nbMacros; i++) {
+        const Macro* m = &config->macros[i];
+        ajouter(r, " | ", 3);
+        ajouter(r, m->nom, strlen(m->nom));
+        ajouter(r, " (", 2);
+        ajouter(r, m->expansion, strlen(m->expansion));
+        ajouter(r, ")", 1);
+    }
+    ajouter(r, "\n\n", 2);
+    return r->longueur;
+}
+
+/**
+ * @brief Écrit le tampon sur la sortie standard. Ce qui attend encore dans le tampon de stdio
+ *        est vidé d'abord pour garder l'ordre des messages
+ */
+static void ecrireTampon(const Rendu* r) {
+    fflush(stdout);
+
+    size_t ecrits = 0;
+    while (ecrits < r->longueur) {
+#ifdef _WIN32
+        int n = _write(1, r->octets + ecrits, (unsigned int)(r->longueur - ecrits));
+#else
+        ssize_t n = write(STDOUT_FILENO, r->octets + ecrits, r->longueur - ecrits);
+#endif
+        if (n <= 0) return;
+        ecrits += (size_t)n;
+    }
+}
+
+/**
+ * @brief Compose et écrit le duel
+ * @param[in,out] r Le rendu
+ * @param[in] depart État actuel
+ * @param[in] arrivee État objectif
+ */
+void ecrireDuel(Rendu* r, const EtatJeu* depart, const EtatJeu* arrivee) {
+    unsigned long long debut = debutSonde();
+    composerDuel(r, depart, arrivee);
+    ecrireTampon(r);
+    finSonde(SONDE_RENDU, debut);
+}
+
+/**
+ * @brief Écrit la trame déjà composée
+ * @param[in] r Le rendu
+ */
+void ecrireTrame(const Rendu* r) {
+    unsigned long long debut = debutSonde();
+    ecrireTampon(r);
+    finSonde(SONDE_RENDU, debut);
+}
+
+/**
+ * @brief Compose et écrit la liste des ordres
+ * @param[in,out] r Le rendu
+ */
+void ecrireOrdres(Rendu* r) {
+    unsigned long long debut = debutSonde();
+    composerOrdres(r);
+    ecrireTampon(r);
+    finSonde(SONDE_RENDU, debut);
+}
\ No newline at end of file
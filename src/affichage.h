@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stddef.h>
+#include "jeu.h"
+
+/**
+ * @def LARGEUR_COLONNE
+ * @brief Largeur d'une colonne de podium dans l'affichage du duel
+ */
+#define LARGEUR_COLONNE 12
+
+/**
+ * @struct Colonnes
+ * @brief Contenu décodé des deux podiums d'un état, du bas vers le haut
+ */
+typedef struct {
+    const EtatJeu* etat;       /* État décodé, NULL si l'entrée est vide */
+    int hBleu;
+    int hRouge;
+    int bleu[MAX_ANIMAUX];     /* Indices des animaux dans la configuration */
+    int rouge[MAX_ANIMAUX];
+} Colonnes;
+
+/**
+ * @struct Rendu
+ * @brief Tampon réutilisable dans lequel une trame complète est composée avant d'être
+ *        écrite en une seule fois. Les cellules de noms sont préparées au chargement
+ */
+typedef struct {
+    char* octets;                      /* Trame en cours */
+    size_t longueur;
+    size_t capacite;
+    const ConfigJeu* config;
+    char* cellules[MAX_ANIMAUX];       /* Nom complété d'espaces jusqu'à LARGEUR_COLONNE */
+    size_t tailleCellule[MAX_ANIMAUX];
+    size_t tailleNom[MAX_ANIMAUX];
+    int avecCache;                     /* 1 pour garder les colonnes des derniers états affichés */
+    Colonnes cache[2];                 /* Départ et arrivée du dernier duel */
+} Rendu;
+
+
+
+/**
+ * @brief Prépare un rendu pour une configuration
+ * @param[out] r Pointeur vers le rendu à initialiser
+ * @param[in] config Configuration dont les noms d'animaux seront affichés
+ * @param[in] avecCache 1 pour ne décoder qu'une fois les podiums de l'état courant
+ */
+void initRendu(Rendu* r, const ConfigJeu* config, int avecCache);
+
+/**
+ * @brief Libère le tampon et les cellules du rendu
+ * @param[in,out] r Pointeur vers le rendu
+ */
+void libererRendu(Rendu* r);
+
+/**
+ * @brief Compose dans le tampon la trame du duel, identique à afficherDuel
+ * @param[in,out] r Pointeur vers le rendu
+ * @param[in] depart État actuel du jeu
+ * @param[in] arrivee État objectif
+ * @return size_t Longueur de la trame
+ */
+size_t composerDuel(Rendu* r, const EtatJeu* depart, const EtatJeu* arrivee);
+
+/**
+ * @brief Compose dans le tampon la liste des ordres, identique à afficherOrdresPossibles
+ * @param[in,out] r Pointeur vers le rendu
+ * @return size_t Longueur de la trame
+ */
+size_t composerOrdres(Rendu* r);
+
+/**
+ * @brief Compose puis écrit la trame du duel sur la sortie standard en un seul appel système
+ * @param[in,out] r Pointeur vers le rendu
+ * @param[in] depart État actuel du jeu
+ * @param[in] arrivee État objectif
+ */
+void ecrireDuel(Rendu* r, const EtatJeu* depart, const EtatJeu* arrivee);
+
+/**
+ * @brief Écrit telle quelle la trame composée dans le tampon, par exemple d'avance sur un autre fil
+ * @param[in] r Pointeur vers le rendu
+ */
+void ecrireTrame(const Rendu* r);
+
+/**
+ * @brief Compose puis écrit la liste des ordres sur la sortie standard
+ * @param[in,out] r Pointeur vers le rendu
+ */
+void ecrireOrdres(Rendu* r);
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "alea.h"
+
+
+/**
+ * @brief Pas de splitmix64, sert uniquement à étaler la graine sur les 256 bits d'état
+ */
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Rotation à gauche sur 64 bits
+ */
+static uint64_t rotation(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Amorce le générateur
+ * @param[out] a Le générateur
+ * @param[in] graine La graine
+ */
+void initAlea(Alea* a, uint64_t graine) {
+    /* splitmix64 ne donne jamais quatre zéros de suite : l'état est toujours valide */
+    for (int i = 0; i < 4; i++) {
+        a->etat[i] = splitmix64(&graine);
+    }
+}
+
+/**
+ * @brief Tire un entier sur 64 bits
+ * @param[in,out] a Le générateur
+ * @return uint64_t L'entier
+ */
+uint64_t tirerAlea(Alea* a) {
+    uint64_t* s = a->etat;
+    uint64_t resultat = rotation(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotation(s[3], 45);
+
+    return resultat;
+}
+
+/**
+ * @brief Tire un entier dans [0, n) par multiplication (méthode de Lemire) : le produit de 32 bits
+ *        aléatoires par n est rejeté seulement dans la petite zone qui créerait un biais
+ * @param[in,out] a Le générateur
+ * @param[in] n La borne
+ * @return uint32_t L'entier
+ */
+uint32_t tirerBorne(Alea* a, uint32_t n) {
+    uint64_t produit = (tirerAlea(a) >> 32) * (uint64_t)n;
+    uint32_t bas = (uint32_t)produit;
+
+    if (bas < n) {
+        uint32_t seuil = (0u - n) % n;
+        while (bas < seuil) {
+            produit = (tirerAlea(a) >> 32) * (uint64_t)n;
+            bas = (uint32_t)produit;
+        }
+    }
+    return (uint32_t)(produit >> 32);
+}
+
+/**
+ * @brief Tire un réel dans [0, 1)
+ * @param[in,out] a Le générateur
+ * @return double Le réel
+ */
+double tirerReel(Alea* a) {
+    return (double)(tirerAlea(a) >> 11) * (1.0 / 9007199254740992.0);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @struct Alea
+ * @brief Générateur pseudo-aléatoire propre à une partie (xoshiro256**). Contrairement à rand(),
+ *        chaque partie a le sien et peut donc tourner sur n'importe quel fil, et une même graine
+ *        redonne exactement la même suite
+ */
+typedef struct {
+    uint64_t etat[4];
+} Alea;
+
+
+
+/**
+ * @brief Amorce le générateur
+ * @param[out] a Pointeur vers le générateur
+ * @param[in] graine Graine de départ, deux graines différentes donnent deux suites différentes
+ */
+void initAlea(Alea* a, uint64_t graine);
+
+/**
+ * @brief Tire un entier sur 64 bits
+ * @param[in,out] a Pointeur vers le générateur
+ * @return uint64_t L'entier tiré
+ */
+uint64_t tirerAlea(Alea* a);
+
+/**
+ * @brief Tire un entier entre 0 et n - 1, sans biais quelle que soit la borne
+ * @param[in,out] a Pointeur vers le générateur
+ * @param[in] n Borne exclue, strictement positive
+ * @return uint32_t L'entier tiré
+ */
+uint32_t tirerBorne(Alea* a, uint32_t n);
+
+/**
+ * @brief Tire un réel dans [0, 1)
+ * @param[in,out] a Pointeur vers le générateur
+ * @return double Le réel tiré
+ */
+double tirerReel(Alea* a);
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "animal.h"
+#include "memoire.h"
 
 
  /**
@@ -14,12 +15,82 @@
 static char* monStrDup(const char* s) {
     if (s == NULL) return NULL;
     size_t len = strlen(s);
-    char* d = (char*)malloc(len + 1);
+    char* d = (char*)allouerMem(MEM_CONFIG, len + 1);
     if (d == NULL) return NULL;
     strcpy(d, s);
     return d;
 }
 
+/**
+ * @brief Dcoupe une ligne en mots et en ajoute une copie  un tableau de chanes
+ * @param[in,out] ligne La ligne  dcouper (modifie)
+ * @param[out] dest Tableau de destination
+ * @param[in,out] nb Nombre de chanes dj prsentes dans dest
+ * @param[in] max Taille de dest
+ */
+static void lireMots(char* ligne, char** dest, int* nb, int max) {
+    ligne[strcspn(ligne, "\n")] = '\0';
+    ligne[strcspn(ligne, "\r")] = '\0';
+
+    /* Dcoupage sur place sans strtok, qui garde sa position dans une variable globale */
+    char* mot = ligne + strspn(ligne, " ");
+    while (*mot != '\0' && *nb < max) {
+        size_t longueur = strcspn(mot, " ");
+        char suivant = mot[longueur];
+        mot[longueur] = '\0';
+        dest[*nb] = monStrDup(mot);
+        (*nb)++;
+        if (suivant == '\0') break;
+        mot += longueur + 1;
+        mot += strspn(mot, " ");
+    }
+}
+
+/**
+ * @brief Dcoupe la ligne des ordres : les mots de la forme NOM=SUITE sont des macros, les
+ *        autres des ordres de base
+ * @param[in,out] ligne La ligne  dcouper (modifie)
+ * @param[out] config La configuration dont les ordres et les macros sont remplis
+ */
+static void lireOrdres(char* ligne, ConfigJeu* config) {
+    char* mots[MAX_ORDRES + MAX_MACROS];
+    int nb = 0;
+    lireMots(ligne, mots, &nb, MAX_ORDRES + MAX_MACROS);
+
+    for (int i = 0; i < nb; i++) {
+        char* egal = (mots[i] != NULL) ? strchr(mots[i], '=') : NULL;
+        if (egal == NULL) {
+            if (config->nbOrdres < MAX_ORDRES) config->ordres[config->nbOrdres++] = mots[i];
+            else libererMem(mots[i]);
+        }
+        else if (config->nbMacros < MAX_MACROS) {
+            Macro* m = &config->macros[config->nbMacros++];
+            *egal = '\0';
+            m->nom = monStrDup(mots[i]);
+            m->expansion = monStrDup(egal + 1);
+            libererMem(mots[i]);
+        }
+        else libererMem(mots[i]);
+    }
+}
+
+/**
+ * @brief Remplit la configuration  partir de ses deux lignes de texte
+ * @param[out] config Pointeur vers la structure ConfigJeu  remplir
+ * @param[in,out] ligneAnimaux Ligne des animaux (modifie)
+ * @param[in,out] ligneOrdres Ligne des ordres (modifie), ou NULL
+ */
+void chargerConfigurationLignes(ConfigJeu* config, char* ligneAnimaux, char* ligneOrdres) {
+    config->nbAnimaux = 0;
+    config->nbOrdres = 0;
+    config->nbMacros = 0;
+
+    lireMots(ligneAnimaux, config->nomsAnimaux, &config->nbAnimaux, MAX_ANIMAUX);
+    if (ligneOrdres != NULL) {
+        lireOrdres(ligneOrdres, config);
+    }
+}
+
 /**
  * @brief Charge la configuration du jeu depuis un fichier
  * @param[out] config Pointeur vers la structure ConfigJeu  remplir
@@ -32,45 +103,22 @@ int chargerConfiguration(ConfigJeu* config, const char* nomFichier) {
         return 0;
     }
 
-    config->nbAnimaux = 0;
-    config->nbOrdres = 0;
-
-    char ligne[1024];
+    char ligneAnimaux[1024];
+    char ligneOrdres[1024];
 
     /* Lecture des animaux */
-    if (fgets(ligne, sizeof(ligne), fichier) != NULL) {
-        ligne[strcspn(ligne, "\n")] = '\0';
-        ligne[strcspn(ligne, "\r")] = '\0';
-
-        char* token = strtok(ligne, " ");
-        while (token != NULL && config->nbAnimaux < MAX_ANIMAUX) {
-
-            if (strlen(token) > 0) {
-                config->nomsAnimaux[config->nbAnimaux] = monStrDup(token);
-                config->nbAnimaux++;
-            }
-            token = strtok(NULL, " ");
-        }
-    }
-    else {
+    if (fgets(ligneAnimaux, sizeof(ligneAnimaux), fichier) == NULL) {
+        config->nbAnimaux = 0;
+        config->nbOrdres = 0;
+        config->nbMacros = 0;
         fclose(fichier);
         return 0;
     }
 
     /* Lecture des ordres */
-    if (fgets(ligne, sizeof(ligne), fichier) != NULL) {
-        ligne[strcspn(ligne, "\n")] = '\0';
-        ligne[strcspn(ligne, "\r")] = '\0';
-
-        char* token = strtok(ligne, " ");
-        while (token != NULL && config->nbOrdres < MAX_ORDRES) {
-            if (strlen(token) > 0) {
-                config->ordres[config->nbOrdres] = monStrDup(token);
-                config->nbOrdres++;
-            }
-            token = strtok(NULL, " ");
-        }
-    }
+    char* ordres = fgets(ligneOrdres, sizeof(ligneOrdres), fichier);
+
+    chargerConfigurationLignes(config, ligneAnimaux, ordres);
 
     fclose(fichier);
     return 1;
@@ -84,16 +132,24 @@ void libererConfiguration(ConfigJeu* config) {
     if (config == NULL) return;
 
     for (int i = 0; i < config->nbAnimaux; i++) {
-        free(config->nomsAnimaux[i]);
+        libererMem(config->nomsAnimaux[i]);
         config->nomsAnimaux[i] = NULL;
     }
     config->nbAnimaux = 0;
 
     for (int i = 0; i < config->nbOrdres; i++) {
-        free(config->ordres[i]);
+        libererMem(config->ordres[i]);
         config->ordres[i] = NULL;
     }
     config->nbOrdres = 0;
+
+    for (int i = 0; i < config->nbMacros; i++) {
+        libererMem(config->macros[i].nom);
+        libererMem(config->macros[i].expansion);
+        config->macros[i].nom = NULL;
+        config->macros[i].expansion = NULL;
+    }
+    config->nbMacros = 0;
 }
 
 /**
@@ -114,6 +170,45 @@ void afficherConfiguration(const ConfigJeu* config) {
         printf("%s ", config->ordres[i]);
     }
     printf("\n");
+
+    if (config->nbMacros > 0) {
+        printf("Macros chargees (%d)  : ", config->nbMacros);
+        for (int i = 0; i < config->nbMacros; i++) {
+            printf("%s=%s ", config->macros[i].nom, config->macros[i].expansion);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief Indique si un nom de macro est fait de deux lettres majuscules
+ * @param[in] nom Le nom
+ * @return int 1 si oui, 0 sinon
+ */
+static int estNomMacro(const char* nom) {
+    return strlen(nom) == 2 && nom[0] >= 'A' && nom[0] <= 'Z' && nom[1] >= 'A' && nom[1] <= 'Z';
+}
+
+/**
+ * @brief Cherche un nom dans un tableau de noms
+ * @return int L'indice du nom, ou -1 s'il est absent
+ */
+static int indiceNom(const char* nom, const char* const* noms, int nb) {
+    for (int i = 0; i < nb; i++) {
+        if (strcmp(nom, noms[i]) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Cherche une macro parmi les nb premires de la configuration
+ * @return int L'indice de la macro, ou -1 si elle est absente
+ */
+static int indiceMacro(const ConfigJeu* config, const char* nom, int nb) {
+    for (int i = 0; i < nb; i++) {
+        if (strcmp(nom, config->macros[i].nom) == 0) return i;
+    }
+    return -1;
 }
 
 /**
@@ -152,5 +247,31 @@ int validerConfiguration(const ConfigJeu* config) {
         }
     }
 
+    /* Une macro porte un nom libre de deux lettres et ne s'appuie que sur ce qui la prcde */
+    for (int i = 0; i < config->nbMacros; i++) {
+        const Macro* m = &config->macros[i];
+        if (!estNomMacro(m->nom)) {
+            printf("Erreur Config : La macro '%s' doit etre nommee par deux lettres majuscules.\n", m->nom);
+            return 0;
+        }
+        if (indiceNom(m->nom, ordresValides, nbValidesConnus) >= 0 || indiceMacro(config, m->nom, i) >= 0) {
+            printf("Erreur Config : Le nom de la macro '%s' est deja pris.\n", m->nom);
+            return 0;
+        }
+
+        size_t len = strlen(m->expansion);
+        if (len == 0 || len % 2 != 0) {
+            printf("Erreur Config : La macro '%s' doit etre une suite d'ordres de deux lettres.\n", m->nom);
+            return 0;
+        }
+        for (size_t k = 0; k < len; k += 2) {
+            char ordre[3] = { m->expansion[k], m->expansion[k + 1], '\0' };
+            if (indiceNom(ordre, ordresValides, nbValidesConnus) < 0 && indiceMacro(config, ordre, i) < 0) {
+                printf("Erreur Config : La macro '%s' utilise '%s', qui n'est ni un ordre de base ni une macro definie avant elle.\n", m->nom, ordre);
+                return 0;
+            }
+        }
+    }
+
     return 1;
 }
\ No newline at end of file
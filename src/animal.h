@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdint.h>
 #include "liste.h" 
 
 /**
@@ -14,6 +15,18 @@
   */
 #define MAX_ORDRES 10 
 
+  /**
+   * @def MAX_MACROS
+   * @brief Nombre maximum de macros configurables
+   */
+#define MAX_MACROS 10
+
+  /**
+   * @def CODES_ORDRES
+   * @brief Nombre de noms d'ordres possibles : deux lettres majuscules
+   */
+#define CODES_ORDRES (26 * 26)
+
   /**
    * @def TAILLE_NOM
    * @brief Taille max pour un nom d'animal
@@ -26,6 +39,24 @@
  */
 #define DEF_FICHIER_CONFIG "crazy.cfg"
 
+/**
+ * @struct Macro
+ * @brief Ordre compos dfini par la configuration (TO=KISO), compil au chargement en un seul
+ *        effet. Les ordres dplacent des cases sans regarder les animaux : pour chaque hauteur
+ *        de dpart du podium bleu, l'effet dit si la suite est possible, la hauteur d'arrive
+ *        et la case de dpart de chaque case d'arrive (cases de EtatCompact)
+ */
+typedef struct {
+    char* nom;                                     /* Deux lettres majuscules */
+    char* expansion;                               /* Ordres de base ou macros dfinies avant */
+    uint8_t possible[MAX_ANIMAUX + 1];             /* Indexs par la hauteur de dpart */
+    uint8_t hauteur[MAX_ANIMAUX + 1];
+    uint8_t origine[MAX_ANIMAUX + 1][MAX_ANIMAUX];
+} Macro;
+
+/* Dfini dans noyaux.h */
+struct Noyau;
+
 /**
  * @struct ConfigJeu
  * @brief Structure reprsentant la configuration complte du jeu
@@ -35,6 +66,10 @@ typedef struct {
     int nbAnimaux;                  /* Nombre reel d'animaux lus */
     char* ordres[MAX_ORDRES];       /* Tableau de chaines pour les ordres (KI, LO...) */
     int nbOrdres;                   /* Nombre reel d'ordres lus */
+    Macro macros[MAX_MACROS];       /* Macros lues sur la ligne des ordres */
+    int nbMacros;
+    uint8_t codes[CODES_ORDRES];    /* Rempli par compilerMacros : 0 si inconnu, 1 + code d'un ordre de base, sinon 1 + NB_ORDRES_CONNUS + indice de la macro */
+    const struct Noyau* noyau;      /* Choisi par choisirNoyau aprs validerConfiguration, repris par le solveur, les composantes et les distances */
 } ConfigJeu;
 
 
@@ -47,6 +82,14 @@ typedef struct {
  */
 int chargerConfiguration(ConfigJeu* config, const char* nomFichier);
 
+/**
+ * @brief Remplit la configuration  partir de la ligne des animaux et de celle des ordres
+ * @param[out] config Pointeur vers la structure ConfigJeu
+ * @param[in,out] ligneAnimaux Animaux spars par des espaces (la chane est modifie)
+ * @param[in,out] ligneOrdres Ordres et macros (NOM=SUITE) spars par des espaces (la chane est modifie), ou NULL
+ */
+void chargerConfigurationLignes(ConfigJeu* config, char* ligneAnimaux, char* ligneOrdres);
+
 
 /**
  * @brief Libre la mmoire alloue dynamiquement pour la configuration
@@ -63,7 +106,9 @@ void afficherConfiguration(const ConfigJeu* config);
 
 
 /** 
-* @brief Vrifie la validit des rgles du jeu charges. Au moins 2 animaux et 3 ordres 
+* @brief Vrifie la validit des rgles du jeu charges. Au moins 2 animaux et 3 ordres de base,
+*        macros nommes par deux lettres libres et dfinies par des ordres de base ou des macros
+*        qui les prcdent
 * @param[in] config Pointeur vers la structure ConfigJeu  vrifier
 * @return int Renvoie 1 si la configuration est valide, 0 sinon
 */
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include "anticipation.h"
+#include "etatcompact.h"
+
+
+/**
+ * @brief Prépare le tour suivant de la partie demandée
+ * @param[in,out] a L'anticipation
+ */
+static void preparer(Anticipation* a) {
+    ContexteJeu* ctx = a->ctx;
+    anticiperTour(ctx);
+
+    a->depart = ctx->suivantCourant;
+    a->arrivee = ctx->suivantObjectif;
+    a->longueurSolution = -2;
+    if (a->arrivee == NULL) return;
+
+    if (a->solveur != NULL) {
+        EtatCompact depart, arrivee;
+        compacterEtat(ctx->config, a->depart, &depart);
+        compacterEtat(ctx->config, a->arrivee, &arrivee);
+        a->longueurSolution = resoudre(a->solveur, &depart, &arrivee, a->solution);
+    }
+    if (a->avecRendu) composerDuel(&a->rendu, a->depart, a->arrivee);
+}
+
+/**
+ * @brief Boucle du fil : attend une demande, la traite, puis signale la fin
+ */
+static int boucleAnticipation(void* arg) {
+    Anticipation* a = (Anticipation*)arg;
+
+    mtx_lock(&a->verrou);
+    for (;;) {
+        while (!a->arret && !a->demande) {
+            cnd_wait(&a->travail, &a->verrou);
+        }
+        if (a->arret) break;
+        mtx_unlock(&a->verrou);
+
+        preparer(a);
+
+        mtx_lock(&a->verrou);
+        a->demande = 0;
+        cnd_signal(&a->termine);
+    }
+    mtx_unlock(&a->verrou);
+    return 0;
+}
+
+/**
+ * @brief Démarre le fil
+ * @param[out] a L'anticipation
+ * @param[in] config La configuration
+ */
+void initAnticipation(Anticipation* a, const ConfigJeu* config) {
+    mtx_init(&a->verrou, mtx_plain);
+    cnd_init(&a->travail);
+    cnd_init(&a->termine);
+    a->demande = 0;
+    a->arret = 0;
+    a->ctx = NULL;
+    a->solveur = NULL;
+    a->avecRendu = 0;
+    a->depart = NULL;
+    a->arrivee = NULL;
+    a->longueurSolution = -2;
+    initRendu(&a->rendu, config, 0);
+    a->actif = (thrd_create(&a->fil, boucleAnticipation, a) == thrd_success);
+}
+
+/**
+ * @brief Arrête le fil
+ * @param[in,out] a L'anticipation
+ */
+void detruireAnticipation(Anticipation* a) {
+    if (a->actif) {
+        mtx_lock(&a->verrou);
+        while (a->demande) cnd_wait(&a->termine, &a->verrou);
+        a->arret = 1;
+        cnd_signal(&a->travail);
+        mtx_unlock(&a->verrou);
+        thrd_join(a->fil, NULL);
+    }
+    libererRendu(&a->rendu);
+    cnd_destroy(&a->termine);
+    cnd_destroy(&a->travail);
+    mtx_destroy(&a->verrou);
+}
+
+/**
+ * @brief Lance la préparation du tour suivant
+ * @param[in,out] a L'anticipation
+ * @param[in,out] ctx La partie
+ * @param[in,out] solveur Le solveur ou NULL
+ * @param[in] avecRendu 1 pour composer la trame
+ */
+void lancerAnticipation(Anticipation* a, ContexteJeu* ctx, Solveur* solveur, int avecRendu) {
+    attendreAnticipation(a);
+
+    /* Sans fil, le tour suivant est tiré en fin de tour comme d'habitude */
+    a->depart = NULL;
+    a->arrivee = NULL;
+    if (!a->actif) return;
+
+    mtx_lock(&a->verrou);
+    a->ctx = ctx;
+    a->solveur = solveur;
+    a->avecRendu = avecRendu;
+    a->demande = 1;
+    cnd_signal(&a->travail);
+    mtx_unlock(&a->verrou);
+}
+
+/**
+ * @brief Attend la fin de la préparation
+ * @param[in,out] a L'anticipation
+ */
+void attendreAnticipation(Anticipation* a) {
+    if (!a->actif) return;
+    mtx_lock(&a->verrou);
+    while (a->demande) cnd_wait(&a->termine, &a->verrou);
+    mtx_unlock(&a->verrou);
+}
+
+/**
+ * @brief Indique si le travail prêt concerne ce duel
+ * @param[in] a L'anticipation
+ * @param[in] depart Départ
+ * @param[in] arrivee Objectif
+ * @return int 1 si oui
+ */
+int estAnticipe(const Anticipation* a, const EtatJeu* depart, const EtatJeu* arrivee) {
+    return a->arrivee != NULL && a->depart == depart && a->arrivee == arrivee;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <threads.h>
+#include "jeu.h"
+#include "affichage.h"
+#include "moteur.h"
+#include "solveur.h"
+
+/**
+ * @struct Anticipation
+ * @brief Fil qui prépare le tour suivant pendant que les joueurs réfléchissent : il tire ses
+ *        cartes depuis l'objectif en cours (qui sera le départ, quel que soit le vainqueur),
+ *        cherche leur plus courte solution et compose la trame du duel. La fin du tour n'a plus
+ *        qu'à prendre ce qui est prêt. Les tirages sont ceux qu'aurait faits la fin du tour
+ */
+typedef struct {
+    thrd_t fil;
+    int actif;                   /* 1 si le fil a démarré, sinon tout se fait en fin de tour */
+    mtx_t verrou;
+    cnd_t travail;
+    cnd_t termine;
+    int demande;                 /* 1 de lancerAnticipation jusqu'à la fin du travail */
+    int arret;
+    ContexteJeu* ctx;            /* Partie dont le tour suivant est préparé */
+    Solveur* solveur;            /* NULL pour ne pas chercher de solution */
+    int avecRendu;
+    Rendu rendu;                 /* Trame du duel suivant, composée sur le fil */
+    const EtatJeu* depart;       /* Cartes préparées, NULL si rien ne l'est */
+    const EtatJeu* arrivee;
+    int longueurSolution;        /* -2 si elle n'a pas été cherchée, -1 si l'objectif est inaccessible */
+    int solution[COUPS_MAX];
+} Anticipation;
+
+
+
+/**
+ * @brief Démarre le fil d'anticipation
+ * @param[out] a L'anticipation
+ * @param[in] config Configuration dont le rendu affiche les animaux
+ */
+void initAnticipation(Anticipation* a, const ConfigJeu* config);
+
+/**
+ * @brief Arrête le fil, après la fin du travail en cours
+ * @param[in,out] a L'anticipation
+ */
+void detruireAnticipation(Anticipation* a);
+
+/**
+ * @brief Prépare sur le fil le tour qui suivra le tour en cours de ctx. Jusqu'à
+ *        attendreAnticipation, le fil de la partie ne doit toucher ni au générateur, ni au deck,
+ *        ni au solveur, ni finir le tour
+ * @param[in,out] a L'anticipation
+ * @param[in,out] ctx La partie, dont le tour vient de commencer
+ * @param[in,out] solveur Solveur de la partie, NULL pour ne pas chercher la solution
+ * @param[in] avecRendu 1 pour composer la trame du duel
+ */
+void lancerAnticipation(Anticipation* a, ContexteJeu* ctx, Solveur* solveur, int avecRendu);
+
+/**
+ * @brief Attend la fin du travail lancé, sans effet s'il n'y en a pas
+ * @param[in,out] a L'anticipation
+ */
+void attendreAnticipation(Anticipation* a);
+
+/**
+ * @brief Indique si ce qui est prêt concerne bien ce duel
+ * @param[in] a L'anticipation, dont le travail est fini
+ * @param[in] depart Départ du tour qui commence
+ * @param[in] arrivee Objectif du tour qui commence
+ * @return int 1 si la solution et la trame préparées sont celles de ce duel
+ */
+int estAnticipe(const Anticipation* a, const EtatJeu* depart, const EtatJeu* arrivee);
@@ -0,0 +1,267 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include "classement.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Compare deux joueurs du registre avec l'ordre du classement final
+ */
+static int comparer(const Classement* c, int a, int b) {
+    return compareJoueurs(&c->registre->joueurs[a], &c->registre->joueurs[b]);
+}
+
+/**
+ * @brief Taille du sous-arbre, 0 pour un arbre vide
+ */
+static int tailleArbre(const Classement* c, int t) {
+    return (t < 0) ? 0 : c->taille[t];
+}
+
+/**
+ * @brief Recalcule la taille d'un noeud à partir de ses fils
+ */
+static void majTaille(Classement* c, int t) {
+    c->taille[t] = 1 + tailleArbre(c, c->gauche[t]) + tailleArbre(c, c->droite[t]);
+}
+
+/**
+ * @brief Fusionne deux arbres dont toutes les clés de a précèdent celles de b
+ */
+static int fusionner(Classement* c, int a, int b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+
+    if (c->priorite[a] > c->priorite[b]) {
+        c->droite[a] = fusionner(c, c->droite[a], b);
+        majTaille(c, a);
+        return a;
+    }
+    c->gauche[b] = fusionner(c, a, c->gauche[b]);
+    majTaille(c, b);
+    return b;
+}
+
+/**
+ * @brief Coupe l'arbre t en deux : les joueurs classés avant id et ceux classés après
+ */
+static void couper(Classement* c, int t, int id, int* avant, int* apres) {
+    if (t < 0) {
+        *avant = -1;
+        *apres = -1;
+        return;
+    }
+    if (comparer(c, t, id) < 0) {
+        couper(c, c->droite[t], id, &c->droite[t], apres);
+        *avant = t;
+    }
+    else {
+        couper(c, c->gauche[t], id, avant, &c->gauche[t]);
+        *apres = t;
+    }
+    majTaille(c, t);
+}
+
+/**
+ * @brief Insère un joueur dans l'arbre t et renvoie la nouvelle racine
+ */
+static int insererNoeud(Classement* c, int t, int id) {
+    if (t < 0) return id;
+
+    if (c->priorite[id] > c->priorite[t]) {
+        couper(c, t, id, &c->gauche[id], &c->droite[id]);
+        majTaille(c, id);
+        return id;
+    }
+
+    if (comparer(c, id, t) < 0) c->gauche[t] = insererNoeud(c, c->gauche[t], id);
+    else                        c->droite[t] = insererNoeud(c, c->droite[t], id);
+    majTaille(c, t);
+    return t;
+}
+
+/**
+ * @brief Retire un joueur de l'arbre t et renvoie la nouvelle racine
+ */
+static int retirerNoeud(Classement* c, int t, int id) {
+    if (t < 0) return -1;
+
+    if (t == id) {
+        return fusionner(c, c->gauche[t], c->droite[t]);
+    }
+    if (comparer(c, id, t) < 0) c->gauche[t] = retirerNoeud(c, c->gauche[t], id);
+    else                        c->droite[t] = retirerNoeud(c, c->droite[t], id);
+    majTaille(c, t);
+    return t;
+}
+
+/**
+ * @brief Agrandit les tableaux pour accueillir l'indice id
+ */
+static void reserver(Classement* c, int id) {
+    if (id < c->capacite) return;
+
+    int capacite = (c->capacite > 0) ? c->capacite : 16;
+    while (capacite <= id) capacite *= 2;
+
+    int* g = (int*)reallouerMem(MEM_JOUEURS, c->gauche, sizeof(int) * capacite);
+    int* d = (int*)reallouerMem(MEM_JOUEURS, c->droite, sizeof(int) * capacite);
+    int* t = (int*)reallouerMem(MEM_JOUEURS, c->taille, sizeof(int) * capacite);
+    unsigned int* p = (unsigned int*)reallouerMem(MEM_JOUEURS, c->priorite, sizeof(unsigned int) * capacite);
+    if (g == NULL || d == NULL || t == NULL || p == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le classement.\n");
+        exit(EXIT_FAILURE);
+    }
+    c->gauche = g;
+    c->droite = d;
+    c->taille = t;
+    c->priorite = p;
+    c->capacite = capacite;
+}
+
+/**
+ * @brief Initialise le classement
+ * @param[out] c Le classement
+ * @param[in] registre Les joueurs à classer
+ */
+void initClassement(Classement* c, Registre* registre) {
+    c->registre = registre;
+    c->gauche = NULL;
+    c->droite = NULL;
+    c->taille = NULL;
+    c->priorite = NULL;
+    c->capacite = 0;
+    c->racine = -1;
+
+    for (int id = 0; id < registre->nbJoueurs; id++) {
+        ajouterAuClassement(c, id);
+    }
+}
+
+/**
+ * @brief Libère le classement
+ * @param[in,out] c Le classement
+ */
+void libererClassement(Classement* c) {
+    libererMem(c->gauche);
+    libererMem(c->droite);
+    libererMem(c->taille);
+    libererMem(c->priorite);
+    c->gauche = NULL;
+    c->droite = NULL;
+    c->taille = NULL;
+    c->priorite = NULL;
+    c->capacite = 0;
+    c->racine = -1;
+}
+
+/**
+ * @brief Ajoute un joueur au classement
+ * @param[in,out] c Le classement
+ * @param[in] id L'indice du joueur
+ */
+void ajouterAuClassement(Classement* c, int id) {
+    reserver(c, id);
+
+    /* Priorité pseudo-aléatoire mais reproductible, tirée de l'indice */
+    unsigned int x = (unsigned int)id * 2654435761u + 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+
+    c->gauche[id] = -1;
+    c->droite[id] = -1;
+    c->taille[id] = 1;
+    c->priorite[id] = x;
+    c->racine = insererNoeud(c, c->racine, id);
+}
+
+/**
+ * @brief Donne un point à un joueur
+ * @param[in,out] c Le classement
+ * @param[in] id L'indice du joueur
+ */
+void marquerPoint(Classement* c, int id) {
+    fixerScore(c, id, c->registre->joueurs[id].score + 1);
+}
+
+/**
+ * @brief Remplace le score d'un joueur
+ * @param[in,out] c Le classement
+ * @param[in] id L'indice du joueur
+ * @param[in] score Le nouveau score
+ */
+void fixerScore(Classement* c, int id, int score) {
+    c->racine = retirerNoeud(c, c->racine, id);
+    c->registre->joueurs[id].score = score;
+    c->gauche[id] = -1;
+    c->droite[id] = -1;
+    c->taille[id] = 1;
+    c->racine = insererNoeud(c, c->racine, id);
+}
+
+/**
+ * @brief Rang d'un joueur
+ * @param[in] c Le classement
+ * @param[in] id L'indice du joueur
+ * @return int Son rang, à partir de 1
+ */
+int rangJoueur(const Classement* c, int id) {
+    int rang = 1;
+    int t = c->racine;
+
+    while (t >= 0 && t != id) {
+        if (comparer(c, id, t) < 0) {
+            t = c->gauche[t];
+        }
+        else {
+            rang += tailleArbre(c, c->gauche[t]) + 1;
+            t = c->droite[t];
+        }
+    }
+    if (t == id) rang += tailleArbre(c, c->gauche[t]);
+    return rang;
+}
+
+/**
+ * @brief Parcours infixe de t qui s'arrête dès que k joueurs ont été écrits
+ */
+static void parcourir(const Classement* c, int t, int k, int* ids, int* n) {
+    if (t < 0 || *n >= k) return;
+    parcourir(c, c->gauche[t], k, ids, n);
+    if (*n < k) ids[(*n)++] = t;
+    parcourir(c, c->droite[t], k, ids, n);
+}
+
+/**
+ * @brief Les K premiers joueurs
+ * @param[in] c Le classement
+ * @param[in] k Nombre de joueurs voulus
+ * @param[out] ids Les indices
+ * @return int Nombre d'indices écrits
+ */
+int meilleursJoueurs(const Classement* c, int k, int* ids) {
+    int n = 0;
+    parcourir(c, c->racine, k, ids, &n);
+    return n;
+}
+
+/**
+ * @brief Affiche les K premiers joueurs
+ * @param[in] c Le classement
+ * @param[in] k Nombre de joueurs
+ */
+void afficherClassement(const Classement* c, int k) {
+    int ids[TOP_CLASSEMENT];
+    if (k > TOP_CLASSEMENT) k = TOP_CLASSEMENT;
+
+    int n = meilleursJoueurs(c, k, ids);
+    printf("Classement :");
+    for (int i = 0; i < n; i++) {
+        const Joueur* j = &c->registre->joueurs[ids[i]];
+        printf(" %s %d", j->nom, j->score);
+        if (i < n - 1) printf(" |");
+    }
+    printf("\n\n");
+}
\ No newline at end of file
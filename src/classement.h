@@ -0,0 +1,86 @@
+#pragma once
+
+#include "joueurs.h"
+
+/**
+ * @def TOP_CLASSEMENT
+ * @brief Nombre de joueurs affichés dans le classement entre deux tours
+ */
+#define TOP_CLASSEMENT 5
+
+/**
+ * @struct Classement
+ * @brief Classement tenu à jour à chaque point marqué. C'est un arbre binaire de recherche
+ *        équilibré (treap) dont chaque noeud connaît la taille de son sous-arbre, ce qui donne
+ *        le rang d'un joueur et les K premiers en O(log P). L'ordre est celui de compareJoueurs
+ */
+typedef struct {
+    Registre* registre;  /* Registre dont les joueurs sont classés */
+    int* gauche;         /* Fils gauche de chaque joueur, -1 si aucun */
+    int* droite;         /* Fils droit de chaque joueur, -1 si aucun */
+    int* taille;         /* Taille du sous-arbre enraciné sur chaque joueur */
+    unsigned int* priorite;
+    int capacite;        /* Taille allouée des tableaux */
+    int racine;          /* -1 si le classement est vide */
+} Classement;
+
+
+
+/**
+ * @brief Initialise le classement et y place tous les joueurs déjà inscrits
+ * @param[out] c Pointeur vers le classement
+ * @param[in] registre Registre des joueurs à classer
+ */
+void initClassement(Classement* c, Registre* registre);
+
+/**
+ * @brief Libère la mémoire du classement
+ * @param[in,out] c Pointeur vers le classement
+ */
+void libererClassement(Classement* c);
+
+/**
+ * @brief Ajoute au classement un joueur inscrit après initClassement
+ * @param[in,out] c Pointeur vers le classement
+ * @param[in] id Indice du joueur dans le registre
+ */
+void ajouterAuClassement(Classement* c, int id);
+
+/**
+ * @brief Donne un point à un joueur et met son rang à jour en O(log P)
+ * @param[in,out] c Pointeur vers le classement
+ * @param[in] id Indice du joueur
+ */
+void marquerPoint(Classement* c, int id);
+
+/**
+ * @brief Remplace le score d'un joueur, par exemple à la reprise d'une partie, en O(log P)
+ * @param[in,out] c Pointeur vers le classement
+ * @param[in] id Indice du joueur
+ * @param[in] score Son score
+ */
+void fixerScore(Classement* c, int id, int score);
+
+/**
+ * @brief Renvoie le rang d'un joueur (1 pour le premier) en O(log P)
+ * @param[in] c Pointeur vers le classement
+ * @param[in] id Indice du joueur
+ * @return int Le rang
+ */
+int rangJoueur(const Classement* c, int id);
+
+/**
+ * @brief Remplit les indices des K premiers joueurs, du premier au K-ième
+ * @param[in] c Pointeur vers le classement
+ * @param[in] k Nombre de joueurs demandés
+ * @param[out] ids Tableau d'au moins k cases
+ * @return int Le nombre de joueurs écrits (moins de k s'il y a moins de joueurs)
+ */
+int meilleursJoueurs(const Classement* c, int k, int* ids);
+
+/**
+ * @brief Affiche les K premiers joueurs sur une ligne
+ * @param[in] c Pointeur vers le classement
+ * @param[in] k Nombre de joueurs à afficher
+ */
+void afficherClassement(const Classement* c, int k);
\ No newline at end of file
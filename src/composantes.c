@@ -0,0 +1,222 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "composantes.h"
+#include "etatcompact.h"
+#include "noyaux.h"
+#include "memoire.h"
+
+
+/**
+ * @struct Calcul
+ * @brief Données partagées par les fils de calcul des composantes
+ */
+typedef struct {
+    const Deck* deck;
+    const ConfigJeu* config;
+    EtatCompact* compacts;           /* Forme compacte de chaque position */
+    uint32_t* positionDeRang;        /* Indice dans le deck de chaque rang d'état */
+    _Atomic(uint32_t)* parent;       /* Forêt de l'union-find, indexée par position */
+    int ordres[NB_ORDRES_CONNUS];    /* Ordres qui relient les états */
+    int nbOrdres;
+    const Noyau* noyau;
+} Calcul;
+
+/**
+ * @struct Tranche
+ * @brief Positions traitées par un fil
+ */
+typedef struct {
+    Calcul* calcul;
+    int debut;
+    int fin;
+} Tranche;
+
+
+/**
+ * @brief Racine de x, en raccourcissant le chemin au passage (chaque noeud saute à son grand-père).
+ *        Un parent a toujours un indice plus petit que son enfant, les écritures concurrentes
+ *        gardent donc une forêt valide
+ * @param[in,out] parent La forêt
+ * @param[in] x Un élément
+ * @return uint32_t Sa racine
+ */
+static uint32_t trouver(_Atomic(uint32_t)* parent, uint32_t x) {
+    for (;;) {
+        uint32_t p = atomic_load_explicit(&parent[x], memory_order_relaxed);
+        if (p == x) return x;
+        uint32_t gp = atomic_load_explicit(&parent[p], memory_order_relaxed);
+        if (gp != p) atomic_compare_exchange_weak_explicit(&parent[x], &p, gp, memory_order_relaxed, memory_order_relaxed);
+        x = gp;
+    }
+}
+
+/**
+ * @brief Réunit les ensembles de a et b : la plus grande racine est accrochée à la plus petite
+ *        par un compare-and-swap, recommencé si un autre fil l'a accrochée entre-temps
+ * @param[in,out] parent La forêt
+ * @param[in] a Un élément
+ * @param[in] b Un autre élément
+ */
+static void unir(_Atomic(uint32_t)* parent, uint32_t a, uint32_t b) {
+    for (;;) {
+        a = trouver(parent, a);
+        b = trouver(parent, b);
+        if (a == b) return;
+        if (a > b) {
+            uint32_t t = a; a = b; b = t;
+        }
+        uint32_t attendu = b;
+        if (atomic_compare_exchange_strong(&parent[b], &attendu, a)) return;
+    }
+}
+
+/**
+ * @brief Première passe : forme compacte et rang de chaque position de la tranche
+ * @param[in] arg La Tranche
+ * @return int 0
+ */
+static int numeroterTranche(void* arg) {
+    Tranche* t = (Tranche*)arg;
+    Calcul* c = t->calcul;
+
+    for (int i = t->debut; i < t->fin; i++) {
+        compacterEtat(c->config, &c->deck->positions[i], &c->compacts[i]);
+        c->positionDeRang[c->noyau->rangEtat(&c->compacts[i])] = (uint32_t)i;
+        atomic_store_explicit(&c->parent[i], (uint32_t)i, memory_order_relaxed);
+    }
+    return 0;
+}
+
+/**
+ * @brief Deuxième passe : réunit chaque position de la tranche à ses voisines
+ * @param[in] arg La Tranche
+ * @return int 0
+ */
+static int unirTranche(void* arg) {
+    Tranche* t = (Tranche*)arg;
+    Calcul* c = t->calcul;
+
+    for (int i = t->debut; i < t->fin; i++) {
+        for (int k = 0; k < c->nbOrdres; k++) {
+            EtatCompact voisin = c->compacts[i];
+            if (!c->noyau->appliquerOrdre(&voisin, c->ordres[k])) continue;
+            unir(c->parent, (uint32_t)i, c->positionDeRang[c->noyau->rangEtat(&voisin)]);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lance une passe sur nbFils tranches égales, ou sur le fil appelant si un fil ne peut
+ *        pas être créé
+ */
+static void lancerPasse(Calcul* c, int nbFils, thrd_start_t passe) {
+    thrd_t fils[64];
+    Tranche tranches[64];
+    int nbLances = 0;
+    int n = c->deck->nbPositions;
+
+    if (nbFils > 64) nbFils = 64;
+    for (int f = 0; f < nbFils; f++) {
+        tranches[f].calcul = c;
+        tranches[f].debut = (int)((long long)n * f / nbFils);
+        tranches[f].fin = (int)((long long)n * (f + 1) / nbFils);
+    }
+    for (int f = 1; f < nbFils; f++) {
+        if (thrd_create(&fils[f], passe, &tranches[f]) != thrd_success) break;
+        nbLances++;
+    }
+    for (int f = nbLances + 1; f < nbFils; f++) passe(&tranches[f]);
+    passe(&tranches[0]);
+    for (int f = 1; f <= nbLances; f++) thrd_join(fils[f], NULL);
+}
+
+/**
+ * @brief Liste les ordres de la configuration qui relient les états dans les deux sens
+ * @param[in] config La configuration
+ * @param[out] ordres Les codes retenus
+ * @return int Leur nombre
+ */
+static int ordresReversibles(const ConfigJeu* config, int* ordres) {
+    int present[NB_ORDRES_CONNUS] = { 0 };
+    for (int i = 0; i < config->nbOrdres; i++) {
+        int code = codeOrdre(config->ordres[i]);
+        if (code >= 0) present[code] = 1;
+    }
+
+    /* SO est son propre inverse, NI et MA sont des rotations : ils suffisent à revenir en arrière.
+       KI n'est défait que par LO, les arêtes de LO étant celles de KI à l'envers */
+    int nb = 0;
+    if (present[ORDRE_KI] && present[ORDRE_LO]) ordres[nb++] = ORDRE_KI;
+    if (present[ORDRE_SO]) ordres[nb++] = ORDRE_SO;
+    if (present[ORDRE_NI]) ordres[nb++] = ORDRE_NI;
+    if (present[ORDRE_MA]) ordres[nb++] = ORDRE_MA;
+    return nb;
+}
+
+/**
+ * @brief Calcule les composantes et réordonne le deck
+ * @param[in,out] deck Le deck
+ * @param[in] config La configuration
+ * @param[in] nbFils Nombre de fils
+ * @return int Nombre de composantes
+ */
+int calculerComposantes(Deck* deck, const ConfigJeu* config, int nbFils) {
+    int n = deck->nbPositions;
+    if (n == 0 || (uint32_t)n != nbEtatsPossibles(config->nbAnimaux)) return 0;
+    if (nbFils < 1) nbFils = 1;
+
+    Calcul c;
+    c.deck = deck;
+    c.config = config;
+    c.nbOrdres = ordresReversibles(config, c.ordres);
+    c.noyau = config->noyau;
+    c.compacts = (EtatCompact*)allouerMem(MEM_DECK, sizeof(EtatCompact) * n);
+    c.positionDeRang = (uint32_t*)allouerMem(MEM_DECK, sizeof(uint32_t) * n);
+    c.parent = (_Atomic(uint32_t)*)allouerMem(MEM_DECK, sizeof(uint32_t) * n);
+    int* identifiant = (int*)allouerMem(MEM_DECK, sizeof(int) * n);
+    EtatJeu* ranges = (EtatJeu*)allouerMem(MEM_DECK, sizeof(EtatJeu) * n);
+    if (c.compacts == NULL || c.positionDeRang == NULL || c.parent == NULL || identifiant == NULL || ranges == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les composantes du deck.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    lancerPasse(&c, nbFils, numeroterTranche);
+    lancerPasse(&c, nbFils, unirTranche);
+
+    /* La racine est le plus petit indice de sa composante : elle est numérotée avant les autres */
+    int nbComposantes = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t racine = trouver(c.parent, (uint32_t)i);
+        identifiant[i] = (racine == (uint32_t)i) ? nbComposantes++ : identifiant[racine];
+    }
+
+    int* debuts = (int*)allouerMemZero(MEM_DECK, (size_t)nbComposantes + 1, sizeof(int));
+    if (debuts == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les composantes du deck.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) debuts[identifiant[i] + 1]++;
+    for (int k = 0; k < nbComposantes; k++) debuts[k + 1] += debuts[k];
+
+    /* Rangement stable : l'ordre des positions est conservé à l'intérieur d'une composante */
+    for (int i = 0; i < n; i++) ranges[debuts[identifiant[i]]++] = deck->positions[i];
+    for (int k = nbComposantes; k > 0; k--) debuts[k] = debuts[k - 1];
+    debuts[0] = 0;
+    memcpy(deck->positions, ranges, sizeof(EtatJeu) * n);
+
+    libererMem(ranges);
+    libererMem(identifiant);
+    libererMem((void*)c.parent);
+    libererMem(c.positionDeRang);
+    libererMem(c.compacts);
+
+    libererMem(deck->debutComposantes);
+    deck->debutComposantes = debuts;
+    deck->nbComposantes = nbComposantes;
+    return nbComposantes;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "jeu.h"
+
+/**
+ * @brief Regroupe les positions du deck par composante du graphe des états sous les ordres de la
+ *        configuration, à l'aide d'un union-find parallèle sans verrou. Les positions sont
+ *        réordonnées pour que chaque composante occupe une plage contiguë du deck, ce qui permet
+ *        à tirerCarteAtteignable de ne chercher que dans la plage de l'état courant.
+ *        Seuls les ordres réversibles relient les états (KI et LO seulement s'ils sont présents
+ *        tous les deux) : les composantes sont alors exactement les ensembles d'états
+ *        mutuellement atteignables. Doit être appelée avant tout tirage et avant partagerPositions
+ * @param[in,out] deck Deck tout juste généré par genererToutesPositions
+ * @param[in] config Configuration qui donne les animaux et les ordres autorisés
+ * @param[in] nbFils Nombre de fils de calcul
+ * @return int Nombre de composantes
+ */
+int calculerComposantes(Deck* deck, const ConfigJeu* config, int nbFils);
@@ -0,0 +1,258 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "denombrement.h"
+#include "solveur.h"
+#include "memoire.h"
+
+#define DISTANCE_NON_VUE 0xFF
+
+
+/**
+ * @struct Part
+ * @brief Hauteurs de départ traitées par un fil et leur cumul
+ */
+typedef struct {
+    const ConfigJeu* config;
+    int longueurMax;
+    int indice;
+    int nbFils;
+    StatistiquesSolutions stats;
+} Part;
+
+
+/**
+ * @brief Addition saturée à 2^64 - 1
+ */
+static uint64_t ajouterSature(uint64_t a, uint64_t b) {
+    uint64_t s = a + b;
+    return s < a ? SOLUTIONS_SATUREES : s;
+}
+
+/**
+ * @brief Prépare un compteur
+ * @param[out] c Le compteur
+ * @param[in] config La configuration
+ */
+void initCompteur(Compteur* c, const ConfigJeu* config) {
+    /* Mêmes ordres, dédoublonnés, que le solveur */
+    Solveur s;
+    initSolveur(&s, config);
+
+    c->nbAnimaux = s.nbAnimaux;
+    c->nbOrdres = s.nbOrdres;
+    memcpy(c->ordres, s.ordres, sizeof(c->ordres));
+    c->nbEtats = s.nbEtats;
+    c->noyau = s.noyau;
+    c->couche = NULL;
+    c->suivante = NULL;
+    c->atteints = NULL;
+    c->nbAtteints = 0;
+    c->distance = NULL;
+}
+
+/**
+ * @brief Libère le compteur
+ * @param[in,out] c Le compteur
+ */
+void libererCompteur(Compteur* c) {
+    libererMem(c->couche);
+    libererMem(c->suivante);
+    libererMem(c->atteints);
+    libererMem(c->distance);
+    c->couche = NULL;
+    c->suivante = NULL;
+    c->atteints = NULL;
+    c->distance = NULL;
+}
+
+/**
+ * @brief Alloue les deux couches au premier appel, mises à zéro une fois pour toutes : chaque
+ *        dénombrement ne remet ensuite à zéro que les états qu'il a atteints
+ * @param[in,out] c Le compteur
+ */
+static void allouerCouches(Compteur* c) {
+    if (c->couche != NULL) return;
+
+    c->couche = (uint64_t*)allouerMemZero(MEM_SOLVEUR, c->nbEtats, sizeof(uint64_t));
+    c->suivante = (uint64_t*)allouerMemZero(MEM_SOLVEUR, c->nbEtats, sizeof(uint64_t));
+    c->atteints = (uint32_t*)allouerMem(MEM_SOLVEUR, sizeof(uint32_t) * c->nbEtats);
+    c->distance = (uint8_t*)allouerMem(MEM_SOLVEUR, c->nbEtats);
+    if (c->couche == NULL || c->suivante == NULL || c->atteints == NULL || c->distance == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le denombrement.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(c->distance, DISTANCE_NON_VUE, c->nbEtats);
+}
+
+/**
+ * @brief Remplit la couche avec les suites de longueur au plus longueurMax depuis depart.
+ *        Le support de la couche t est la boule de rayon t : seuls ses états sont poussés, et
+ *        un état est nouveau quand il est nul dans les deux couches
+ * @param[in,out] c Le compteur, remis à zéro par effacer
+ * @param[in] depart État de départ
+ * @param[in] longueurMax Longueur maximale
+ */
+static void propager(Compteur* c, const EtatCompact* depart, int longueurMax) {
+    allouerCouches(c);
+    if (longueurMax > LONGUEUR_MAX_DENOMBREE) longueurMax = LONGUEUR_MAX_DENOMBREE;
+
+    uint32_t rangDepart = c->noyau->rangEtat(depart);
+    c->couche[rangDepart] = 1;
+    c->distance[rangDepart] = 0;
+    c->atteints[0] = rangDepart;
+    c->nbAtteints = 1;
+
+    for (int t = 0; t < longueurMax; t++) {
+        uint64_t* x = c->couche;
+        uint64_t* y = c->suivante;
+        uint32_t nb = c->nbAtteints;
+
+        /* La couche t - 1 occupait une partie de la boule de rayon t */
+        for (uint32_t i = 0; i < nb; i++) y[c->atteints[i]] = 0;
+
+        for (uint32_t i = 0; i < nb; i++) {
+            uint32_t r = c->atteints[i];
+            uint64_t v = x[r];
+            uint32_t voisins[NB_ORDRES_CONNUS];
+            c->noyau->voisins(r, c->nbAnimaux, c->ordres, c->nbOrdres, voisins);
+
+            for (int k = 0; k < c->nbOrdres; k++) {
+                uint32_t q = voisins[k];
+                if (q == RANG_IMPOSSIBLE) continue;
+                if (x[q] == 0 && y[q] == 0) {
+                    c->atteints[c->nbAtteints++] = q;
+                    c->distance[q] = (uint8_t)(t + 1);
+                }
+                y[q] = ajouterSature(y[q], v);
+            }
+        }
+        y[rangDepart] = ajouterSature(y[rangDepart], 1);
+
+        c->couche = y;
+        c->suivante = x;
+    }
+}
+
+/**
+ * @brief Remet à zéro les états atteints par le dernier dénombrement
+ * @param[in,out] c Le compteur
+ */
+static void effacer(Compteur* c) {
+    for (uint32_t i = 0; i < c->nbAtteints; i++) {
+        uint32_t r = c->atteints[i];
+        c->couche[r] = 0;
+        c->suivante[r] = 0;
+        c->distance[r] = DISTANCE_NON_VUE;
+    }
+    c->nbAtteints = 0;
+}
+
+/**
+ * @brief Dénombre les solutions d'une paire
+ * @param[in,out] c Le compteur
+ * @param[in] depart Le départ
+ * @param[in] arrivee L'arrivée
+ * @param[in] longueurMax Longueur maximale
+ * @return uint64_t Le nombre de suites
+ */
+uint64_t compterSolutions(Compteur* c, const EtatCompact* depart, const EtatCompact* arrivee, int longueurMax) {
+    propager(c, depart, longueurMax);
+    uint64_t n = c->couche[c->noyau->rangEtat(arrivee)];
+    effacer(c);
+    return n;
+}
+
+/**
+ * @brief Cumule les hauteurs d'un fil
+ * @param[in] arg La Part
+ * @return int 0
+ */
+static int denombrerPart(void* arg) {
+    Part* p = (Part*)arg;
+    Compteur c;
+    initCompteur(&c, p->config);
+
+    /* Chaque départ canonique représente les n! départs de même hauteur */
+    uint64_t poids = c.nbEtats / (uint32_t)(c.nbAnimaux + 1);
+
+    for (int h = p->indice; h <= c.nbAnimaux; h += p->nbFils) {
+        EtatCompact depart;
+        depart.nb = (uint8_t)c.nbAnimaux;
+        depart.hauteur = (uint8_t)h;
+        for (int i = 0; i < c.nbAnimaux; i++) depart.animaux[i] = (uint8_t)i;
+
+        propager(&c, &depart, p->longueurMax);
+        for (uint32_t i = 0; i < c.nbAtteints; i++) {
+            uint32_t r = c.atteints[i];
+            uint64_t n = c.couche[r];
+            LigneSolutions* l = &p->stats.lignes[c.distance[r]];
+
+            if (l->nbPaires == 0 || n < l->min) l->min = n;
+            if (n > l->max) l->max = n;
+            l->nbPaires += poids;
+            l->somme += (double)n * (double)poids;
+            if (n == SOLUTIONS_SATUREES) l->nbSaturees += poids;
+        }
+        effacer(&c);
+    }
+
+    libererCompteur(&c);
+    return 0;
+}
+
+/**
+ * @brief Dénombre les solutions de toutes les paires du deck
+ * @param[in] config La configuration
+ * @param[in] longueurMax Longueur maximale
+ * @param[in] nbFils Nombre de fils
+ * @param[out] st Les statistiques
+ */
+void denombrerDeck(const ConfigJeu* config, int longueurMax, int nbFils, StatistiquesSolutions* st) {
+    if (longueurMax > LONGUEUR_MAX_DENOMBREE) longueurMax = LONGUEUR_MAX_DENOMBREE;
+    if (nbFils > config->nbAnimaux + 1) nbFils = config->nbAnimaux + 1;
+    if (nbFils < 1) nbFils = 1;
+
+    Part* parts = (Part*)allouerMemZero(MEM_SOLVEUR, (size_t)nbFils, sizeof(Part));
+    thrd_t* fils = (thrd_t*)allouerMem(MEM_SOLVEUR, sizeof(thrd_t) * nbFils);
+    if (parts == NULL || fils == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le denombrement.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int nbLances = 0;
+    for (int f = 0; f < nbFils; f++) {
+        parts[f].config = config;
+        parts[f].longueurMax = longueurMax;
+        parts[f].indice = f;
+        parts[f].nbFils = nbFils;
+    }
+    for (int f = 1; f < nbFils; f++) {
+        if (thrd_create(&fils[f], denombrerPart, &parts[f]) != thrd_success) break;
+        nbLances++;
+    }
+    for (int f = nbLances + 1; f < nbFils; f++) denombrerPart(&parts[f]);
+    denombrerPart(&parts[0]);
+    for (int f = 1; f <= nbLances; f++) thrd_join(fils[f], NULL);
+
+    memset(st, 0, sizeof(StatistiquesSolutions));
+    st->longueurMax = longueurMax;
+    for (int f = 0; f < nbFils; f++) {
+        for (int d = 0; d <= longueurMax; d++) {
+            const LigneSolutions* l = &parts[f].stats.lignes[d];
+            LigneSolutions* total = &st->lignes[d];
+            if (l->nbPaires == 0) continue;
+
+            if (total->nbPaires == 0 || l->min < total->min) total->min = l->min;
+            if (l->max > total->max) total->max = l->max;
+            total->nbPaires += l->nbPaires;
+            total->nbSaturees += l->nbSaturees;
+            total->somme += l->somme;
+        }
+    }
+
+    libererMem(fils);
+    libererMem(parts);
+}
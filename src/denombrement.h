@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include "etatcompact.h"
+#include "noyaux.h"
+
+/**
+ * @def LONGUEUR_MAX_DENOMBREE
+ * @brief Plus grande longueur de séquence acceptée par le dénombrement
+ */
+#define LONGUEUR_MAX_DENOMBREE 254
+
+/**
+ * @def SOLUTIONS_SATUREES
+ * @brief Valeur des comptes qui ont dépassé 2^64 - 1
+ */
+#define SOLUTIONS_SATUREES UINT64_MAX
+
+
+/**
+ * @struct Compteur
+ * @brief Dénombre les suites d'ordres de longueur au plus k qui mènent d'un état à un autre.
+ *        Programmation dynamique sur le graphe des états, en ne gardant que deux couches :
+ *        la couche t compte les suites de longueur au plus t depuis le départ, et la couche
+ *        t + 1 s'obtient en poussant la couche t d'un ordre puis en ajoutant le départ.
+ *        Les tableaux sont alloués au premier appel puis réutilisés, comme ceux du Solveur
+ */
+typedef struct {
+    int nbAnimaux;
+    int ordres[NB_ORDRES_CONNUS];  /* Codes des ordres autorisés */
+    int nbOrdres;
+    uint32_t nbEtats;              /* nbEtatsPossibles(nbAnimaux) */
+    const Noyau* noyau;            /* Celui du solveur */
+    uint64_t* couche;              /* Suites de longueur au plus t vers chaque état, saturées */
+    uint64_t* suivante;            /* Couche t + 1 en construction */
+    uint32_t* atteints;            /* États non nuls de la couche, dans l'ordre où ils sont atteints */
+    uint32_t nbAtteints;
+    uint8_t* distance;             /* Longueur de la plus courte suite vers chaque état atteint */
+} Compteur;
+
+/**
+ * @struct LigneSolutions
+ * @brief Nombre de solutions des paires (départ, arrivée) à une même distance
+ */
+typedef struct {
+    uint64_t nbPaires;      /* Paires dont la plus courte solution a cette longueur */
+    uint64_t nbSaturees;    /* Paires dont le compte a dépassé 2^64 - 1 */
+    uint64_t min;
+    uint64_t max;
+    double somme;           /* Somme des comptes, pour la moyenne */
+} LigneSolutions;
+
+/**
+ * @struct StatistiquesSolutions
+ * @brief Nombre de solutions de longueur au plus longueurMax pour toutes les paires du deck,
+ *        regroupées par longueur de la plus courte solution
+ */
+typedef struct {
+    int longueurMax;
+    LigneSolutions lignes[LONGUEUR_MAX_DENOMBREE + 1];
+} StatistiquesSolutions;
+
+
+
+/**
+ * @brief Prépare un compteur pour une configuration validée
+ * @param[out] c Pointeur vers le compteur
+ * @param[in] config Configuration qui fixe le nombre d'animaux et les ordres autorisés
+ */
+void initCompteur(Compteur* c, const ConfigJeu* config);
+
+/**
+ * @brief Libère les tableaux du compteur
+ * @param[in,out] c Pointeur vers le compteur
+ */
+void libererCompteur(Compteur* c);
+
+/**
+ * @brief Nombre de suites d'ordres distinctes, de longueur au plus longueurMax, qui mènent de
+ *        depart à arrivee. Chaque ordre de la suite doit être possible
+ * @param[in,out] c Pointeur vers le compteur
+ * @param[in] depart État de départ
+ * @param[in] arrivee État à atteindre
+ * @param[in] longueurMax Longueur maximale des suites (au plus LONGUEUR_MAX_DENOMBREE)
+ * @return uint64_t Le nombre de suites, SOLUTIONS_SATUREES s'il dépasse 2^64 - 1
+ */
+uint64_t compterSolutions(Compteur* c, const EtatCompact* depart, const EtatCompact* arrivee, int longueurMax);
+
+/**
+ * @brief Dénombre les solutions de toutes les paires d'états, c'est-à-dire de toutes les paires
+ *        de cartes du deck complet. Les ordres déplacent des cases sans regarder les animaux :
+ *        une programmation dynamique par hauteur de départ suffit, chacune valant pour les n!
+ *        départs de cette hauteur. Les hauteurs sont réparties entre nbFils fils, chacun avec
+ *        son propre compteur
+ * @param[in] config Configuration validée
+ * @param[in] longueurMax Longueur maximale des suites (au plus LONGUEUR_MAX_DENOMBREE)
+ * @param[in] nbFils Nombre de fils
+ * @param[out] st Statistiques par longueur de plus courte solution
+ */
+void denombrerDeck(const ConfigJeu* config, int longueurMax, int nbFils, StatistiquesSolutions* st);
@@ -0,0 +1,400 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "distances.h"
+#include "solveur.h"
+#include "sondes.h"
+#include "memoire.h"
+
+/**
+ * @def BLOC_BALAYAGE
+ * @brief Nombre de distances examinées d'un coup par le balayage de la table
+ */
+#define BLOC_BALAYAGE 256
+
+/**
+ * @def ESSAIS_PAR_ETAT
+ * @brief Essais au hasard par état de la bande attendu avant de compter ses cartes libres :
+ *        ils ne manquent toutes les cartes libres que si elles sont rares dans la bande
+ */
+#define ESSAIS_PAR_ETAT 64
+
+/**
+ * @def BANDE_MIN
+ * @brief Une bande qui ne couvre pas un état sur BANDE_MIN de la table est tirée directement
+ *        par comptage, sans essais au hasard qui tomberaient presque tous hors de la bande
+ */
+#define BANDE_MIN 4096
+
+
+/**
+ * @struct Travail
+ * @brief Part du calcul confiée à un fil : une tranche de l'index et une hauteur sur nbFils
+ */
+typedef struct {
+    Distances* distances;
+    const Deck* deck;
+    const ConfigJeu* config;
+    const Solveur* ordres;     /* Seuls les ordres du solveur servent, ses tableaux restent vides */
+    int indice;
+    int nbFils;
+} Travail;
+
+
+/**
+ * @brief Parcours en largeur par niveaux depuis l'état canonique de la hauteur h. Chaque niveau
+ *        balaie la table des distances au lieu de tenir une file : aucun tableau de plus que la
+ *        table elle-même
+ * @param[in,out] niv Les niveaux à remplir, distance et proches déjà alloués
+ * @param[in] s Ordres autorisés
+ * @param[in] n Nombre d'animaux
+ * @param[in] nbEtats Nombre d'états
+ * @param[in] h Hauteur de départ
+ */
+static void parcourir(Niveaux* niv, const Solveur* s, int n, uint32_t nbEtats, int h) {
+    EtatCompact depart;
+    depart.nb = (uint8_t)n;
+    depart.hauteur = (uint8_t)h;
+    for (int i = 0; i < n; i++) depart.animaux[i] = (uint8_t)i;
+
+    uint32_t rangDepart = s->noyau->rangEtat(&depart);
+    memset(niv->distance, DISTANCE_INFINIE, nbEtats);
+    memset(niv->nombre, 0, sizeof(niv->nombre));
+    niv->distance[rangDepart] = 0;
+    niv->nombre[0] = 1;
+    niv->distanceMax = 0;
+    niv->proches[0] = rangDepart;
+    niv->debutProches[0] = 0;
+    niv->debutProches[1] = 1;
+    niv->nbNiveauxProches = 1;
+
+    uint32_t nbProches = 1;
+    for (int d = 0; d + 1 < DISTANCE_INFINIE; d++) {
+        uint32_t nouveaux = 0;
+        int listes = (niv->nbNiveauxProches == d + 1);
+
+        for (uint32_t r = 0; r < nbEtats; r++) {
+            if (niv->distance[r] != d) continue;
+
+            uint32_t voisins[NB_ORDRES_CONNUS];
+            s->noyau->voisins(r, n, s->ordres, s->nbOrdres, voisins);
+            for (int k = 0; k < s->nbOrdres; k++) {
+                uint32_t q = voisins[k];
+                if (q == RANG_IMPOSSIBLE || niv->distance[q] != DISTANCE_INFINIE) continue;
+                niv->distance[q] = (uint8_t)(d + 1);
+                nouveaux++;
+                if (listes && nbProches < PROCHES_MAX) niv->proches[nbProches++] = q;
+                else listes = 0;
+            }
+        }
+        if (nouveaux == 0) break;
+
+        niv->nombre[d + 1] = nouveaux;
+        niv->distanceMax = d + 1;
+        if (listes) {
+            niv->nbNiveauxProches = d + 2;
+            niv->debutProches[d + 2] = nbProches;
+        }
+    }
+}
+
+/**
+ * @brief Liste les états des dernières distances, tant qu'elles tiennent ensemble dans
+ *        LOINTAINS_MAX et LOINTAINS_PART : un tirage dans ces bandes ne parcourt plus que leurs
+ *        états. Un seul balayage de la table les range par distance
+ * @param[in,out] niv Les niveaux d'un parcours terminé
+ * @param[in] nbEtats Nombre d'états
+ */
+static void listerLointains(Niveaux* niv, uint32_t nbEtats) {
+    uint32_t total = 0;
+    uint32_t max = (nbEtats / LOINTAINS_PART < LOINTAINS_MAX) ? nbEtats / LOINTAINS_PART : LOINTAINS_MAX;
+    int premier = niv->distanceMax + 1;
+    while (premier > niv->nbNiveauxProches && total + niv->nombre[premier - 1] <= max) {
+        premier--;
+        total += niv->nombre[premier];
+    }
+    niv->premierNiveauLointain = premier;
+    niv->debutLointains[premier] = 0;
+    for (int k = premier; k <= niv->distanceMax; k++) niv->debutLointains[k + 1] = niv->debutLointains[k] + niv->nombre[k];
+    if (total == 0) return;
+
+    niv->lointains = (uint32_t*)allouerMem(MEM_SOLVEUR, sizeof(uint32_t) * total);
+    if (niv->lointains == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les distances du deck.\n");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t suivant[DISTANCE_INFINIE + 1];
+    memcpy(suivant, niv->debutLointains, sizeof(suivant));
+    for (uint32_t r = 0; r < nbEtats; r++) {
+        int k = niv->distance[r];
+        if (k >= premier && k != DISTANCE_INFINIE) niv->lointains[suivant[k]++] = r;
+    }
+}
+
+/**
+ * @brief Travail d'un fil : sa tranche de l'index des positions, puis ses hauteurs
+ * @param[in] arg Le Travail
+ * @return int 0
+ */
+static int travailler(void* arg) {
+    Travail* t = (Travail*)arg;
+    Distances* d = t->distances;
+    int n = t->deck->nbPositions;
+
+    int debut = (int)((long long)n * t->indice / t->nbFils);
+    int fin = (int)((long long)n * (t->indice + 1) / t->nbFils);
+    for (int i = debut; i < fin; i++) {
+        EtatCompact c;
+        compacterEtat(t->config, &t->deck->positions[i], &c);
+        d->positionDeRang[d->noyau->rangEtat(&c)] = (uint32_t)i;
+    }
+
+    for (int h = t->indice; h <= d->nbAnimaux; h += t->nbFils) {
+        parcourir(&d->niveaux[h], t->ordres, d->nbAnimaux, d->nbEtats, h);
+        listerLointains(&d->niveaux[h], d->nbEtats);
+    }
+    return 0;
+}
+
+/**
+ * @brief Calcule toutes les tables
+ * @param[out] d Les distances
+ * @param[in] deck Le deck complet
+ * @param[in] config La configuration
+ * @param[in] nbFils Nombre de fils
+ * @return int 1 si prêtes, 0 sinon
+ */
+int calculerDistances(Distances* d, const Deck* deck, const ConfigJeu* config, int nbFils) {
+    memset(d, 0, sizeof(Distances));
+    d->nbAnimaux = config->nbAnimaux;
+    d->nbEtats = nbEtatsPossibles(config->nbAnimaux);
+    d->noyau = config->noyau;
+    if (deck->nbPositions == 0 || (uint32_t)deck->nbPositions != d->nbEtats) return 0;
+    if (nbFils < 1) nbFils = 1;
+    if (nbFils > 64) nbFils = 64;
+
+    int echec = 0;
+    d->positionDeRang = (uint32_t*)allouerMem(MEM_SOLVEUR, sizeof(uint32_t) * d->nbEtats);
+    echec |= (d->positionDeRang == NULL);
+    for (int h = 0; h <= d->nbAnimaux; h++) {
+        d->niveaux[h].distance = (uint8_t*)allouerMem(MEM_SOLVEUR, d->nbEtats);
+        d->niveaux[h].proches = (uint32_t*)allouerMem(MEM_SOLVEUR, sizeof(uint32_t) * PROCHES_MAX);
+        echec |= (d->niveaux[h].distance == NULL || d->niveaux[h].proches == NULL);
+    }
+    if (echec) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les distances du deck.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Solveur ordres;
+    initSolveur(&ordres, config);
+
+    thrd_t fils[64];
+    Travail travaux[64];
+    int nbLances = 0;
+    for (int f = 0; f < nbFils; f++) {
+        travaux[f] = (Travail){ d, deck, config, &ordres, f, nbFils };
+    }
+    for (int f = 1; f < nbFils; f++) {
+        if (thrd_create(&fils[f], travailler, &travaux[f]) != thrd_success) break;
+        nbLances++;
+    }
+    for (int f = nbLances + 1; f < nbFils; f++) travailler(&travaux[f]);
+    travailler(&travaux[0]);
+    for (int f = 1; f <= nbLances; f++) thrd_join(fils[f], NULL);
+    return 1;
+}
+
+/**
+ * @brief Libère les tables
+ * @param[in,out] d Les distances
+ */
+void libererDistances(Distances* d) {
+    for (int h = 0; h <= MAX_ANIMAUX; h++) {
+        libererMem(d->niveaux[h].distance);
+        libererMem(d->niveaux[h].proches);
+        libererMem(d->niveaux[h].lointains);
+        d->niveaux[h].distance = NULL;
+        d->niveaux[h].proches = NULL;
+        d->niveaux[h].lointains = NULL;
+    }
+    libererMem(d->positionDeRang);
+    d->positionDeRang = NULL;
+}
+
+/**
+ * @brief Position dans le deck d'un état donné relativement à depuis
+ * @param[in] d Les distances
+ * @param[in] depuis Position de départ
+ * @param[in] rang Rang de l'état vu depuis l'état canonique de la hauteur de depuis
+ * @return int L'indice de la carte dans le deck
+ */
+static int positionRelative(const Distances* d, const EtatCompact* depuis, uint32_t rang) {
+    EtatCompact canonique, e;
+    d->noyau->etatDeRang(rang, d->nbAnimaux, &canonique);
+    e.nb = canonique.nb;
+    e.hauteur = canonique.hauteur;
+    for (int i = 0; i < d->nbAnimaux; i++) e.animaux[i] = depuis->animaux[canonique.animaux[i]];
+
+    return (int)d->positionDeRang[d->noyau->rangEtat(&e)];
+}
+
+/**
+ * @brief Liste des états d'une bande, si elle est entièrement parmi les proches ou parmi les lointains
+ * @param[out] nb Nombre d'états de la bande
+ * @return const uint32_t* Le premier état de la bande, NULL si elle n'est pas listée
+ */
+static const uint32_t* listeBande(const Niveaux* niv, int distanceMin, int distanceMax, uint32_t* nb) {
+    if (distanceMax < niv->nbNiveauxProches) {
+        *nb = niv->debutProches[distanceMax + 1] - niv->debutProches[distanceMin];
+        return niv->proches + niv->debutProches[distanceMin];
+    }
+    if (distanceMin >= niv->premierNiveauLointain && niv->lointains != NULL) {
+        *nb = niv->debutLointains[distanceMax + 1] - niv->debutLointains[distanceMin];
+        return niv->lointains + niv->debutLointains[distanceMin];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Essaie des états de la bande tirés au hasard : chaque essai tombe uniformément sur un
+ *        état de la bande et n'est gardé que si sa carte est libre, la carte obtenue est donc
+ *        uniforme parmi les cartes libres de la bande. Quand la bande est entièrement listée, les
+ *        essais portent sur sa liste ; sinon sur toute la table, un état hors bande étant écarté
+ * @param[in] nbEssais Nombre d'essais avant d'abandonner
+ * @return EtatJeu* La carte réservée ou NULL
+ */
+static EtatJeu* essayerAuHasard(const Distances* d, const Niveaux* niv, Deck* deck, Alea* alea,
+                                const EtatCompact* depuis, int distanceMin, int distanceMax, uint32_t nbEssais) {
+    uint32_t nb;
+    const uint32_t* liste = listeBande(niv, distanceMin, distanceMax, &nb);
+    if (liste == NULL) nb = d->nbEtats;
+    uint8_t bas = (uint8_t)distanceMin;
+    uint8_t ecart = (uint8_t)(distanceMax - distanceMin);
+
+    for (uint32_t essai = 0; essai < nbEssais; essai++) {
+        uint32_t r = tirerBorne(alea, nb);
+        if (liste != NULL) r = liste[r];
+        else if ((uint8_t)(niv->distance[r] - bas) > ecart) continue;
+
+        int i = positionRelative(d, depuis, r);
+        if (!estCarteLibre(deck, i)) continue;
+        EtatJeu* carte = prendreCarte(deck, i);
+        if (carte != NULL) return carte;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Indique si un bloc complet de la table contient un état de la bande, par une simple
+ *        réduction de longueur fixe que le compilateur peut vectoriser
+ */
+static int blocDansBande(const uint8_t* distance, uint8_t bas, uint8_t ecart) {
+    uint8_t dansBande = 0;
+    for (int j = 0; j < BLOC_BALAYAGE; j++) dansBande |= (uint8_t)((uint8_t)(distance[j] - bas) <= ecart);
+    return dansBande;
+}
+
+/**
+ * @brief Parcourt dans l'ordre les états de la bande dont la carte est libre, en décomptant *k :
+ *        la liste des proches ou des lointains si la bande y tient, sinon la table des distances
+ *        par blocs, les blocs sans aucun état de la bande étant écartés d'un coup
+ * @return int L'indice de la carte libre de rang *k, ou -1 s'il y en a moins, *k étant alors
+ *         diminué de toutes celles de la bande
+ */
+static int parcourirBande(const Distances* d, const Niveaux* niv, const Deck* deck, const EtatCompact* depuis,
+                          int distanceMin, int distanceMax, uint32_t* k) {
+    uint32_t nb;
+    const uint32_t* liste = listeBande(niv, distanceMin, distanceMax, &nb);
+    if (liste != NULL) {
+        for (uint32_t j = 0; j < nb; j++) {
+            int i = positionRelative(d, depuis, liste[j]);
+            if (!estCarteLibre(deck, i)) continue;
+            if (*k == 0) return i;
+            (*k)--;
+        }
+        return -1;
+    }
+
+    uint8_t bas = (uint8_t)distanceMin;
+    uint8_t ecart = (uint8_t)(distanceMax - distanceMin);
+    const uint8_t* distance = niv->distance;
+    for (uint32_t debut = 0; debut < d->nbEtats; debut += BLOC_BALAYAGE) {
+        uint32_t fin = debut + BLOC_BALAYAGE < d->nbEtats ? debut + BLOC_BALAYAGE : d->nbEtats;
+
+        if (fin - debut == BLOC_BALAYAGE && !blocDansBande(distance + debut, bas, ecart)) continue;
+
+        for (uint32_t r = debut; r < fin; r++) {
+            if ((uint8_t)(distance[r] - bas) > ecart) continue;
+            int i = positionRelative(d, depuis, r);
+            if (!estCarteLibre(deck, i)) continue;
+            if (*k == 0) return i;
+            (*k)--;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Compte les cartes libres de la bande, en tire le rang puis réserve la carte de ce rang.
+ *        Si un autre fil l'a prise entre-temps, recommence
+ * @return EtatJeu* La carte réservée ou NULL si la bande n'a plus de carte libre
+ */
+static EtatJeu* tirerParRang(const Distances* d, const Niveaux* niv, Deck* deck, Alea* alea,
+                             const EtatCompact* depuis, int distanceMin, int distanceMax) {
+    for (;;) {
+        uint32_t k = UINT32_MAX;
+        parcourirBande(d, niv, deck, depuis, distanceMin, distanceMax, &k);
+        uint32_t libres = UINT32_MAX - k;
+        if (libres == 0) return NULL;
+
+        k = tirerBorne(alea, libres);
+        int i = parcourirBande(d, niv, deck, depuis, distanceMin, distanceMax, &k);
+        if (i < 0) continue;
+        EtatJeu* carte = prendreCarte(deck, i);
+        if (carte != NULL) return carte;
+    }
+}
+
+/**
+ * @brief Tire une carte dans une bande de distance
+ * @param[in] d Les distances
+ * @param[in,out] deck Le paquet
+ * @param[in,out] alea Le générateur
+ * @param[in] config La configuration
+ * @param[in] depuis Position de départ
+ * @param[in] distanceMin Borne basse
+ * @param[in] distanceMax Borne haute
+ * @return EtatJeu* La carte ou NULL
+ */
+EtatJeu* tirerCarteDifficulte(const Distances* d, Deck* deck, Alea* alea, const ConfigJeu* config,
+                              const EtatJeu* depuis, int distanceMin, int distanceMax) {
+    unsigned long long debut = debutSonde();
+    EtatJeu* carte = NULL;
+
+    EtatCompact c;
+    compacterEtat(config, depuis, &c);
+    const Niveaux* niv = &d->niveaux[c.hauteur];
+
+    if (distanceMin < 0) distanceMin = 0;
+    if (distanceMax > niv->distanceMax) distanceMax = niv->distanceMax;
+
+    uint32_t nbBande = 0;
+    for (int k = distanceMin; k <= distanceMax; k++) nbBande += niv->nombre[k];
+
+    if (nbBande > 0) {
+        /* Les essais au hasard ne valent que si la bande n'est pas une infime partie de la table */
+        uint32_t nbEssais = ESSAIS_PAR_ETAT;
+        uint32_t nbListes;
+        if (listeBande(niv, distanceMin, distanceMax, &nbListes) == NULL) {
+            nbEssais = (nbBande < d->nbEtats / BANDE_MIN) ? 0 : ESSAIS_PAR_ETAT * (d->nbEtats / nbBande);
+        }
+        carte = essayerAuHasard(d, niv, deck, alea, &c, distanceMin, distanceMax, nbEssais);
+        if (carte == NULL) carte = tirerParRang(d, niv, deck, alea, &c, distanceMin, distanceMax);
+    }
+
+    finSonde(SONDE_TIRAGE, debut);
+    return carte;
+}
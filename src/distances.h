@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+#include "jeu.h"
+#include "etatcompact.h"
+#include "noyaux.h"
+
+/**
+ * @def DISTANCE_INFINIE
+ * @brief Distance des états inaccessibles, ou trop loin pour tenir sur un octet
+ */
+#define DISTANCE_INFINIE 0xFF
+
+/**
+ * @def PROCHES_MAX
+ * @brief Nombre d'états les plus proches gardés dans l'ordre du parcours pour chaque hauteur
+ */
+#define PROCHES_MAX 16384
+
+/**
+ * @def LOINTAINS_MAX
+ * @brief Nombre maximal d'états les plus éloignés gardés par distance pour chaque hauteur : les
+ *        dernières distances, trop peu peuplées pour être trouvées au hasard dans la table
+ */
+#define LOINTAINS_MAX 131072
+
+/**
+ * @def LOINTAINS_PART
+ * @brief Les états lointains gardés ne dépassent pas non plus un état sur LOINTAINS_PART de la
+ *        table : au-delà, les essais au hasard dans la table trouvent vite un état de la bande
+ */
+#define LOINTAINS_PART 16
+
+
+/**
+ * @struct Niveaux
+ * @brief Parcours en largeur complet depuis l'état canonique d'une hauteur : animaux dans
+ *        l'ordre de la configuration, podium bleu de cette hauteur
+ */
+typedef struct {
+    uint8_t* distance;                         /* Distance de chaque rang, DISTANCE_INFINIE si inaccessible */
+    uint32_t nombre[DISTANCE_INFINIE];         /* Nombre d'états à chaque distance */
+    int distanceMax;                           /* Plus grande distance atteinte */
+    uint32_t* proches;                         /* Rangs des états les plus proches, par distance croissante */
+    int nbNiveauxProches;                      /* Les distances 0 à nbNiveauxProches - 1 sont toutes dans proches */
+    uint32_t debutProches[DISTANCE_INFINIE + 1]; /* Les états à distance d sont proches[debut[d]] à proches[debut[d + 1] - 1] */
+    uint32_t* lointains;                       /* Rangs des états les plus éloignés, par distance croissante */
+    int premierNiveauLointain;                 /* Les distances premierNiveauLointain à distanceMax sont toutes dans lointains */
+    uint32_t debutLointains[DISTANCE_INFINIE + 1]; /* Comme debutProches, à partir de premierNiveauLointain */
+} Niveaux;
+
+/**
+ * @struct Distances
+ * @brief Distances en nombre d'ordres entre les positions du deck, pour tirer des objectifs
+ *        d'une difficulté donnée. Les ordres déplacent des cases sans regarder les animaux : la
+ *        distance de a à b est celle de l'état canonique de la hauteur de a à b renuméroté par
+ *        la permutation de a. Un parcours par hauteur suffit donc, calculé une fois pour toutes
+ */
+typedef struct {
+    int nbAnimaux;
+    uint32_t nbEtats;                      /* nbEtatsPossibles(nbAnimaux) */
+    const Noyau* noyau;                    /* Noyau du nombre d'animaux */
+    Niveaux niveaux[MAX_ANIMAUX + 1];      /* Un parcours par hauteur du podium bleu */
+    uint32_t* positionDeRang;              /* Indice dans le deck de chaque rang d'état */
+} Distances;
+
+
+
+/**
+ * @brief Calcule les parcours de toutes les hauteurs et l'index des positions du deck, sur
+ *        plusieurs fils. Les distances sont celles du solveur : tous les ordres de la
+ *        configuration comptent, y compris ceux qui ne peuvent pas être défaits
+ * @param[out] d Les distances à remplir
+ * @param[in] deck Deck complet, déjà passé par calculerComposantes s'il doit l'être : l'index
+ *        suit l'ordre de ses positions, partagées telles quelles par partagerPositions
+ * @param[in] config Configuration qui donne les animaux et les ordres autorisés
+ * @param[in] nbFils Nombre de fils de calcul
+ * @return int 1 si les distances sont prêtes, 0 si le deck n'est pas complet
+ */
+int calculerDistances(Distances* d, const Deck* deck, const ConfigJeu* config, int nbFils);
+
+/**
+ * @brief Libère les tables
+ * @param[in,out] d Les distances
+ */
+void libererDistances(Distances* d);
+
+/**
+ * @brief Tire uniformément une carte non encore jouée dont la plus courte solution depuis une
+ *        position fait entre distanceMin et distanceMax ordres. Des états de la bande sont
+ *        d'abord essayés au hasard, dans sa liste si elle ne contient que des états proches ou
+ *        que des états lointains, sinon dans toute la table ; si aucun n'a de carte libre, les
+ *        cartes libres de la bande sont comptées et celle d'un rang tiré au hasard est prise.
+ *        Peut être appelée en même temps depuis plusieurs fils sur le même deck
+ * @param[in] d Les distances calculées sur les positions du deck
+ * @param[in,out] deck Le paquet de cartes
+ * @param[in,out] alea Le générateur
+ * @param[in] config La configuration
+ * @param[in] depuis Position du deck d'où partent les joueurs
+ * @param[in] distanceMin Plus petite longueur de solution acceptée
+ * @param[in] distanceMax Plus grande longueur de solution acceptée
+ * @return EtatJeu* La carte réservée, ou NULL si aucune carte libre n'a été trouvée dans la bande
+ */
+EtatJeu* tirerCarteDifficulte(const Distances* d, Deck* deck, Alea* alea, const ConfigJeu* config,
+                              const EtatJeu* depuis, int distanceMin, int distanceMax);
@@ -0,0 +1,230 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "effets.h"
+#include "etatcompact.h"
+#include "soumission.h"
+#include "sondes.h"
+#include "memoire.h"
+
+_Static_assert(EFFETS_ORDRES_MAX >= LEN_CMD / 2, "Une ligne saisie doit tenir dans une cle");
+_Static_assert(EFFETS_ORDRES_MAX <= 255 && MAX_ANIMAUX <= 255, "Les longueurs sont rangees sur un octet");
+
+
+/**
+ * @brief Prépare un cache
+ * @param[out] cache Le cache
+ * @param[in] capacite Nombre d'effets
+ */
+void initCacheEffets(CacheEffets* cache, int capacite) {
+    int nb = 1;
+    while (nb * EFFETS_VOIES < capacite) nb *= 2;
+
+    cache->nbEnsembles = nb;
+    cache->ensembles = (EnsembleEffets*)allouerMemZero(MEM_ESSAIS, (size_t)nb, sizeof(EnsembleEffets));
+    if (cache->ensembles == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le cache des effets.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nb; i++) mtx_init(&cache->ensembles[i].verrou, mtx_plain);
+    atomic_init(&cache->succes, 0);
+    atomic_init(&cache->echecs, 0);
+}
+
+/**
+ * @brief Libère le cache
+ * @param[in,out] cache Le cache
+ */
+void libererCacheEffets(CacheEffets* cache) {
+    for (int i = 0; i < cache->nbEnsembles; i++) mtx_destroy(&cache->ensembles[i].verrou);
+    libererMem(cache->ensembles);
+    cache->ensembles = NULL;
+    cache->nbEnsembles = 0;
+}
+
+/**
+ * @brief Remplit la clé d'une séquence de longueur paire : hauteur, nombre d'animaux et codes
+ *        des ordres jusqu'au premier inconnu compris, puis son hachage FNV-1a (jamais nul)
+ * @param[out] e L'effet dont la clé est remplie
+ * @param[in] hauteur Hauteur du bleu au départ
+ * @param[in] nbAnimaux Nombre d'animaux
+ * @param[in] config La configuration, ou NULL
+ * @param[in] sequence La séquence
+ */
+static void coderCle(EffetSequence* e, int hauteur, int nbAnimaux, const ConfigJeu* config, const char* sequence) {
+    e->hauteurDepart = (uint8_t)hauteur;
+    e->nbAnimaux = (uint8_t)nbAnimaux;
+
+    uint64_t empreinte = 0xCBF29CE484222325ULL;
+    empreinte = (empreinte ^ e->hauteurDepart) * 0x100000001B3ULL;
+    empreinte = (empreinte ^ e->nbAnimaux) * 0x100000001B3ULL;
+
+    int nb = 0;
+    for (const char* c = sequence; c[0] != '\0' && nb < EFFETS_ORDRES_MAX; c += 2) {
+        uint8_t code = (uint8_t)codeCommande(c, config);
+        e->ordres[nb++] = code;
+        empreinte = (empreinte ^ code) * 0x100000001B3ULL;
+        if (code == 0) break;
+    }
+    e->nbOrdres = (uint8_t)nb;
+    e->empreinte = empreinte | 1;
+}
+
+/**
+ * @brief Indique si une voie porte la clé d'un effet
+ */
+static int memeCle(const EffetSequence* voie, const EffetSequence* cle) {
+    return voie->empreinte == cle->empreinte && voie->hauteurDepart == cle->hauteurDepart &&
+           voie->nbAnimaux == cle->nbAnimaux && voie->nbOrdres == cle->nbOrdres &&
+           memcmp(voie->ordres, cle->ordres, cle->nbOrdres) == 0;
+}
+
+/**
+ * @brief Calcule l'effet d'une clé en exécutant ses codes sur des cases numérotées
+ * @param[in,out] e L'effet, dont la clé est remplie
+ * @param[in] config La configuration, ou NULL
+ * @param[in] sequence NULL pour lire les codes de la clé, sinon la séquence dont ils sont lus
+ *            un à un, quand elle est trop longue pour une clé
+ */
+static void calculerEffet(EffetSequence* e, const ConfigJeu* config, const char* sequence) {
+    EtatCompact c;
+    c.nb = e->nbAnimaux;
+    c.hauteur = e->hauteurDepart;
+    for (int i = 0; i < c.nb; i++) c.animaux[i] = (uint8_t)i;
+
+    int nb = (sequence == NULL) ? e->nbOrdres : (int)(strlen(sequence) / 2);
+    e->codeRetour = 1;
+    e->nbExecutes = nb;
+    for (int i = 0; i < nb; i++) {
+        int code = (sequence == NULL) ? e->ordres[i] : codeCommande(sequence + 2 * i, config);
+        if (code == 0) {
+            e->codeRetour = -1;
+            e->nbExecutes = i;
+            break;
+        }
+
+        int res;
+        if (code <= NB_ORDRES_CONNUS) res = appliquerOrdre(&c, code - 1);
+        else res = appliquerMacro(&c, &config->macros[code - 1 - NB_ORDRES_CONNUS]);
+        if (!res) {
+            e->codeRetour = 0;
+            e->nbExecutes = i;
+            break;
+        }
+    }
+    e->hauteur = c.hauteur;
+    memcpy(e->origine, c.animaux, c.nb);
+}
+
+/**
+ * @brief Cherche l'effet d'une clé, ou le calcule et le range à la place de la voie suivante
+ * @param[in,out] cache Le cache
+ * @param[in,out] e La clé, complétée par son effet
+ * @param[in] config La configuration, ou NULL
+ */
+static void trouverEffet(CacheEffets* cache, EffetSequence* e, const ConfigJeu* config) {
+    EnsembleEffets* ens = &cache->ensembles[e->empreinte & (uint64_t)(cache->nbEnsembles - 1)];
+
+    mtx_lock(&ens->verrou);
+    for (int v = 0; v < EFFETS_VOIES; v++) {
+        if (memeCle(&ens->voies[v], e)) {
+            *e = ens->voies[v];
+            mtx_unlock(&ens->verrou);
+            atomic_fetch_add_explicit(&cache->succes, 1, memory_order_relaxed);
+            return;
+        }
+    }
+    mtx_unlock(&ens->verrou);
+
+    /* Calculé hors du verrou : deux juges peuvent calculer la même clé, le second écrase le premier */
+    calculerEffet(e, config, NULL);
+    atomic_fetch_add_explicit(&cache->echecs, 1, memory_order_relaxed);
+
+    mtx_lock(&ens->verrou);
+    int v;
+    for (v = 0; v < EFFETS_VOIES && !memeCle(&ens->voies[v], e); v++);
+    if (v == EFFETS_VOIES) {
+        v = ens->prochaine;
+        ens->prochaine = (v + 1) % EFFETS_VOIES;
+    }
+    ens->voies[v] = *e;
+    mtx_unlock(&ens->verrou);
+}
+
+/**
+ * @brief Effet d'une séquence
+ * @param[in,out] cache Le cache ou NULL
+ * @param[in] hauteur Hauteur du bleu
+ * @param[in] nbAnimaux Nombre d'animaux
+ * @param[in] config Configuration ou NULL
+ * @param[in] sequence Séquence
+ * @param[out] e L'effet
+ * @return int Retour de l'exécution
+ */
+int effetSequence(CacheEffets* cache, int hauteur, int nbAnimaux, const ConfigJeu* config, const char* sequence,
+                  EffetSequence* e) {
+    /* Même code de retour qu'un mouvement impossible, sans consulter le cache */
+    if (strlen(sequence) % 2 != 0) {
+        memset(e, 0, sizeof(EffetSequence));
+        return 0;
+    }
+
+    /* Trop longue pour une clé : exécutée en entier, sans être rangée */
+    if (strlen(sequence) / 2 > EFFETS_ORDRES_MAX) {
+        memset(e, 0, sizeof(EffetSequence));
+        e->hauteurDepart = (uint8_t)hauteur;
+        e->nbAnimaux = (uint8_t)nbAnimaux;
+        calculerEffet(e, config, sequence);
+        return e->codeRetour;
+    }
+
+    coderCle(e, hauteur, nbAnimaux, config, sequence);
+    if (cache == NULL) calculerEffet(e, config, NULL);
+    else trouverEffet(cache, e, config);
+    return e->codeRetour;
+}
+
+/**
+ * @brief Juge une séquence par son effet
+ * @param[in,out] cache Le cache ou NULL
+ * @param[in] courant Départ
+ * @param[in] objectif Objectif
+ * @param[in] config Configuration ou NULL
+ * @param[in] sequence Séquence
+ * @param[out] bonneSolution 1 si gagnante
+ * @return int Retour de l'exécution
+ */
+int jugerParEffet(CacheEffets* cache, const EtatJeu* courant, const EtatJeu* objectif, const ConfigJeu* config,
+                  const char* sequence, int* bonneSolution) {
+    *bonneSolution = 0;
+    int h = taillePile(&courant->podiumBleu);
+
+    unsigned long long sonde = debutSonde();
+    EffetSequence e;
+    effetSequence(cache, h, h + taillePile(&courant->podiumRouge), config, sequence, &e);
+    finSonde(SONDE_EXECUTION, sonde);
+
+    compterSonde(COMPTEUR_ORDRES, e.nbExecutes);
+    if (e.codeRetour == -1) compterSonde(COMPTEUR_ORDRE_INCONNU, 1);
+    else if (e.codeRetour == 0) compterSonde(COMPTEUR_MOUVEMENT_IMPOSSIBLE, 1);
+
+    if (e.codeRetour == 1) {
+        sonde = debutSonde();
+        *bonneSolution = estMemeEtatApresEffet(courant, e.hauteur, e.origine, objectif);
+        finSonde(SONDE_COMPARAISON, sonde);
+    }
+    return e.codeRetour;
+}
+
+/**
+ * @brief Écrit le taux de succès du cache
+ * @param[in] cache Le cache
+ * @param[in,out] sortie Le flux
+ */
+void ecrireCacheEffets(const CacheEffets* cache, FILE* sortie) {
+    long long succes = atomic_load(&cache->succes);
+    long long total = succes + atomic_load(&cache->echecs);
+    fprintf(sortie, "Cache d'effets : %lld consultations, %.1f %% trouvees (%d effets au plus)\n", total,
+            total > 0 ? 100.0 * (double)succes / (double)total : 0.0, cache->nbEnsembles * EFFETS_VOIES);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <threads.h>
+#include "jeu.h"
+
+/**
+ * @def EFFETS_CAPACITE
+ * @brief Nombre d'effets gardés par défaut
+ */
+#define EFFETS_CAPACITE 4096
+
+/**
+ * @def EFFETS_VOIES
+ * @brief Effets par ensemble : une clé ne peut être rangée que dans les voies de son ensemble
+ */
+#define EFFETS_VOIES 4
+
+/**
+ * @def EFFETS_ORDRES_MAX
+ * @brief Longueur maximale d'une clé : toute ligne de LEN_CMD caractères y tient (vérifié dans
+ *        effets.c). L'effet d'une séquence plus longue est calculé sans passer par le cache
+ */
+#define EFFETS_ORDRES_MAX 128
+
+
+/**
+ * @struct EffetSequence
+ * @brief Ce que fait une séquence depuis une hauteur du podium bleu, quels que soient les
+ *        animaux : la case i de l'arrivée reçoit l'animal de la case origine[i] du départ
+ *        (cases d'EtatCompact). La clé est la hauteur de départ et les codes des ordres, coupés
+ *        après le premier ordre inconnu puisque l'exécution s'y arrête
+ */
+typedef struct {
+    uint64_t empreinte;                   /* Hachage de la clé, 0 pour une voie libre */
+    int nbExecutes;                       /* Ordres exécutés avant l'arrêt, pour les sondes */
+    uint8_t hauteurDepart;
+    uint8_t nbAnimaux;
+    uint8_t nbOrdres;                     /* 0 pour une séquence trop longue, calculée hors du cache */
+    int8_t codeRetour;                    /* Comme executerSequence : 1, 0 ou -1 */
+    uint8_t hauteur;                      /* Hauteur du bleu à l'arrivée, si codeRetour vaut 1 */
+    uint8_t origine[MAX_ANIMAUX];
+    uint8_t ordres[EFFETS_ORDRES_MAX];    /* Codes de codeCommande */
+} EffetSequence;
+
+/**
+ * @struct EnsembleEffets
+ * @brief Voies d'un ensemble et leur verrou, remplacées à tour de rôle
+ */
+typedef struct {
+    mtx_t verrou;
+    int prochaine;                        /* Voie remplacée par la prochaine insertion */
+    EffetSequence voies[EFFETS_VOIES];
+} EnsembleEffets;
+
+/**
+ * @struct CacheEffets
+ * @brief Cache borné des effets de séquences, partagé par les juges de toutes les parties.
+ *        Une séquence déjà vue depuis la même hauteur est vérifiée en O(n) sans être
+ *        exécutée ni copier le départ
+ */
+typedef struct {
+    EnsembleEffets* ensembles;
+    int nbEnsembles;                      /* Puissance de 2 */
+    atomic_llong succes;                  /* Effets trouvés */
+    atomic_llong echecs;                  /* Effets calculés puis rangés */
+} CacheEffets;
+
+
+
+/**
+ * @brief Alloue un cache vide
+ * @param[out] cache Le cache
+ * @param[in] capacite Nombre d'effets gardés au plus, arrondi à une puissance de 2
+ */
+void initCacheEffets(CacheEffets* cache, int capacite);
+
+/**
+ * @brief Libère le cache
+ * @param[in,out] cache Le cache
+ */
+void libererCacheEffets(CacheEffets* cache);
+
+/**
+ * @brief Effet d'une séquence depuis une hauteur, lu dans le cache ou calculé sur des cases
+ *        numérotées puis rangé. Une séquence de longueur impaire ne passe pas par le cache, une
+ *        séquence de plus de EFFETS_ORDRES_MAX ordres est calculée sans être rangée
+ * @param[in,out] cache Le cache, ou NULL pour calculer l'effet sans le ranger
+ * @param[in] hauteur Hauteur du podium bleu au départ
+ * @param[in] nbAnimaux Nombre d'animaux
+ * @param[in] config La configuration, ou NULL
+ * @param[in] sequence La séquence saisie
+ * @param[out] e L'effet, dont hauteur et origine ne valent que si le retour est 1
+ * @return int Le retour qu'aurait donné executerSequenceConfig
+ */
+int effetSequence(CacheEffets* cache, int hauteur, int nbAnimaux, const ConfigJeu* config, const char* sequence,
+                  EffetSequence* e);
+
+/**
+ * @brief Juge une séquence sans l'exécuter sur les piles : son effet est comparé à l'objectif
+ * @param[in,out] cache Le cache, ou NULL pour calculer l'effet sans le ranger
+ * @param[in] courant État de départ
+ * @param[in] objectif État à atteindre
+ * @param[in] config La configuration, ou NULL
+ * @param[in] sequence La séquence saisie
+ * @param[out] bonneSolution 1 si la séquence mène à l'objectif
+ * @return int Le retour qu'aurait donné executerSequenceConfig
+ */
+int jugerParEffet(CacheEffets* cache, const EtatJeu* courant, const EtatJeu* objectif, const ConfigJeu* config,
+                  const char* sequence, int* bonneSolution);
+
+/**
+ * @brief Écrit le nombre de consultations et la part trouvée dans le cache
+ * @param[in] cache Le cache
+ * @param[in,out] sortie Le flux
+ */
+void ecrireCacheEffets(const CacheEffets* cache, FILE* sortie);
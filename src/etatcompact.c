@@ -0,0 +1,311 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "etatcompact.h"
+
+
+const char* const NOMS_ORDRES[NB_ORDRES_CONNUS] = { "KI", "LO", "SO", "NI", "MA" };
+
+/**
+ * @brief Code d'un ordre
+ * @param[in] deuxLettres Les deux lettres
+ * @return int Le code ou -1
+ */
+int codeOrdre(const char* deuxLettres) {
+    for (int i = 0; i < NB_ORDRES_CONNUS; i++) {
+        if (deuxLettres[0] == NOMS_ORDRES[i][0] && deuxLettres[1] == NOMS_ORDRES[i][1]) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Indice d'un animal dans la configuration (comparaison de pointeurs d'abord)
+ */
+static int indiceAnimal(const ConfigJeu* config, const char* nom) {
+    for (int i = 0; i < config->nbAnimaux; i++) {
+        if (config->nomsAnimaux[i] == nom) return i;
+    }
+    for (int i = 0; i < config->nbAnimaux; i++) {
+        if (strcmp(config->nomsAnimaux[i], nom) == 0) return i;
+    }
+    return 0;
+}
+
+/**
+ * @brief Convertit un état en état compact
+ * @param[in] config La configuration
+ * @param[in] e L'état
+ * @param[out] c L'état compact
+ */
+void compacterEtat(const ConfigJeu* config, const EtatJeu* e, EtatCompact* c) {
+    int h = taillePile(&e->podiumBleu);
+    c->hauteur = (uint8_t)h;
+    c->nb = (uint8_t)(h + taillePile(&e->podiumRouge));
+
+    /* Le sommet bleu est la dernière case du bleu */
+    int k = h - 1;
+    for (Cellule* cel = e->podiumBleu.tete; cel != NULL; cel = cel->suivant) {
+        c->animaux[k--] = (uint8_t)indiceAnimal(config, cel->valeur);
+    }
+    /* Le sommet rouge est la première case du rouge */
+    k = h;
+    for (Cellule* cel = e->podiumRouge.tete; cel != NULL; cel = cel->suivant) {
+        c->animaux[k++] = (uint8_t)indiceAnimal(config, cel->valeur);
+    }
+}
+
+/**
+ * @brief Reconstruit les piles d'un état compact
+ * @param[in] config La configuration
+ * @param[in] c L'état compact
+ * @param[in,out] e L'état
+ */
+void developperEtat(const ConfigJeu* config, const EtatCompact* c, EtatJeu* e) {
+    libererEtat(e);
+    initEtat(e);
+
+    for (int i = 0; i < c->hauteur; i++) {
+        empiler(&e->podiumBleu, config->nomsAnimaux[c->animaux[i]]);
+    }
+    for (int i = c->nb - 1; i >= c->hauteur; i--) {
+        empiler(&e->podiumRouge, config->nomsAnimaux[c->animaux[i]]);
+    }
+}
+
+/**
+ * @brief Nombre d'états pour n animaux
+ * @param[in] n Nombre d'animaux
+ * @return uint32_t n! * (n + 1)
+ */
+uint32_t nbEtatsPossibles(int n) {
+    uint32_t f = 1;
+    for (int i = 2; i <= n; i++) f *= (uint32_t)i;
+    return f * (uint32_t)(n + 1);
+}
+
+/**
+ * @brief Rang d'un état : code de Lehmer de la permutation, puis hauteur
+ * @param[in] c L'état compact
+ * @return uint32_t Le rang
+ */
+uint32_t rangEtat(const EtatCompact* c) {
+    int n = c->nb;
+    uint32_t rang = 0;
+
+    for (int i = 0; i < n; i++) {
+        uint32_t plusPetits = 0;
+        for (int j = i + 1; j < n; j++) {
+            if (c->animaux[j] < c->animaux[i]) plusPetits++;
+        }
+        rang = rang * (uint32_t)(n - i) + plusPetits;
+    }
+    return rang * (uint32_t)(n + 1) + c->hauteur;
+}
+
+/**
+ * @brief État d'un rang donné
+ * @param[in] rang Le rang
+ * @param[in] n Nombre d'animaux
+ * @param[out] c L'état compact
+ */
+void etatDeRang(uint32_t rang, int n, EtatCompact* c) {
+    c->nb = (uint8_t)n;
+    c->hauteur = (uint8_t)(rang % (uint32_t)(n + 1));
+    rang /= (uint32_t)(n + 1);
+
+    /* Chiffres du code de Lehmer, du dernier au premier */
+    int chiffres[MAX_ANIMAUX];
+    for (int i = n - 1; i >= 0; i--) {
+        chiffres[i] = (int)(rang % (uint32_t)(n - i));
+        rang /= (uint32_t)(n - i);
+    }
+
+    int libres[MAX_ANIMAUX];
+    for (int i = 0; i < n; i++) libres[i] = i;
+    int nbLibres = n;
+    for (int i = 0; i < n; i++) {
+        int k = chiffres[i];
+        c->animaux[i] = (uint8_t)libres[k];
+        for (int j = k; j < nbLibres - 1; j++) libres[j] = libres[j + 1];
+        nbLibres--;
+    }
+}
+
+/**
+ * @brief Compare deux états compacts
+ * @param[in] a Premier état
+ * @param[in] b Deuxième état
+ * @return int 1 si identiques
+ */
+int estMemeEtatCompact(const EtatCompact* a, const EtatCompact* b) {
+    return a->nb == b->nb && a->hauteur == b->hauteur && memcmp(a->animaux, b->animaux, a->nb) == 0;
+}
+
+/**
+ * @brief Applique un ordre
+ * @param[in,out] c L'état compact
+ * @param[in] ordre Code de l'ordre
+ * @return int 1 si effectué, 0 si impossible
+ */
+int appliquerOrdre(EtatCompact* c, int ordre) {
+    int h = c->hauteur;
+    int n = c->nb;
+    uint8_t tmp;
+
+    switch (ordre) {
+    case ORDRE_KI:
+        if (h == 0) return 0;
+        c->hauteur--;
+        return 1;
+    case ORDRE_LO:
+        if (h == n) return 0;
+        c->hauteur++;
+        return 1;
+    case ORDRE_SO:
+        if (h == 0 || h == n) return 0;
+        tmp = c->animaux[h - 1];
+        c->animaux[h - 1] = c->animaux[h];
+        c->animaux[h] = tmp;
+        return 1;
+    case ORDRE_NI:
+        if (h == 0) return 0;
+        tmp = c->animaux[0];
+        memmove(c->animaux, c->animaux + 1, (size_t)(h - 1));
+        c->animaux[h - 1] = tmp;
+        return 1;
+    case ORDRE_MA:
+        if (h == n) return 0;
+        tmp = c->animaux[n - 1];
+        memmove(c->animaux + h + 1, c->animaux + h, (size_t)(n - 1 - h));
+        c->animaux[h] = tmp;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Défait un ordre
+ * @param[in,out] c L'état compact
+ * @param[in] ordre Code de l'ordre
+ */
+void annulerOrdre(EtatCompact* c, int ordre) {
+    int h = c->hauteur;
+    int n = c->nb;
+    uint8_t tmp;
+
+    switch (ordre) {
+    case ORDRE_KI:
+        c->hauteur++;
+        break;
+    case ORDRE_LO:
+        c->hauteur--;
+        break;
+    case ORDRE_SO:
+        appliquerOrdre(c, ORDRE_SO);
+        break;
+    case ORDRE_NI:
+        tmp = c->animaux[h - 1];
+        memmove(c->animaux + 1, c->animaux, (size_t)(h - 1));
+        c->animaux[0] = tmp;
+        break;
+    case ORDRE_MA:
+        tmp = c->animaux[h];
+        memmove(c->animaux + h, c->animaux + h + 1, (size_t)(n - 1 - h));
+        c->animaux[n - 1] = tmp;
+        break;
+    }
+}
+
+/**
+ * @brief Exécute une séquence sur un état compact
+ * @param[in,out] c L'état compact
+ * @param[in] seq La séquence
+ * @return int 1 si OK, 0 si mouvement impossible, -1 si ordre inconnu
+ */
+int executerSequenceCompacte(EtatCompact* c, const char* seq) {
+    size_t len = strlen(seq);
+
+    if (len % 2 != 0) return 0;
+
+    for (size_t i = 0; i < len; i += 2) {
+        int ordre = codeOrdre(seq + i);
+        if (ordre < 0) return -1;
+        if (!appliquerOrdre(c, ordre)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Exécute une séquence d'ordres et de macros sur un état compact
+ * @param[in,out] c L'état compact
+ * @param[in] seq La séquence
+ * @param[in] config La configuration compilée, ou NULL
+ * @return int 1 si OK, 0 si mouvement impossible, -1 si ordre inconnu
+ */
+int executerSequenceCompacteConfig(EtatCompact* c, const char* seq, const ConfigJeu* config) {
+    if (config == NULL || config->nbMacros == 0) return executerSequenceCompacte(c, seq);
+
+    size_t len = strlen(seq);
+    if (len % 2 != 0) return 0;
+
+    for (size_t i = 0; i < len; i += 2) {
+        int indice = indiceCodeOrdre(seq + i);
+        int code = (indice < 0) ? 0 : config->codes[indice];
+        if (code == 0) return -1;
+
+        int res;
+        if (code <= NB_ORDRES_CONNUS) res = appliquerOrdre(c, code - 1);
+        else res = appliquerMacro(c, &config->macros[code - 1 - NB_ORDRES_CONNUS]);
+        if (!res) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Applique une macro
+ * @param[in,out] c L'état compact
+ * @param[in] m La macro
+ * @return int 1 si appliquée, 0 si impossible
+ */
+int appliquerMacro(EtatCompact* c, const Macro* m) {
+    int h = c->hauteur;
+    if (!m->possible[h]) return 0;
+
+    uint8_t avant[MAX_ANIMAUX];
+    memcpy(avant, c->animaux, c->nb);
+    for (int i = 0; i < c->nb; i++) c->animaux[i] = avant[m->origine[h][i]];
+    c->hauteur = m->hauteur[h];
+    return 1;
+}
+
+/**
+ * @brief Compile les macros
+ * @param[in,out] config La configuration
+ */
+void compilerMacros(ConfigJeu* config) {
+    int n = config->nbAnimaux;
+
+    memset(config->codes, 0, sizeof(config->codes));
+    for (int k = 0; k < NB_ORDRES_CONNUS; k++) config->codes[indiceCodeOrdre(NOMS_ORDRES[k])] = (uint8_t)(1 + k);
+
+    for (int m = 0; m < config->nbMacros; m++) {
+        Macro* macro = &config->macros[m];
+        memset(macro->possible, 0, sizeof(macro->possible));
+
+        for (int h = 0; h <= n; h++) {
+            /* L'état canonique donne directement la case de départ de chaque case d'arrivée */
+            EtatCompact c;
+            c.nb = (uint8_t)n;
+            c.hauteur = (uint8_t)h;
+            for (int i = 0; i < n; i++) c.animaux[i] = (uint8_t)i;
+
+            if (executerSequenceCompacteConfig(&c, macro->expansion, config) != 1) continue;
+            macro->possible[h] = 1;
+            macro->hauteur[h] = c.hauteur;
+            memcpy(macro->origine[h], c.animaux, (size_t)n);
+        }
+        config->codes[indiceCodeOrdre(macro->nom)] = (uint8_t)(1 + NB_ORDRES_CONNUS + m);
+    }
+}
\ No newline at end of file
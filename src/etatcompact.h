@@ -0,0 +1,137 @@
+#pragma once
+
+#include <stdint.h>
+#include "jeu.h"
+
+/**
+ * @def NB_ORDRES_CONNUS
+ * @brief Nombre d'ordres de base (KI, LO, SO, NI, MA)
+ */
+#define NB_ORDRES_CONNUS 5
+
+/* Codes des ordres de base, dans l'ordre de NOMS_ORDRES */
+#define ORDRE_KI 0
+#define ORDRE_LO 1
+#define ORDRE_SO 2
+#define ORDRE_NI 3
+#define ORDRE_MA 4
+
+/**
+ * @brief Noms des ordres de base, indexés par leur code
+ */
+extern const char* const NOMS_ORDRES[NB_ORDRES_CONNUS];
+
+/**
+ * @struct EtatCompact
+ * @brief État du jeu sous forme de tableau d'indices d'animaux. Les cases 0 à hauteur-1 forment
+ *        le podium bleu du bas vers le haut, les cases hauteur à nb-1 le podium rouge du haut
+ *        vers le bas. KI et LO ne font alors que déplacer la coupure
+ */
+typedef struct {
+    uint8_t animaux[MAX_ANIMAUX];  /* Indices des animaux dans ConfigJeu.nomsAnimaux */
+    uint8_t hauteur;               /* Hauteur du podium bleu */
+    uint8_t nb;                    /* Nombre d'animaux */
+} EtatCompact;
+
+
+
+/**
+ * @brief Renvoie le code d'un ordre écrit sur deux lettres
+ * @param[in] deuxLettres Pointeur vers les deux lettres de l'ordre
+ * @return int Le code de l'ordre, ou -1 s'il est inconnu
+ */
+int codeOrdre(const char* deuxLettres);
+
+/**
+ * @brief Convertit un état à base de piles en état compact
+ * @param[in] config Configuration qui donne l'indice de chaque animal
+ * @param[in] e État à convertir
+ * @param[out] c État compact obtenu
+ */
+void compacterEtat(const ConfigJeu* config, const EtatJeu* e, EtatCompact* c);
+
+/**
+ * @brief Reconstruit les piles d'un état compact
+ * @param[in] config Configuration qui donne le nom de chaque animal
+ * @param[in] c État compact
+ * @param[in,out] e État dont les piles sont remplacées
+ */
+void developperEtat(const ConfigJeu* config, const EtatCompact* c, EtatJeu* e);
+
+/**
+ * @brief Nombre d'états possibles pour n animaux : n! * (n + 1)
+ * @param[in] n Nombre d'animaux
+ * @return uint32_t Le nombre d'états
+ */
+uint32_t nbEtatsPossibles(int n);
+
+/**
+ * @brief Numérote un état de 0 à nbEtatsPossibles(nb) - 1
+ * @param[in] c État compact
+ * @return uint32_t Son rang
+ */
+uint32_t rangEtat(const EtatCompact* c);
+
+/**
+ * @brief Retrouve l'état d'un rang donné
+ * @param[in] rang Rang de l'état
+ * @param[in] n Nombre d'animaux
+ * @param[out] c État compact obtenu
+ */
+void etatDeRang(uint32_t rang, int n, EtatCompact* c);
+
+/**
+ * @brief Compare deux états compacts
+ * @param[in] a Premier état
+ * @param[in] b Deuxième état
+ * @return int 1 si identiques, 0 sinon
+ */
+int estMemeEtatCompact(const EtatCompact* a, const EtatCompact* b);
+
+/**
+ * @brief Applique un ordre de base
+ * @param[in,out] c État compact
+ * @param[in] ordre Code de l'ordre
+ * @return int 1 si le mouvement a été effectué, 0 si c'est impossible
+ */
+int appliquerOrdre(EtatCompact* c, int ordre);
+
+/**
+ * @brief Défait un ordre de base appliqué avec succès
+ * @param[in,out] c État compact
+ * @param[in] ordre Code de l'ordre à défaire
+ */
+void annulerOrdre(EtatCompact* c, int ordre);
+
+/**
+ * @brief Équivalent de executerSequence sur un état compact
+ * @param[in,out] c État compact modifié en place
+ * @param[in] seq Séquence d'ordres
+ * @return int 1 si OK, 0 si mouvement impossible, -1 si ordre inconnu
+ */
+int executerSequenceCompacte(EtatCompact* c, const char* seq);
+
+/**
+ * @brief Équivalent de executerSequenceConfig sur un état compact
+ * @param[in,out] c État compact modifié en place
+ * @param[in] seq Séquence d'ordres et de macros
+ * @param[in] config Configuration passée par compilerMacros, ou NULL pour les seuls ordres de base
+ * @return int 1 si OK, 0 si mouvement impossible, -1 si ordre inconnu
+ */
+int executerSequenceCompacteConfig(EtatCompact* c, const char* seq, const ConfigJeu* config);
+
+/**
+ * @brief Applique l'effet compilé d'une macro
+ * @param[in,out] c État compact
+ * @param[in] m Macro compilée
+ * @return int 1 si la macro a été appliquée, 0 si elle est impossible depuis cette hauteur
+ */
+int appliquerMacro(EtatCompact* c, const Macro* m);
+
+/**
+ * @brief Compile les macros d'une configuration validée : chaque suite est jouée une fois par
+ *        hauteur de départ sur l'état canonique, dans l'ordre des macros pour que chacune puisse
+ *        utiliser les précédentes, et la table des codes est remplie
+ * @param[in,out] config Configuration validée
+ */
+void compilerMacros(ConfigJeu* config);
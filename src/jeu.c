@@ -5,6 +5,9 @@
 #include <string.h>
 #include <time.h>
 #include "jeu.h"
+#include "etatcompact.h"
+#include "sondes.h"
+#include "memoire.h"
 
 
  /**
@@ -180,35 +183,173 @@ int commandeMA(EtatJeu* e) {
     return rotationBasVersHaut(&e->podiumRouge);
 }
 
+/**
+ * @def CODE
+ * @brief Case d'un nom d'ordre de deux lettres majuscules dans une table de codes
+ */
+#define CODE(a, b) (((a) - 'A') * 26 + ((b) - 'A'))
+
+/**
+ * @brief Codes des seuls ordres de base, comme ConfigJeu.codes sans macro
+ */
+static const uint8_t CODES_DE_BASE[CODES_ORDRES] = {
+    [CODE('K', 'I')] = 1 + ORDRE_KI,
+    [CODE('L', 'O')] = 1 + ORDRE_LO,
+    [CODE('S', 'O')] = 1 + ORDRE_SO,
+    [CODE('N', 'I')] = 1 + ORDRE_NI,
+    [CODE('M', 'A')] = 1 + ORDRE_MA,
+};
+
+/**
+ * @brief Commandes des ordres de base, indexées par leur code
+ */
+static int (*const COMMANDES[NB_ORDRES_CONNUS])(EtatJeu*) = {
+    commandeKI, commandeLO, commandeSO, commandeNI, commandeMA
+};
+
+/**
+ * @brief Case d'un nom d'ordre
+ * @param[in] deuxLettres Les deux lettres
+ * @return int L'indice ou -1
+ */
+int indiceCodeOrdre(const char* deuxLettres) {
+    if (deuxLettres[0] < 'A' || deuxLettres[0] > 'Z' || deuxLettres[1] < 'A' || deuxLettres[1] > 'Z') return -1;
+    return CODE(deuxLettres[0], deuxLettres[1]);
+}
+
+/**
+ * @brief Code d'un ordre
+ * @param[in] deuxLettres Les deux lettres
+ * @param[in] config La configuration, ou NULL
+ * @return int Le code, 0 si inconnu
+ */
+int codeCommande(const char* deuxLettres, const ConfigJeu* config) {
+    int indice = indiceCodeOrdre(deuxLettres);
+    if (indice < 0) return 0;
+    return (config != NULL && config->nbMacros > 0) ? config->codes[indice] : CODES_DE_BASE[indice];
+}
+
+/**
+ * @brief Applique l'effet compilé d'une macro en raccrochant les cellules des deux podiums,
+ *        sans allocation
+ * @param[in,out] e État du jeu
+ * @param[in] m La macro
+ * @return int 1 si succès, 0 si la macro est impossible depuis cette hauteur
+ */
+static int commandeMacro(EtatJeu* e, const Macro* m) {
+    int h = taillePile(&e->podiumBleu);
+    int n = h + taillePile(&e->podiumRouge);
+    if (n > MAX_ANIMAUX || !m->possible[h]) return 0;
+
+    /* Mêmes cases que EtatCompact : bleu du bas vers le haut, puis rouge du haut vers le bas */
+    Cellule* cases[MAX_ANIMAUX];
+    int k = h - 1;
+    for (Cellule* c = e->podiumBleu.tete; c != NULL; c = c->suivant) cases[k--] = c;
+    k = h;
+    for (Cellule* c = e->podiumRouge.tete; c != NULL; c = c->suivant) cases[k++] = c;
+
+    int hauteur = m->hauteur[h];
+    const uint8_t* origine = m->origine[h];
+    Cellule* sous = NULL;
+    for (int i = 0; i < hauteur; i++) {
+        Cellule* c = cases[origine[i]];
+        c->suivant = sous;
+        sous = c;
+    }
+    e->podiumBleu.tete = sous;
+    e->podiumBleu.taille = hauteur;
+
+    sous = NULL;
+    for (int i = n - 1; i >= hauteur; i--) {
+        Cellule* c = cases[origine[i]];
+        c->suivant = sous;
+        sous = c;
+    }
+    e->podiumRouge.tete = sous;
+    e->podiumRouge.taille = n - hauteur;
+    return 1;
+}
+
+/**
+ * @brief Compare l'objectif au départ réarrangé par un effet, sans toucher aux piles
+ * @param[in] depart L'état de départ
+ * @param[in] hauteur Hauteur du bleu après l'effet
+ * @param[in] origine Case de départ de chaque case d'arrivée
+ * @param[in] arrivee L'état attendu
+ * @return int 1 si identiques
+ */
+int estMemeEtatApresEffet(const EtatJeu* depart, int hauteur, const uint8_t* origine, const EtatJeu* arrivee) {
+    int h = taillePile(&depart->podiumBleu);
+    int n = h + taillePile(&depart->podiumRouge);
+    if (n > MAX_ANIMAUX || taillePile(&arrivee->podiumBleu) != hauteur || taillePile(&arrivee->podiumRouge) != n - hauteur) return 0;
+
+    /* Mêmes cases que commandeMacro */
+    const char* cases[MAX_ANIMAUX];
+    int k = h - 1;
+    for (Cellule* c = depart->podiumBleu.tete; c != NULL; c = c->suivant) cases[k--] = c->valeur;
+    k = h;
+    for (Cellule* c = depart->podiumRouge.tete; c != NULL; c = c->suivant) cases[k++] = c->valeur;
+
+    k = hauteur - 1;
+    for (Cellule* c = arrivee->podiumBleu.tete; c != NULL; c = c->suivant, k--) {
+        const char* attendu = cases[origine[k]];
+        if (attendu != c->valeur && strcmp(attendu, c->valeur) != 0) return 0;
+    }
+    k = hauteur;
+    for (Cellule* c = arrivee->podiumRouge.tete; c != NULL; c = c->suivant, k++) {
+        const char* attendu = cases[origine[k]];
+        if (attendu != c->valeur && strcmp(attendu, c->valeur) != 0) return 0;
+    }
+    return 1;
+}
+
 /**
  * @brief Parse et exécute une séquence de commandes 
  * @param[in,out] e État du jeu à modifier
  * @param[in] seq Chaîne de caractères contenant les ordres 
- * @return int 1 si OK, 0 si mouvement impossible, -1 si ordre inconnu
+ * @return int 1 si OK, 0 si mouvement impossible ou longueur impaire, -1 si ordre inconnu
  */
 int executerSequence(EtatJeu* e, const char* seq) {
+    return executerSequenceConfig(e, seq, NULL);
+}
+
+/**
+ * @brief Parse et exécute une séquence d'ordres de base et de macros
+ * @param[in,out] e État du jeu à modifier
+ * @param[in] seq Chaîne de caractères contenant les ordres
+ * @param[in] config Configuration compilée, ou NULL
+ * @return int 1 si OK, 0 si mouvement impossible ou longueur impaire, -1 si ordre inconnu
+ */
+int executerSequenceConfig(EtatJeu* e, const char* seq, const ConfigJeu* config) {
     int len = strlen(seq);
 
-    if (len % 2 != 0) return 0;
+    /* Même code de retour qu'un mouvement impossible */
+    if (len % 2 != 0) {
+        compterSonde(COMPTEUR_MOUVEMENT_IMPOSSIBLE, 1);
+        return 0;
+    }
 
     for (int i = 0; i < len; i += 2) {
-        char cmd[3];
-        cmd[0] = seq[i];
-        cmd[1] = seq[i + 1];
-        cmd[2] = '\0';
+        int code = codeCommande(seq + i, config);
 
-        int res = 0;
+        if (code == 0) {
+            compterSonde(COMPTEUR_ORDRES, i / 2);
+            compterSonde(COMPTEUR_ORDRE_INCONNU, 1);
+            return -1;
+        }
 
-        if (strcmp(cmd, "KI") == 0)      res = commandeKI(e);
-        else if (strcmp(cmd, "LO") == 0) res = commandeLO(e);
-        else if (strcmp(cmd, "SO") == 0) res = commandeSO(e);
-        else if (strcmp(cmd, "NI") == 0) res = commandeNI(e);
-        else if (strcmp(cmd, "MA") == 0) res = commandeMA(e);
-        else return -1; 
+        int res;
+        if (code <= NB_ORDRES_CONNUS) res = COMMANDES[code - 1](e);
+        else res = commandeMacro(e, &config->macros[code - 1 - NB_ORDRES_CONNUS]);
 
-        if (res == 0) return 0; 
+        if (res == 0) {
+            compterSonde(COMPTEUR_ORDRES, i / 2);
+            compterSonde(COMPTEUR_MOUVEMENT_IMPOSSIBLE, 1);
+            return 0;
+        }
     }
 
+    compterSonde(COMPTEUR_ORDRES, len / 2);
     return 1;
 }
 
@@ -247,6 +388,37 @@ static int factorielle(int n) {
     return res;
 }
 
+/**
+ * @brief Nombre de bits à 1 d'un mot
+ */
+static int nbBits(uint64_t x) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+/**
+ * @brief Alloue les marqueurs de cartes tirées puis remet toutes les cartes dans le paquet
+ * @param[in,out] deck Deck dont les positions sont déjà en place
+ */
+static void allouerMarqueurs(Deck* deck) {
+    /* Un bit par carte, les bits au-delà de la dernière carte sont déjà posés */
+    deck->nbMots = (deck->nbPositions + 63) / 64;
+    deck->nbGroupes = (deck->nbMots + 63) / 64;
+    deck->estUtilisee = (_Atomic(uint64_t)*)allouerMem(MEM_DECK, sizeof(uint64_t) * deck->nbMots);
+    deck->motsPleins = (_Atomic(uint64_t)*)allouerMem(MEM_DECK, sizeof(uint64_t) * deck->nbGroupes);
+    deck->libresGroupes = (atomic_int*)allouerMem(MEM_DECK, sizeof(atomic_int) * deck->nbGroupes);
+    if (deck->estUtilisee == NULL || deck->motsPleins == NULL || deck->libresGroupes == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le deck.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    reinitialiserDeck(deck);
+    initAlea(&deck->alea, 0);
+}
+
 /**
  * @brief Génère toutes les positions possibles du jeu grâce à l'algorithme de Heap
  * @param[in] config Configuration contenant les animaux
@@ -257,12 +429,16 @@ void genererToutesPositions(const ConfigJeu* config, Deck* deck) {
     int factN = factorielle(n);
     int capaciteMax = factN * (n + 1);
 
-    deck->positions = (EtatJeu*)malloc(sizeof(EtatJeu) * capaciteMax);
+    deck->positions = (EtatJeu*)allouerMem(MEM_DECK, sizeof(EtatJeu) * capaciteMax);
     if (deck->positions == NULL) {
         fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le deck.\n");
         exit(EXIT_FAILURE);
     }
     deck->nbPositions = 0;
+    deck->possedePositions = 1;
+    deck->nbComposantes = 0;
+    deck->debutComposantes = NULL;
+    int cellules = attribuerCellules(MEM_DECK);
 
     char* A[MAX_ANIMAUX];
     for (int i = 0; i < n; i++) A[i] = config->nomsAnimaux[i];
@@ -293,37 +469,316 @@ void genererToutesPositions(const ConfigJeu* config, Deck* deck) {
         }
     }
 
-    deck->estUtilisee = (int*)calloc(deck->nbPositions, sizeof(int));
+    attribuerCellules(cellules);
+    allouerMarqueurs(deck);
 }
 
 /**
- * @brief Tire une carte objectif aléatoire non encore jouée
- * @param[in,out] deck Le paquet de cartes
- * @return EtatJeu* Pointeur vers l'état cible, ou NULL si le deck est épuisé
+ * @brief Crée un deck qui partage les positions d'un autre
+ * @param[in] modele Le deck d'origine
+ * @param[out] copie Le nouveau deck
  */
-EtatJeu* tirerNouvelleCarte(Deck* deck) {
-    int dispo = 0;
-    /* Compter les cartes restantes */
-    for (int i = 0; i < deck->nbPositions; i++) {
-        if (!deck->estUtilisee[i]) dispo++;
+void partagerPositions(const Deck* modele, Deck* copie) {
+    copie->positions = modele->positions;
+    copie->nbPositions = modele->nbPositions;
+    copie->possedePositions = 0;
+    copie->nbComposantes = modele->nbComposantes;
+    copie->debutComposantes = modele->debutComposantes;
+    allouerMarqueurs(copie);
+}
+
+/**
+ * @brief Pose les marqueurs de toutes les cartes en un passage : mots, mots pleins et compteurs
+ *        des groupes
+ * @param[in,out] deck Le deck
+ * @param[in] utilisees Marqueurs à reprendre, ou NULL pour remettre toutes les cartes
+ */
+static void poserMarqueurs(Deck* deck, const uint64_t* utilisees) {
+    int restantes = 0;
+    for (int g = 0; g < deck->nbGroupes; g++) {
+        /* Les mots au-delà du dernier comptent comme pleins */
+        int debutGroupe = g * 64;
+        uint64_t pleins = debutGroupe + 64 <= deck->nbMots ? 0 : ~0ULL << (deck->nbMots - debutGroupe);
+        int libres = 0;
+
+        for (int m = debutGroupe; m < deck->nbMots && m < debutGroupe + 64; m++) {
+            /* Les bits au-delà de la dernière carte restent posés quoi que dise la sauvegarde */
+            int debut = m * 64;
+            uint64_t mot = debut + 64 <= deck->nbPositions ? 0 : ~0ULL << (deck->nbPositions - debut);
+            if (utilisees != NULL) mot |= utilisees[m];
+            atomic_store(&deck->estUtilisee[m], mot);
+            if (mot == ~0ULL) pleins |= 1ULL << (m % 64);
+            libres += 64 - nbBits(mot);
+        }
+        atomic_store(&deck->motsPleins[g], pleins);
+        atomic_store(&deck->libresGroupes[g], libres);
+        restantes += libres;
     }
+    atomic_store(&deck->nbRestantes, restantes);
+}
 
-    if (dispo == 0) return NULL;
+/**
+ * @brief Remet toutes les cartes du deck dans le paquet
+ * @param[in,out] deck Le deck
+ */
+void reinitialiserDeck(Deck* deck) {
+    poserMarqueurs(deck, NULL);
+}
 
-    /* Tirage au sort parmi les disponibles */
-    int choix = rand() % dispo;
-    int compteur = 0;
+/**
+ * @brief Remet les marqueurs d'un point de reprise
+ * @param[in,out] deck Le deck
+ * @param[in] utilisees Les marqueurs sauvegardés
+ */
+void restaurerDeck(Deck* deck, const uint64_t* utilisees) {
+    poserMarqueurs(deck, utilisees);
+}
 
-    for (int i = 0; i < deck->nbPositions; i++) {
-        if (!deck->estUtilisee[i]) {
-            if (compteur == choix) {
-                deck->estUtilisee[i] = 1; /* Marquer comme utilisée */
-                return &deck->positions[i];
+/**
+ * @brief Libère toutes les positions du deck
+ * @param[in,out] deck Le deck
+ */
+void libererDeck(Deck* deck) {
+    if (deck->possedePositions) {
+        for (int i = 0; i < deck->nbPositions; i++) {
+            libererEtat(&deck->positions[i]);
+        }
+        libererMem(deck->positions);
+        libererMem(deck->debutComposantes);
+    }
+    libererMem((void*)deck->estUtilisee);
+    libererMem((void*)deck->motsPleins);
+    libererMem((void*)deck->libresGroupes);
+    deck->positions = NULL;
+    deck->debutComposantes = NULL;
+    deck->nbComposantes = 0;
+    deck->estUtilisee = NULL;
+    deck->motsPleins = NULL;
+    deck->libresGroupes = NULL;
+    deck->nbPositions = 0;
+}
+
+/**
+ * @brief Renvoie l'indice du bit à 1 le plus faible d'un mot non nul
+ */
+static int premierBit(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+/**
+ * @brief Cartes libres du mot m restreintes à [debut, fin)
+ */
+static uint64_t libresDuMot(const Deck* deck, int m, int debut, int fin) {
+    uint64_t libres = ~atomic_load(&deck->estUtilisee[m]);
+    int base = m * 64;
+    if (debut > base) libres &= ~0ULL << (debut - base);
+    if (fin < base + 64) libres &= (1ULL << (fin - base)) - 1;
+    return libres;
+}
+
+/**
+ * @brief Indice du bit à 1 de rang k d'un mot qui en a plus de k
+ */
+static int bitDeRang(uint64_t x, int k) {
+    for (; k > 0; k--) x &= x - 1;
+    return premierBit(x);
+}
+
+/**
+ * @brief Parcourt les mots non pleins du groupe g qui touchent [debut, fin), dans l'ordre, en
+ *        décomptant leurs cartes libres de *k
+ * @return int L'indice de la carte libre de rang *k dans le groupe, ou -1 s'il en a moins, *k
+ *         étant alors diminué de toutes celles du groupe
+ */
+static int parcourirGroupe(const Deck* deck, int g, int debut, int fin, int* k) {
+    uint64_t nonPleins = ~atomic_load(&deck->motsPleins[g]);
+    while (nonPleins != 0) {
+        int m = g * 64 + premierBit(nonPleins);
+        nonPleins &= nonPleins - 1;
+        if (m * 64 >= fin) break;
+        if ((m + 1) * 64 <= debut) continue;
+
+        uint64_t libres = libresDuMot(deck, m, debut, fin);
+        int nb = nbBits(libres);
+        if (*k < nb) return m * 64 + bitDeRang(libres, *k);
+        *k -= nb;
+    }
+    return -1;
+}
+
+/**
+ * @brief Compte les cartes libres de [debut, fin) : compteurs des groupes entièrement compris
+ *        dans la plage, popcount des mots non pleins des groupes de ses bords
+ * @return int Le nombre de cartes libres
+ */
+static int compterLibres(const Deck* deck, int debut, int fin) {
+    int nb = 0;
+    for (int g = debut / (64 * 64); g * 64 * 64 < fin; g++) {
+        if (g * 64 * 64 >= debut && (g + 1) * 64 * 64 <= fin) {
+            nb += atomic_load(&deck->libresGroupes[g]);
+        }
+        else {
+            int k = deck->nbPositions;
+            parcourirGroupe(deck, g, debut, fin, &k);
+            nb += deck->nbPositions - k;
+        }
+    }
+    return nb;
+}
+
+/**
+ * @brief Cherche la carte libre de rang k dans [debut, fin) : les groupes compris dans la plage
+ *        dont le compteur est au plus k sont sautés d'un coup, puis le rang restant est cherché
+ *        parmi les mots non pleins du groupe atteint
+ * @return int L'indice de la carte, ou -1 si la plage a moins de k + 1 cartes libres
+ */
+static int selectionnerLibre(const Deck* deck, int debut, int fin, int k) {
+    for (int g = debut / (64 * 64); g * 64 * 64 < fin; g++) {
+        if (g * 64 * 64 >= debut && (g + 1) * 64 * 64 <= fin) {
+            int libres = atomic_load(&deck->libresGroupes[g]);
+            if (k >= libres) {
+                k -= libres;
+                continue;
             }
-            compteur++;
         }
+        int i = parcourirGroupe(deck, g, debut, fin, &k);
+        if (i >= 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Composante d'une position, par dichotomie sur les débuts de plage
+ * @return int L'indice de la composante
+ */
+static int composanteDe(const Deck* deck, int position) {
+    int bas = 0, haut = deck->nbComposantes - 1;
+    while (bas < haut) {
+        int milieu = (bas + haut + 1) / 2;
+        if (deck->debutComposantes[milieu] <= position) bas = milieu;
+        else haut = milieu - 1;
+    }
+    return bas;
+}
+
+/**
+ * @brief Réserve une carte de façon atomique
+ * @param[in,out] deck Le paquet de cartes
+ * @param[in] i Indice de la carte
+ * @return EtatJeu* La carte si elle était libre et appartient maintenant à l'appelant, NULL sinon
+ */
+EtatJeu* prendreCarte(Deck* deck, int i) {
+    int m = i / 64;
+    uint64_t bit = 1ULL << (i % 64);
+    uint64_t avant = atomic_fetch_or(&deck->estUtilisee[m], bit);
+
+    if (avant & bit) return NULL;
+
+    if ((avant | bit) == ~0ULL) {
+        atomic_fetch_or(&deck->motsPleins[m / 64], 1ULL << (m % 64));
+    }
+    atomic_fetch_sub(&deck->libresGroupes[m / 64], 1);
+    atomic_fetch_sub(&deck->nbRestantes, 1);
+    compterSonde(COMPTEUR_CARTES, 1);
+    return &deck->positions[i];
+}
+
+/**
+ * @brief Indique si une carte est libre
+ * @param[in] deck Le paquet de cartes
+ * @param[in] i Indice de la carte
+ * @return int 1 si libre
+ */
+int estCarteLibre(const Deck* deck, int i) {
+    return !((atomic_load(&deck->estUtilisee[i / 64]) >> (i % 64)) & 1);
+}
+
+/**
+ * @brief Tire uniformément une carte libre de la plage de depuis : son rang k parmi les cartes
+ *        libres, puis la carte de ce rang
+ * @param[in] deck Le paquet de cartes
+ * @param[in,out] alea Le générateur
+ * @param[in] depuis Position de départ ou NULL
+ * @return int L'indice de la carte ou -1
+ */
+int chercherCarteAuHasard(const Deck* deck, Alea* alea, const EtatJeu* depuis) {
+    int premiere = 0;
+    int fin = deck->nbPositions;
+    int entier = 1;
+    if (depuis != NULL && deck->nbComposantes > 1) {
+        int k = composanteDe(deck, (int)(depuis - deck->positions));
+        premiere = deck->debutComposantes[k];
+        fin = deck->debutComposantes[k + 1];
+        entier = 0;
+    }
+
+    for (;;) {
+        int libres = entier ? atomic_load(&deck->nbRestantes) : compterLibres(deck, premiere, fin);
+        if (libres <= 0) return -1;
+
+        /* Un autre fil a pu prendre des cartes entre le compte et la sélection : on recompte */
+        int i = selectionnerLibre(deck, premiere, fin, (int)tirerBorne(alea, (uint32_t)libres));
+        if (i >= 0) return i;
+    }
+}
+
+/**
+ * @brief Tire une carte objectif aléatoire non encore jouée, uniformément parmi les cartes
+ *        libres, puis la réserve sans verrou
+ * @param[in,out] deck Le paquet de cartes
+ * @return EtatJeu* Pointeur vers l'état cible, ou NULL si le deck est épuisé
+ */
+EtatJeu* tirerNouvelleCarte(Deck* deck) {
+    return tirerCarteAvec(deck, &deck->alea);
+}
+
+/**
+ * @brief Réamorce le générateur du deck
+ * @param[in,out] deck Le paquet
+ * @param[in] graine La graine
+ */
+void amorcerDeck(Deck* deck, uint64_t graine) {
+    initAlea(&deck->alea, graine);
+}
+
+/**
+ * @brief Tire une carte avec le générateur de la partie
+ * @param[in,out] deck Le paquet de cartes
+ * @param[in,out] alea Le générateur
+ * @return EtatJeu* Pointeur vers l'état cible, ou NULL si le deck est épuisé
+ */
+EtatJeu* tirerCarteAvec(Deck* deck, Alea* alea) {
+    return tirerCarteAtteignable(deck, alea, NULL);
+}
+
+/**
+ * @brief Tire une carte dans la plage de la composante de depuis : même recherche que sur le
+ *        deck entier, bornée à cette plage
+ * @param[in,out] deck Le paquet de cartes
+ * @param[in,out] alea Le générateur
+ * @param[in] depuis Position de départ ou NULL
+ * @return EtatJeu* Pointeur vers l'état cible, ou NULL si aucune carte atteignable ne reste
+ */
+EtatJeu* tirerCarteAtteignable(Deck* deck, Alea* alea, const EtatJeu* depuis) {
+    unsigned long long debut = debutSonde();
+    EtatJeu* carte = NULL;
+
+    while (carte == NULL && atomic_load(&deck->nbRestantes) > 0) {
+        int i = chercherCarteAuHasard(deck, alea, depuis);
+        if (i < 0) break;
+
+        /* Un autre fil a pu réserver la carte entre temps : on recommence */
+        carte = prendreCarte(deck, i);
     }
-    return NULL;
+
+    finSonde(SONDE_TIRAGE, debut);
+    return carte;
 }
 
 
@@ -346,6 +801,9 @@ void afficherOrdresPossibles(const ConfigJeu* config) {
 
         if (i < config->nbOrdres - 1) printf(" | ");
     }
+    for (int i = 0; i < config->nbMacros; i++) {
+        printf(" | %s (%s)", config->macros[i].nom, config->macros[i].expansion);
+    }
     printf("\n\n");
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <stdatomic.h>
+#include <stdint.h>
 #include "pile.h"
 #include "animal.h"
+#include "alea.h"
 
 
 /**
@@ -16,12 +19,23 @@ typedef struct {
 
 /**
  * @struct Deck
- * @brief Structure qui stock toutes les positions possibles (Les cartes objectifs)
+ * @brief Structure qui stock toutes les positions possibles (Les cartes objectifs).
+ *        Le deck peut être partagé entre plusieurs parties jouées en parallèle : une carte est
+ *        réservée par un bit posé atomiquement, une seule partie peut donc la tirer.
  */
 typedef struct {
-    EtatJeu* positions; /* Tableau dynamique de toutes les positions possibles */
-    int nbPositions;    /* Nombre total de positions stockées */
-    int* estUtilisee;   /* Tableau de booléens pour savoir si une carte a déjà été tirée */
+    EtatJeu* positions;              /* Tableau dynamique de toutes les positions possibles */
+    int nbPositions;                 /* Nombre total de positions stockées */
+    int possedePositions;            /* 0 si les positions appartiennent à un autre deck */
+    _Atomic(uint64_t)* estUtilisee;  /* Un bit par carte, à 1 si elle a déjà été tirée */
+    _Atomic(uint64_t)* motsPleins;   /* Un bit par mot de estUtilisee, à 1 si le mot est plein */
+    int nbMots;                      /* Nombre de mots de estUtilisee */
+    int nbGroupes;                   /* Nombre de mots de motsPleins */
+    atomic_int* libresGroupes;       /* Cartes libres des 64 mots de chaque groupe */
+    atomic_int nbRestantes;          /* Nombre de cartes encore disponibles */
+    Alea alea;                       /* Générateur de tirerNouvelleCarte */
+    int nbComposantes;               /* 0 tant que calculerComposantes n'a pas été appelée */
+    int* debutComposantes;           /* La composante k occupe les positions debut[k] à debut[k+1] - 1 */
 } Deck;
 
 
@@ -99,10 +113,47 @@ int commandeMA(EtatJeu* e);
  * @brief Execute une séquence de commande donnée sous forme de chaines. Elle appelle les fonctions des commandes tour à tour
  * @param[in,out] e Pointeur vers l'état du jeu qui sera modifié en place
  * @param[in] seq Chaîne de caractères représentant la séquence d'ordres
- * @return int 1 si toute la séquence ets valide, 0 si un ordre est inconnu ou impossible
+ * @return int 1 si toute la séquence est valide, 0 si un mouvement est impossible ou la longueur
+ *         impaire, -1 si un ordre est inconnu
  */
 int executerSequence(EtatJeu* e, const char* seq);
 
+/**
+ * @brief Comme executerSequence, mais accepte aussi les macros de la configuration. Une macro
+ *        applique son effet compilé en une seule fois, quelle que soit la longueur de sa suite
+ * @param[in,out] e Pointeur vers l'état du jeu qui sera modifié en place
+ * @param[in] seq Chaîne de caractères représentant la séquence d'ordres
+ * @param[in] config Configuration passée par compilerMacros, ou NULL pour les seuls ordres de base
+ * @return int 1 si OK, 0 si mouvement impossible ou longueur impaire, -1 si ordre inconnu
+ */
+int executerSequenceConfig(EtatJeu* e, const char* seq, const ConfigJeu* config);
+
+/**
+ * @brief Indique si l'état de départ, réarrangé par un effet de séquence, est l'état d'arrivée.
+ *        Les piles ne sont ni copiées ni modifiées
+ * @param[in] depart État de départ
+ * @param[in] hauteur Hauteur du podium bleu après l'effet
+ * @param[in] origine Pour chaque case d'EtatCompact de l'arrivée, la case du départ dont vient l'animal
+ * @param[in] arrivee État à comparer
+ * @return int 1 si identiques, 0 sinon
+ */
+int estMemeEtatApresEffet(const EtatJeu* depart, int hauteur, const uint8_t* origine, const EtatJeu* arrivee);
+
+/**
+ * @brief Code d'un ordre dans la table de la configuration, ou dans celle des ordres de base
+ * @param[in] deuxLettres Pointeur vers les deux lettres de l'ordre
+ * @param[in] config Configuration passée par compilerMacros, ou NULL
+ * @return int 0 si l'ordre est inconnu, 1 + code d'un ordre de base, 1 + NB_ORDRES_CONNUS + indice d'une macro
+ */
+int codeCommande(const char* deuxLettres, const ConfigJeu* config);
+
+/**
+ * @brief Case d'un nom d'ordre dans les tables de codes comme ConfigJeu.codes
+ * @param[in] deuxLettres Pointeur vers les deux lettres
+ * @return int L'indice, ou -1 si ce ne sont pas deux lettres majuscules
+ */
+int indiceCodeOrdre(const char* deuxLettres);
+
 
 
 /**
@@ -112,16 +163,99 @@ int executerSequence(EtatJeu* e, const char* seq);
  */
 void genererToutesPositions(const ConfigJeu* config, Deck* deck);
 
+/**
+ * @brief Crée un deck complet qui réutilise les positions d'un autre deck, en lecture seule.
+ *        Seuls les marqueurs de cartes tirées sont propres à la copie
+ * @param[in] modele Deck déjà généré, qui doit rester en vie tant que la copie sert
+ * @param[out] copie Deck à initialiser
+ */
+void partagerPositions(const Deck* modele, Deck* copie);
+
+/**
+ * @brief Remet toutes les cartes dans le paquet sans régénérer les positions
+ * @param[in,out] deck Le deck à réinitialiser
+ */
+void reinitialiserDeck(Deck* deck);
+
+/**
+ * @brief Remet les marqueurs de cartes tirées tels qu'un point de reprise les a sauvegardés
+ * @param[in,out] deck Le deck, dont les positions sont rangées comme lors de la sauvegarde
+ * @param[in] utilisees Les nbMots mots de estUtilisee sauvegardés
+ */
+void restaurerDeck(Deck* deck, const uint64_t* utilisees);
+
+/**
+ * @brief Libère toutes les positions du deck et ses marqueurs
+ * @param[in,out] deck Le deck à nettoyer
+ */
+void libererDeck(Deck* deck);
+
 /* Tire une nouvelle position cible al�atoire qui n'a pas encore �t� jou�e */
 /* Retourne un pointeur vers l'�tat cible, ou NULL si plus de cartes */
 
 /**
- * @brief Tire une nouvelle carte objectif au hasard parmis celles non utilisés. La carte sera marqué comme tiré arpès
+ * @brief Tire une nouvelle carte objectif au hasard parmis celles non utilisés. La carte sera marqué comme tiré arpès.
+ *        Utilise le générateur du deck : pour piocher depuis plusieurs fils, chacun passe le sien à tirerCarteAvec
  * @param[in,out] deck Le paquet dans lequel piocher
  * @return EtatJeu* Pointeur vers l'état cible tiré ou NULL si il y a plus de cartes
  */
 EtatJeu* tirerNouvelleCarte(Deck* deck);
 
+/**
+ * @brief Réamorce le générateur du deck. Une même graine redonne la même suite de cartes
+ * @param[in,out] deck Le paquet
+ * @param[in] graine La graine
+ */
+void amorcerDeck(Deck* deck, uint64_t graine);
+
+/**
+ * @brief Comme tirerNouvelleCarte, mais le hasard vient du générateur de la partie.
+ *        Peut être appelée en même temps depuis plusieurs fils sur le même deck
+ * @param[in,out] deck Le paquet dans lequel piocher
+ * @param[in,out] alea Générateur de la partie
+ * @return EtatJeu* Pointeur vers l'état cible tiré ou NULL si il y a plus de cartes
+ */
+EtatJeu* tirerCarteAvec(Deck* deck, Alea* alea);
+
+/**
+ * @brief Tire une carte non encore jouée atteignable depuis un état du deck, c'est-à-dire dans
+ *        sa composante. Sans composantes calculées, ou si depuis vaut NULL, équivaut à tirerCarteAvec
+ * @param[in,out] deck Le paquet de cartes
+ * @param[in,out] alea Le générateur
+ * @param[in] depuis Position du deck d'où partent les joueurs, ou NULL
+ * @return EtatJeu* Pointeur vers l'état cible, ou NULL si aucune carte atteignable ne reste
+ */
+EtatJeu* tirerCarteAtteignable(Deck* deck, Alea* alea, const EtatJeu* depuis);
+
+/**
+ * @brief Indice d'une carte libre prise uniformément au hasard parmi celles atteignables depuis
+ *        un état, sans la réserver : un rang parmi les cartes libres est tiré, puis la carte de
+ *        ce rang est trouvée grâce aux compteurs des groupes. Sert aux tirages qui trient les
+ *        cartes avant de les prendre
+ * @param[in] deck Le paquet de cartes
+ * @param[in,out] alea Le générateur
+ * @param[in] depuis Position du deck d'où partent les joueurs, ou NULL pour tout le deck
+ * @return int L'indice de la carte dans deck->positions, ou -1 si aucune n'est libre
+ */
+int chercherCarteAuHasard(const Deck* deck, Alea* alea, const EtatJeu* depuis);
+
+/**
+ * @brief Réserve une carte précise. Peut être appelée en même temps depuis plusieurs fils :
+ *        un seul obtient la carte
+ * @param[in,out] deck Le paquet de cartes
+ * @param[in] i Indice de la carte dans deck->positions
+ * @return EtatJeu* La carte, ou NULL si elle était déjà tirée
+ */
+EtatJeu* prendreCarte(Deck* deck, int i);
+
+/**
+ * @brief Indique si une carte précise est encore libre, sans la réserver
+ * @param[in] deck Le paquet de cartes
+ * @param[in] i Indice de la carte dans deck->positions
+ * @return int 1 si elle n'a pas été tirée
+ */
+int estCarteLibre(const Deck* deck, int i);
+
 /**
  * @brief Affiche le duel entre la position actuel et l'objectif
  * @param[in] depart Etat actuel du jeu (Les podiums à gauche)
@@ -0,0 +1,222 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "joueurs.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Compare deux joueurs pour le classement
+ * @param[in] a Premier joueur
+ * @param[in] b Deuxième joueur
+ * @return int Négatif si a passe devant b
+ */
+int compareJoueurs(const void* a, const void* b) {
+    const Joueur* j1 = (const Joueur*)a;
+    const Joueur* j2 = (const Joueur*)b;
+
+    if (j1->score != j2->score) {
+        return j2->score - j1->score;
+    }
+    return strcmp(j1->nom, j2->nom);
+}
+
+/**
+ * @brief Hachage FNV-1a d'un nom
+ */
+static uint64_t hacherNom(const char* nom) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    while (*nom) {
+        h ^= (unsigned char)*nom++;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+/**
+ * @brief Arrête le programme si une allocation a échoué
+ */
+static void verifierAllocation(const void* p) {
+    if (p == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le registre des joueurs.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Initialise un registre vide
+ * @param[out] r Le registre
+ */
+void initRegistre(Registre* r) {
+    r->capacite = 16;
+    r->nbJoueurs = 0;
+    r->joueurs = (Joueur*)allouerMem(MEM_JOUEURS, sizeof(Joueur) * r->capacite);
+    verifierAllocation(r->joueurs);
+
+    r->tailleTable = 32;
+    r->table = (int*)allouerMemZero(MEM_JOUEURS, r->tailleTable, sizeof(int));
+    verifierAllocation(r->table);
+
+    r->nbMots = 1;
+    r->peutJouer = (_Atomic(uint64_t)*)allouerMemZero(MEM_JOUEURS, r->nbMots, sizeof(uint64_t));
+    verifierAllocation((void*)r->peutJouer);
+    atomic_init(&r->nbEnLice, 0);
+}
+
+/**
+ * @brief Libère le registre
+ * @param[in,out] r Le registre
+ */
+void libererRegistre(Registre* r) {
+    libererMem(r->joueurs);
+    libererMem(r->table);
+    libererMem((void*)r->peutJouer);
+    r->joueurs = NULL;
+    r->table = NULL;
+    r->peutJouer = NULL;
+    r->nbJoueurs = 0;
+}
+
+/**
+ * @brief Cherche la case de la table qui contient le nom, ou la case libre où l'insérer
+ */
+static int caseDuNom(const Registre* r, const char* nom) {
+    int masque = r->tailleTable - 1;
+    int i = (int)(hacherNom(nom) & (uint64_t)masque);
+
+    while (r->table[i] != 0 && strcmp(r->joueurs[r->table[i] - 1].nom, nom) != 0) {
+        i = (i + 1) & masque;
+    }
+    return i;
+}
+
+/**
+ * @brief Double la table de hachage et y replace tous les joueurs
+ */
+static void agrandirTable(Registre* r) {
+    libererMem(r->table);
+    r->tailleTable *= 2;
+    r->table = (int*)allouerMemZero(MEM_JOUEURS, r->tailleTable, sizeof(int));
+    verifierAllocation(r->table);
+
+    for (int id = 0; id < r->nbJoueurs; id++) {
+        r->table[caseDuNom(r, r->joueurs[id].nom)] = id + 1;
+    }
+}
+
+/**
+ * @brief Inscrit un joueur
+ * @param[in,out] r Le registre
+ * @param[in] nom Son nom
+ * @return int Son indice ou -1 si le nom existe déjà
+ */
+int ajouterJoueur(Registre* r, char* nom) {
+    if (r->table[caseDuNom(r, nom)] != 0) return -1;
+
+    if (r->nbJoueurs == r->capacite) {
+        r->capacite *= 2;
+        Joueur* nouv = (Joueur*)reallouerMem(MEM_JOUEURS, r->joueurs, sizeof(Joueur) * r->capacite);
+        verifierAllocation(nouv);
+        r->joueurs = nouv;
+    }
+
+    /* La table reste remplie à moins de moitié pour garder des sondes courtes */
+    if (2 * (r->nbJoueurs + 1) > r->tailleTable) {
+        agrandirTable(r);
+    }
+
+    if (r->nbJoueurs / 64 >= r->nbMots) {
+        int nbMots = r->nbMots * 2;
+        _Atomic(uint64_t)* bits = (_Atomic(uint64_t)*)reallouerMem(MEM_JOUEURS, (void*)r->peutJouer, sizeof(uint64_t) * nbMots);
+        verifierAllocation((void*)bits);
+        for (int m = r->nbMots; m < nbMots; m++) atomic_init(&bits[m], 0);
+        r->peutJouer = bits;
+        r->nbMots = nbMots;
+    }
+
+    int id = r->nbJoueurs++;
+    r->joueurs[id].nom = nom;
+    r->joueurs[id].score = 0;
+    r->table[caseDuNom(r, nom)] = id + 1;
+
+    atomic_fetch_or(&r->peutJouer[id / 64], 1ULL << (id % 64));
+    atomic_fetch_add(&r->nbEnLice, 1);
+    return id;
+}
+
+/**
+ * @brief Retrouve un joueur par son nom
+ * @param[in] r Le registre
+ * @param[in] nom Le nom
+ * @return int Son indice ou -1
+ */
+int chercherJoueur(const Registre* r, const char* nom) {
+    return r->table[caseDuNom(r, nom)] - 1;
+}
+
+
+/**
+ * @brief Redonne le droit de jouer à tout le monde
+ * @param[in,out] r Le registre
+ */
+void nouveauTour(Registre* r) {
+    for (int m = 0; m < r->nbMots; m++) {
+        int debut = m * 64;
+        uint64_t bits;
+        if (debut + 64 <= r->nbJoueurs) bits = ~0ULL;
+        else if (debut >= r->nbJoueurs) bits = 0;
+        else bits = ~0ULL >> (64 - (r->nbJoueurs - debut));
+        atomic_store(&r->peutJouer[m], bits);
+    }
+    atomic_store(&r->nbEnLice, r->nbJoueurs);
+}
+
+/**
+ * @brief Indique si un joueur peut encore jouer
+ * @param[in] r Le registre
+ * @param[in] id L'indice du joueur
+ * @return int 1 ou 0
+ */
+int estEnLice(const Registre* r, int id) {
+    return (int)((atomic_load(&r->peutJouer[id / 64]) >> (id % 64)) & 1);
+}
+
+/**
+ * @brief Retire un joueur du tour en cours
+ * @param[in,out] r Le registre
+ * @param[in] id L'indice du joueur
+ */
+void eliminerDuTour(Registre* r, int id) {
+    uint64_t bit = 1ULL << (id % 64);
+    uint64_t avant = atomic_fetch_and(&r->peutJouer[id / 64], ~bit);
+    if (avant & bit) {
+        atomic_fetch_sub(&r->nbEnLice, 1);
+    }
+}
+
+/**
+ * @brief Nombre de joueurs encore en lice
+ * @param[in] r Le registre
+ * @return int Le nombre
+ */
+int nbJoueursEnLice(const Registre* r) {
+    return atomic_load(&r->nbEnLice);
+}
+
+/**
+ * @brief Premier joueur encore en lice
+ * @param[in] r Le registre
+ * @return int Son indice ou -1
+ */
+int premierEnLice(const Registre* r) {
+    for (int m = 0; m < r->nbMots; m++) {
+        uint64_t bits = atomic_load(&r->peutJouer[m]);
+        if (bits != 0) {
+            int b = 0;
+            while (!((bits >> b) & 1)) b++;
+            return m * 64 + b;
+        }
+    }
+    return -1;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+/**
+ * @struct Joueur
+ * @brief Représente un participant à la partie
+ */
+typedef struct {
+    char* nom;  /* Pointeur vers le nom (argv) */
+    int score;  /* Score courant */
+} Joueur;
+
+/**
+ * @struct Registre
+ * @brief Ensemble extensible des joueurs, indexé par une table de hachage sur les noms.
+ *        Les droits de jeu du tour sont rangés dans un tableau de bits
+ */
+typedef struct {
+    Joueur* joueurs;               /* Tableau dynamique des joueurs, dans l'ordre d'inscription */
+    int nbJoueurs;                 /* Nombre de joueurs inscrits */
+    int capacite;                  /* Taille allouée de joueurs */
+    int* table;                    /* Adressage ouvert : indice du joueur + 1, ou 0 si la case est libre */
+    int tailleTable;               /* Toujours une puissance de 2 */
+    _Atomic(uint64_t)* peutJouer;  /* Un bit par joueur, à 1 s'il peut encore jouer durant ce tour */
+    int nbMots;                    /* Nombre de mots alloués pour peutJouer */
+    atomic_int nbEnLice;           /* Nombre de joueurs qui peuvent encore jouer durant ce tour */
+} Registre;
+
+
+
+/**
+ * @brief Fonction de comparaison pour le tri des scores (score décroissant puis nom)
+ * @param[in] a Pointeur vers le premier Joueur
+ * @param[in] b Pointeur vers le deuxième Joueur
+ * @return int Négatif si a est mieux classé que b, positif sinon
+ */
+int compareJoueurs(const void* a, const void* b);
+
+
+/**
+ * @brief Initialise un registre vide
+ * @param[out] r Pointeur vers le registre à initialiser
+ */
+void initRegistre(Registre* r);
+
+/**
+ * @brief Libère la mémoire du registre (les noms ne sont pas libérés)
+ * @param[in,out] r Pointeur vers le registre à nettoyer
+ */
+void libererRegistre(Registre* r);
+
+/**
+ * @brief Inscrit un nouveau joueur avec un score nul
+ * @param[in,out] r Pointeur vers le registre
+ * @param[in] nom Nom du joueur, qui doit rester valide tant que le registre est utilisé
+ * @return int L'indice du joueur, ou -1 si le nom est déjà pris
+ */
+int ajouterJoueur(Registre* r, char* nom);
+
+/**
+ * @brief Retrouve un joueur par son nom en temps constant
+ * @param[in] r Pointeur vers le registre
+ * @param[in] nom Nom recherché
+ * @return int L'indice du joueur, ou -1 s'il est inconnu
+ */
+int chercherJoueur(const Registre* r, const char* nom);
+
+
+/**
+ * @brief Redonne le droit de jouer à tous les joueurs pour un nouveau tour
+ * @param[in,out] r Pointeur vers le registre
+ */
+void nouveauTour(Registre* r);
+
+/**
+ * @brief Indique si un joueur peut encore jouer durant ce tour
+ * @param[in] r Pointeur vers le registre
+ * @param[in] id Indice du joueur
+ * @return int 1 s'il peut jouer, 0 sinon
+ */
+int estEnLice(const Registre* r, int id);
+
+/**
+ * @brief Retire à un joueur le droit de jouer durant ce tour
+ * @param[in,out] r Pointeur vers le registre
+ * @param[in] id Indice du joueur
+ */
+void eliminerDuTour(Registre* r, int id);
+
+/**
+ * @brief Renvoie le nombre de joueurs qui peuvent encore jouer durant ce tour
+ * @param[in] r Pointeur vers le registre
+ * @return int Le nombre de joueurs en lice
+ */
+int nbJoueursEnLice(const Registre* r);
+
+/**
+ * @brief Cherche le premier joueur encore en lice
+ * @param[in] r Pointeur vers le registre
+ * @return int L'indice du joueur, ou -1 si personne ne peut jouer
+ */
+int premierEnLice(const Registre* r);
\ No newline at end of file
@@ -0,0 +1,405 @@
+#define _POSIX_C_SOURCE 200809L
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "journal.h"
+#include "etatcompact.h"
+#include "memoire.h"
+
+/**
+ * @def LOT_ECRITURE
+ * @brief Nombre d'événements retirés de l'anneau avant chaque fwrite
+ */
+#define LOT_ECRITURE 256
+
+/**
+ * @def PAUSE_ECRIVAIN_NS
+ * @brief Sommeil de l'écrivain quand l'anneau est vide
+ */
+#define PAUSE_ECRIVAIN_NS 1000000L
+
+_Static_assert(sizeof(EvenementJournal) == 32 + JOURNAL_ORDRES_MAX / 2, "EvenementJournal ne doit pas avoir de remplissage");
+_Static_assert((JOURNAL_CAPACITE & (JOURNAL_CAPACITE - 1)) == 0, "JOURNAL_CAPACITE doit etre une puissance de 2");
+_Static_assert(NB_ORDRES_CONNUS + MAX_MACROS < 16, "Les codes d'ordres doivent tenir sur un quartet");
+
+
+/**
+ * @brief Écrit sur le disque ce que le système garde encore en mémoire pour le segment
+ * @param[in,out] j Le journal
+ */
+static void synchroniser(Journal* j) {
+    if (j->segment == NULL) return;
+    fflush(j->segment);
+#ifdef _WIN32
+    _commit(_fileno(j->segment));
+#else
+    fsync(fileno(j->segment));
+#endif
+}
+
+/**
+ * @brief Ferme le segment en cours et ouvre le suivant avec son en-tête
+ * @param[in,out] j Le journal
+ * @return int 1 si le nouveau segment est ouvert
+ */
+static int changerSegment(Journal* j) {
+    if (j->segment != NULL) {
+        synchroniser(j);
+        fclose(j->segment);
+    }
+
+    j->numeroSegment++;
+    size_t taille = strlen(j->prefixe) + 16;
+    char* chemin = (char*)allouerMem(MEM_DIVERS, taille);
+    if (chemin == NULL) {
+        j->segment = NULL;
+        return 0;
+    }
+    snprintf(chemin, taille, "%s.%06u", j->prefixe, (unsigned)j->numeroSegment);
+    j->segment = fopen(chemin, "wb");
+    if (j->segment == NULL) {
+        fprintf(stderr, "Erreur : Impossible de creer le segment de journal %s.\n", chemin);
+        libererMem(chemin);
+        return 0;
+    }
+    libererMem(chemin);
+
+    EnteteSegment entete;
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.magie, JOURNAL_MAGIE, 4);
+    entete.tailleEvenement = (uint32_t)sizeof(EvenementJournal);
+    entete.numero = j->numeroSegment;
+    entete.graine = j->graine;
+    fwrite(&entete, sizeof(entete), 1, j->segment);
+    j->octetsSegment = (long)sizeof(entete);
+    return 1;
+}
+
+/**
+ * @brief Retire l'événement le plus ancien de l'anneau. Seul l'écrivain l'appelle
+ * @param[in,out] j Le journal
+ * @param[out] e L'événement retiré
+ * @return int 1 si un événement a été retiré, 0 si l'anneau est vide
+ */
+static int retirer(Journal* j, EvenementJournal* e) {
+    CaseJournal* c = &j->cases[j->sortie & (JOURNAL_CAPACITE - 1)];
+    size_t sequence = atomic_load_explicit(&c->sequence, memory_order_acquire);
+    if (sequence != j->sortie + 1) return 0;
+
+    *e = c->evenement;
+    /* La case redevient libre pour le tour d'anneau suivant */
+    atomic_store_explicit(&c->sequence, j->sortie + JOURNAL_CAPACITE, memory_order_release);
+    j->sortie++;
+    return 1;
+}
+
+/**
+ * @brief Écrit un lot d'événements, en changeant de segment quand le courant est plein
+ * @param[in,out] j Le journal
+ * @param[in] lot Les événements
+ * @param[in] nb Leur nombre
+ */
+static void ecrireLot(Journal* j, const EvenementJournal* lot, int nb) {
+    int i = 0;
+    while (i < nb && j->segment != NULL) {
+        long place = (JOURNAL_TAILLE_SEGMENT - j->octetsSegment) / (long)sizeof(EvenementJournal);
+        if (place <= 0) {
+            if (!changerSegment(j)) return;
+            continue;
+        }
+        int n = (nb - i < place) ? nb - i : (int)place;
+        fwrite(lot + i, sizeof(EvenementJournal), (size_t)n, j->segment);
+        j->octetsSegment += (long)sizeof(EvenementJournal) * n;
+        j->nbEcrits += n;
+        i += n;
+    }
+}
+
+/**
+ * @brief Fil écrivain : vide l'anneau par lots et synchronise le segment au moins une fois par
+ *        période, puis une dernière fois à l'arrêt
+ * @param[in] arg Le journal
+ * @return int 0
+ */
+static int ecrire(void* arg) {
+    Journal* j = (Journal*)arg;
+    EvenementJournal lot[LOT_ECRITURE];
+    unsigned long long derniereSync = horodatageNs();
+    int nonSynchronise = 0;
+
+    for (;;) {
+        int nb = 0;
+        while (nb < LOT_ECRITURE && retirer(j, &lot[nb])) nb++;
+        if (nb > 0) {
+            ecrireLot(j, lot, nb);
+            nonSynchronise = 1;
+        }
+
+        unsigned long long maintenant = horodatageNs();
+        if (nonSynchronise && maintenant - derniereSync >= JOURNAL_PERIODE_SYNC_NS) {
+            synchroniser(j);
+            derniereSync = maintenant;
+            nonSynchronise = 0;
+        }
+
+        if (nb == 0) {
+            /* Les producteurs ont fini avant l'arrêt : l'anneau vide l'est pour de bon */
+            if (atomic_load(&j->arret)) break;
+            struct timespec pause = { 0, PAUSE_ECRIVAIN_NS };
+            thrd_sleep(&pause, NULL);
+        }
+    }
+
+    synchroniser(j);
+    return 0;
+}
+
+/**
+ * @brief Ouvre le journal
+ * @param[out] j Le journal
+ * @param[in] prefixe Chemin des segments
+ * @param[in] graine La graine
+ * @return int 1 si prêt
+ */
+int ouvrirJournal(Journal* j, const char* prefixe, uint64_t graine) {
+    memset(j, 0, sizeof(Journal));
+    j->graine = graine;
+    j->cases = (CaseJournal*)allouerMem(MEM_DIVERS, sizeof(CaseJournal) * JOURNAL_CAPACITE);
+    j->prefixe = (char*)allouerMem(MEM_DIVERS, strlen(prefixe) + 1);
+    if (j->cases == NULL || j->prefixe == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le journal.\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(j->prefixe, prefixe);
+
+    for (size_t i = 0; i < JOURNAL_CAPACITE; i++) atomic_init(&j->cases[i].sequence, i);
+    atomic_init(&j->entree, 0);
+    atomic_init(&j->perdus, 0);
+    atomic_init(&j->arret, 0);
+
+    if (!changerSegment(j) || thrd_create(&j->ecrivain, ecrire, j) != thrd_success) {
+        if (j->segment != NULL) fclose(j->segment);
+        libererMem(j->cases);
+        libererMem(j->prefixe);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Ferme le journal
+ * @param[in,out] j Le journal
+ * @return long long Événements perdus
+ */
+long long fermerJournal(Journal* j) {
+    atomic_store(&j->arret, 1);
+    thrd_join(j->ecrivain, NULL);
+
+    if (j->segment != NULL) fclose(j->segment);
+    j->segment = NULL;
+    libererMem(j->cases);
+    libererMem(j->prefixe);
+    j->cases = NULL;
+    j->prefixe = NULL;
+    return atomic_load(&j->perdus);
+}
+
+/**
+ * @brief Dépose un événement : réserve une case libre par compare-and-swap sur l'entrée, la
+ *        remplit puis la publie en avançant son numéro de passage
+ * @param[in,out] j Le journal
+ * @param[in] e L'événement
+ * @return int 1 si déposé, 0 si l'anneau est plein
+ */
+int journaliser(Journal* j, const EvenementJournal* e) {
+    if (j == NULL) return 0;
+
+    size_t position = atomic_load_explicit(&j->entree, memory_order_relaxed);
+    for (;;) {
+        CaseJournal* c = &j->cases[position & (JOURNAL_CAPACITE - 1)];
+        size_t sequence = atomic_load_explicit(&c->sequence, memory_order_acquire);
+        intptr_t ecart = (intptr_t)sequence - (intptr_t)position;
+
+        if (ecart == 0) {
+            if (atomic_compare_exchange_weak_explicit(&j->entree, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                c->evenement = *e;
+                atomic_store_explicit(&c->sequence, position + 1, memory_order_release);
+                return 1;
+            }
+        }
+        else if (ecart < 0) {
+            /* La case n'a pas encore été lue au tour d'anneau précédent : plein */
+            atomic_fetch_add(&j->perdus, 1);
+            return 0;
+        }
+        else {
+            position = atomic_load_explicit(&j->entree, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Prépare un événement sans joueur
+ */
+static void preparer(EvenementJournal* e, uint8_t type, uint32_t partie, uint32_t tour) {
+    memset(e, 0, sizeof(EvenementJournal));
+    e->horodatage = horodatageNs();
+    e->partie = partie;
+    e->tour = tour;
+    e->joueur = UINT32_MAX;
+    e->type = type;
+}
+
+/**
+ * @brief Journalise le début d'un tour
+ * @param[in,out] j Le journal
+ * @param[in] config La configuration
+ * @param[in] partie Numéro de partie
+ * @param[in] tour Numéro de tour
+ * @param[in] courant Départ
+ * @param[in] objectif Objectif
+ */
+void journaliserTour(Journal* j, const ConfigJeu* config, uint32_t partie, uint32_t tour,
+                     const EtatJeu* courant, const EtatJeu* objectif) {
+    if (j == NULL) return;
+
+    EvenementJournal e;
+    preparer(&e, EVT_TOUR, partie, tour);
+    EtatCompact c;
+    compacterEtat(config, courant, &c);
+    e.a = rangEtat(&c);
+    compacterEtat(config, objectif, &c);
+    e.b = rangEtat(&c);
+    journaliser(j, &e);
+}
+
+/**
+ * @brief Journalise une soumission et son verdict
+ * @param[in,out] j Le journal
+ * @param[in] config La configuration
+ * @param[in] partie Numéro de partie
+ * @param[in] tour Numéro de tour
+ * @param[in] s La soumission jugée
+ */
+void journaliserSoumission(Journal* j, const ConfigJeu* config, uint32_t partie, uint32_t tour, const Soumission* s) {
+    if (j == NULL) return;
+
+    EvenementJournal e;
+    preparer(&e, EVT_SOUMISSION, partie, tour);
+    e.horodatage = s->horodatage;
+    e.joueur = (uint32_t)s->idJoueur;
+
+    size_t longueur = strlen(s->sequence);
+    size_t nbOrdres = longueur / 2;
+    if (nbOrdres > JOURNAL_ORDRES_MAX) nbOrdres = JOURNAL_ORDRES_MAX;
+    for (size_t i = 0; i < nbOrdres; i++) {
+        uint8_t code = (uint8_t)codeCommande(s->sequence + 2 * i, config);
+        e.ordres[i / 2] |= (uint8_t)(code << (4 * (i % 2)));
+    }
+    e.b = (uint32_t)nbOrdres;
+    if (longueur % 2 != 0) e.drapeaux |= EVT_LONGUEUR_IMPAIRE;
+    journaliser(j, &e);
+
+    preparer(&e, EVT_VERDICT, partie, tour);
+    e.joueur = (uint32_t)s->idJoueur;
+    e.code = (int8_t)s->codeRetour;
+    if (s->bonneSolution) e.drapeaux |= EVT_BONNE_SOLUTION;
+    e.a = (s->dureeJugement > UINT32_MAX) ? UINT32_MAX : (uint32_t)s->dureeJugement;
+    journaliser(j, &e);
+}
+
+/**
+ * @brief Journalise un point
+ * @param[in,out] j Le journal
+ * @param[in] partie Numéro de partie
+ * @param[in] tour Numéro de tour
+ * @param[in] joueur Le joueur
+ * @param[in] forfait 1 si gagné par forfait
+ */
+void journaliserPoint(Journal* j, uint32_t partie, uint32_t tour, int joueur, int forfait) {
+    if (j == NULL) return;
+
+    EvenementJournal e;
+    preparer(&e, EVT_POINT, partie, tour);
+    e.joueur = (uint32_t)joueur;
+    if (forfait) e.drapeaux |= EVT_FORFAIT;
+    journaliser(j, &e);
+}
+
+/**
+ * @brief Écrit la colonne des ordres d'une soumission
+ * @param[in] e La soumission
+ * @param[in,out] sortie Le flux
+ */
+static void ecrireOrdresCsv(const EvenementJournal* e, FILE* sortie) {
+    uint32_t nb = (e->b > JOURNAL_ORDRES_MAX) ? JOURNAL_ORDRES_MAX : e->b;
+    for (uint32_t i = 0; i < nb; i++) {
+        int code = (e->ordres[i / 2] >> (4 * (i % 2))) & 0xF;
+        if (code == EVT_ORDRE_INCONNU) fputs("??", sortie);
+        else if (code <= NB_ORDRES_CONNUS) fputs(NOMS_ORDRES[code - 1], sortie);
+        else fprintf(sortie, "M%d", code - 1 - NB_ORDRES_CONNUS);
+    }
+    if (e->drapeaux & EVT_LONGUEUR_IMPAIRE) fputc('?', sortie);
+}
+
+/**
+ * @brief Convertit des segments en CSV
+ * @param[in] chemins Les segments
+ * @param[in] nb Leur nombre
+ * @param[in,out] sortie Le flux
+ * @return int 1 si tout a été lu
+ */
+int convertirJournalCsv(char** chemins, int nb, FILE* sortie) {
+    static const char* nomsTypes[] = { "?", "tour", "soumission", "verdict", "point" };
+    int ok = 1;
+
+    fprintf(sortie, "horodatage_ns,partie,tour,evenement,joueur,rang_depart,rang_objectif,ordres,retour,bonne_solution,duree_ns,forfait\n");
+    for (int k = 0; k < nb; k++) {
+        FILE* f = fopen(chemins[k], "rb");
+        EnteteSegment entete;
+        if (f == NULL || fread(&entete, sizeof(entete), 1, f) != 1 || memcmp(entete.magie, JOURNAL_MAGIE, 4) != 0 ||
+            entete.tailleEvenement != sizeof(EvenementJournal)) {
+            fprintf(stderr, "Erreur : %s n'est pas un segment de journal valide.\n", chemins[k]);
+            if (f != NULL) fclose(f);
+            ok = 0;
+            continue;
+        }
+
+        EvenementJournal e;
+        while (fread(&e, sizeof(e), 1, f) == 1) {
+            const char* type = (e.type <= EVT_POINT) ? nomsTypes[e.type] : nomsTypes[0];
+            fprintf(sortie, "%llu,%u,%u,%s,", (unsigned long long)e.horodatage, (unsigned)e.partie, (unsigned)e.tour, type);
+            if (e.joueur != UINT32_MAX) fprintf(sortie, "%u", (unsigned)e.joueur);
+
+            switch (e.type) {
+            case EVT_TOUR:
+                fprintf(sortie, ",%u,%u,,,,,\n", (unsigned)e.a, (unsigned)e.b);
+                break;
+            case EVT_SOUMISSION:
+                fputs(",,,", sortie);
+                ecrireOrdresCsv(&e, sortie);
+                fputs(",,,,\n", sortie);
+                break;
+            case EVT_VERDICT:
+                fprintf(sortie, ",,,,%d,%d,%u,\n", e.code, (e.drapeaux & EVT_BONNE_SOLUTION) ? 1 : 0, (unsigned)e.a);
+                break;
+            case EVT_POINT:
+                fprintf(sortie, ",,,,,,,%d\n", (e.drapeaux & EVT_FORFAIT) ? 1 : 0);
+                break;
+            default:
+                fputs(",,,,,,,\n", sortie);
+                break;
+            }
+        }
+        fclose(f);
+    }
+    return ok;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <threads.h>
+#include "jeu.h"
+#include "soumission.h"
+
+/**
+ * @def JOURNAL_CAPACITE
+ * @brief Nombre d'événements que l'anneau peut garder en attente d'écriture (puissance de 2)
+ */
+#define JOURNAL_CAPACITE 16384
+
+/**
+ * @def JOURNAL_TAILLE_SEGMENT
+ * @brief Taille au-delà de laquelle l'écrivain passe au segment suivant, en octets
+ */
+#define JOURNAL_TAILLE_SEGMENT (64L * 1024 * 1024)
+
+/**
+ * @def JOURNAL_PERIODE_SYNC_NS
+ * @brief Délai maximal entre deux fsync du segment en cours
+ */
+#define JOURNAL_PERIODE_SYNC_NS 1000000000ULL
+
+/**
+ * @def JOURNAL_ORDRES_MAX
+ * @brief Nombre d'ordres gardés pour une soumission : toute ligne de LEN_CMD caractères y tient
+ */
+#define JOURNAL_ORDRES_MAX (LEN_CMD / 2)
+
+/**
+ * @def JOURNAL_MAGIE
+ * @brief Quatre premiers octets d'un segment
+ */
+#define JOURNAL_MAGIE "CCJ1"
+
+/* Types d'événements */
+#define EVT_TOUR 1          /* Début d'un tour : rangs de la position de départ et de l'objectif */
+#define EVT_SOUMISSION 2    /* Séquence d'un joueur, horodatée à son arrivée */
+#define EVT_VERDICT 3       /* Retour de l'exécution et bonne solution ou non */
+#define EVT_POINT 4         /* Point marqué, gagné ou par forfait */
+
+/* Drapeaux des événements */
+#define EVT_BONNE_SOLUTION 1   /* Verdict : la séquence atteint l'objectif */
+#define EVT_LONGUEUR_IMPAIRE 2 /* Soumission : un caractère de trop après le dernier ordre */
+#define EVT_FORFAIT 4          /* Point : le joueur était le seul encore en lice */
+
+/* Code d'ordre journalisé pour un ordre inconnu (sinon celui de codeCommande) */
+#define EVT_ORDRE_INCONNU 0
+
+
+/**
+ * @struct EvenementJournal
+ * @brief Enregistrement de taille fixe, écrit tel quel dans les segments (ordre des octets de la
+ *        machine). Les ordres d'une soumission sont rangés par quartets, deux par octet, le
+ *        premier dans le quartet bas
+ */
+typedef struct {
+    uint64_t horodatage;          /* ns ; instant d'arrivée pour une soumission */
+    uint32_t partie;              /* Numéro de la partie dans un tournoi, 0 sinon */
+    uint32_t tour;                /* Numéro du tour, à partir de 1 */
+    uint32_t joueur;              /* Indice dans le registre, UINT32_MAX sans joueur */
+    uint8_t type;                 /* EVT_... */
+    int8_t code;                  /* Verdict : 1 OK, 0 mouvement impossible, -1 ordre inconnu */
+    uint8_t drapeaux;             /* EVT_BONNE_SOLUTION, EVT_LONGUEUR_IMPAIRE, EVT_FORFAIT */
+    uint8_t reserve;
+    uint32_t a;                   /* Tour : rang du départ ; verdict : durée du jugement en ns */
+    uint32_t b;                   /* Tour : rang de l'objectif ; soumission : nombre d'ordres */
+    uint8_t ordres[JOURNAL_ORDRES_MAX / 2];
+} EvenementJournal;
+
+/**
+ * @struct EnteteSegment
+ * @brief Début de chaque segment, suivi des événements
+ */
+typedef struct {
+    char magie[4];                /* JOURNAL_MAGIE */
+    uint32_t tailleEvenement;     /* sizeof(EvenementJournal), vérifié à la lecture */
+    uint32_t numero;              /* Numéro du segment, à partir de 1 */
+    uint32_t reserve;
+    uint64_t graine;              /* Graine de la partie ou du tournoi */
+} EnteteSegment;
+
+/**
+ * @struct CaseJournal
+ * @brief Case de l'anneau : son numéro de passage dit si elle est libre ou pleine
+ */
+typedef struct {
+    atomic_size_t sequence;
+    EvenementJournal evenement;
+} CaseJournal;
+
+/**
+ * @struct Journal
+ * @brief Journal binaire des tours, soumissions et verdicts. Les événements sont déposés sans
+ *        verrou dans un anneau borné à plusieurs producteurs ; un fil écrivain le vide dans des
+ *        segments <prefixe>.000001, <prefixe>.000002... Quand l'anneau est plein, l'événement
+ *        est compté comme perdu plutôt que de faire attendre la partie
+ */
+typedef struct {
+    CaseJournal* cases;
+    atomic_size_t entree;         /* Prochaine case à réserver (producteurs) */
+    size_t sortie;                /* Prochaine case à lire (écrivain seul) */
+    atomic_llong perdus;          /* Événements refusés faute de place */
+    atomic_int arret;
+    char* prefixe;
+    uint64_t graine;
+    FILE* segment;                /* Segment en cours */
+    uint32_t numeroSegment;
+    long octetsSegment;
+    long long nbEcrits;
+    thrd_t ecrivain;
+} Journal;
+
+
+
+/**
+ * @brief Ouvre le premier segment et démarre le fil écrivain
+ * @param[out] j Le journal
+ * @param[in] prefixe Chemin des segments, complété par leur numéro
+ * @param[in] graine Graine écrite dans l'en-tête de chaque segment
+ * @return int 1 si le journal est prêt, 0 si le segment ou le fil n'a pas pu être créé
+ */
+int ouvrirJournal(Journal* j, const char* prefixe, uint64_t graine);
+
+/**
+ * @brief Arrête l'écrivain après qu'il a tout écrit, synchronise et ferme le dernier segment
+ * @param[in,out] j Le journal
+ * @return long long Nombre d'événements perdus faute de place dans l'anneau
+ */
+long long fermerJournal(Journal* j);
+
+/**
+ * @brief Dépose un événement, sans attendre. Peut être appelée depuis plusieurs fils
+ * @param[in,out] j Le journal, NULL pour ne rien journaliser
+ * @param[in] e L'événement
+ * @return int 1 si déposé, 0 si l'anneau est plein
+ */
+int journaliser(Journal* j, const EvenementJournal* e);
+
+/**
+ * @brief Journalise le début d'un tour
+ * @param[in,out] j Le journal, ou NULL
+ * @param[in] config La configuration, pour le rang des cartes
+ * @param[in] partie Numéro de la partie
+ * @param[in] tour Numéro du tour
+ * @param[in] courant Position de départ
+ * @param[in] objectif Objectif du tour
+ */
+void journaliserTour(Journal* j, const ConfigJeu* config, uint32_t partie, uint32_t tour,
+                     const EtatJeu* courant, const EtatJeu* objectif);
+
+/**
+ * @brief Journalise une soumission jugée puis son verdict
+ * @param[in,out] j Le journal, ou NULL
+ * @param[in] config La configuration, pour le code des ordres
+ * @param[in] partie Numéro de la partie
+ * @param[in] tour Numéro du tour
+ * @param[in] s La soumission, déjà jugée
+ */
+void journaliserSoumission(Journal* j, const ConfigJeu* config, uint32_t partie, uint32_t tour, const Soumission* s);
+
+/**
+ * @brief Journalise un point marqué
+ * @param[in,out] j Le journal, ou NULL
+ * @param[in] partie Numéro de la partie
+ * @param[in] tour Numéro du tour
+ * @param[in] joueur Indice du joueur
+ * @param[in] forfait 1 si le joueur était le seul encore en lice
+ */
+void journaliserPoint(Journal* j, uint32_t partie, uint32_t tour, int joueur, int forfait);
+
+/**
+ * @brief Écrit les événements de segments au format CSV, une ligne par événement, les ordres
+ *        écrits avec leur nom (macros : M suivi de leur indice dans la configuration)
+ * @param[in] chemins Chemins des segments, dans l'ordre
+ * @param[in] nb Nombre de segments
+ * @param[in,out] sortie Flux CSV
+ * @return int 1 si tous les segments ont été lus, 0 si l'un d'eux est absent ou invalide
+ */
+int convertirJournalCsv(char** chemins, int nb, FILE* sortie);
@@ -0,0 +1,143 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "lecture.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Prépare le lecteur
+ * @param[out] l Le lecteur
+ * @param[in] flux Le flux à lire
+ */
+void initLecteur(Lecteur* l, FILE* flux) {
+#ifdef _WIN32
+    l->descripteur = _fileno(flux);
+#else
+    l->descripteur = fileno(flux);
+#endif
+    l->capacite = TAILLE_BLOC;
+    l->tampon = (char*)allouerMem(MEM_DIVERS, l->capacite);
+    if (l->tampon == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour la lecture.\n");
+        exit(EXIT_FAILURE);
+    }
+    l->debut = 0;
+    l->fin = 0;
+    l->finFlux = 0;
+}
+
+/**
+ * @brief Libère le lecteur
+ * @param[in,out] l Le lecteur
+ */
+void libererLecteur(Lecteur* l) {
+    libererMem(l->tampon);
+    l->tampon = NULL;
+    l->capacite = 0;
+}
+
+/**
+ * @brief Ramène la ligne entamée au début du tampon, l'agrandit si besoin, puis lit un bloc.
+ *        read() rend ce qui est disponible sans attendre que le bloc soit plein
+ */
+static void remplir(Lecteur* l) {
+    size_t reste = l->fin - l->debut;
+    if (l->debut > 0) {
+        memmove(l->tampon, l->tampon + l->debut, reste);
+        l->debut = 0;
+        l->fin = reste;
+    }
+
+    if (l->fin == l->capacite) {
+        char* nouv = (char*)reallouerMem(MEM_DIVERS, l->tampon, l->capacite * 2);
+        if (nouv == NULL) {
+            fprintf(stderr, "Erreur fatale : Memoire insuffisante pour la lecture.\n");
+            exit(EXIT_FAILURE);
+        }
+        l->tampon = nouv;
+        l->capacite *= 2;
+    }
+
+    for (;;) {
+#ifdef _WIN32
+        int n = _read(l->descripteur, l->tampon + l->fin, (unsigned int)(l->capacite - l->fin));
+#else
+        ssize_t n = read(l->descripteur, l->tampon + l->fin, l->capacite - l->fin);
+#endif
+        if (n > 0) {
+            l->fin += (size_t)n;
+            return;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        l->finFlux = 1;
+        return;
+    }
+}
+
+/**
+ * @brief Donne la ligne suivante
+ * @param[in,out] l Le lecteur
+ * @param[out] ligne La vue sur la ligne
+ * @return int 1 si une ligne a été lue, 0 sinon
+ */
+int lireLigne(Lecteur* l, Vue* ligne) {
+    size_t cherche = l->debut;
+
+    for (;;) {
+        const char* nl = (const char*)memchr(l->tampon + cherche, '\n', l->fin - cherche);
+        if (nl != NULL) {
+            ligne->debut = l->tampon + l->debut;
+            ligne->longueur = (size_t)(nl - ligne->debut);
+            l->debut = (size_t)(nl - l->tampon) + 1;
+            return 1;
+        }
+
+        if (l->finFlux) {
+            /* Dernière ligne sans '\n' */
+            if (l->fin > l->debut) {
+                ligne->debut = l->tampon + l->debut;
+                ligne->longueur = l->fin - l->debut;
+                l->debut = l->fin;
+                return 1;
+            }
+            return 0;
+        }
+
+        /* Ce qui a déjà été parcouru n'a pas de '\n', inutile de le relire */
+        size_t dejaVu = l->fin - l->debut;
+        remplir(l);
+        cherche = l->debut + dejaVu;
+    }
+}
+
+/**
+ * @brief Découpe une ligne en champs
+ * @param[in] ligne La ligne
+ * @param[out] champs Les champs trouvés
+ * @param[in] maxChamps Nombre maximum de champs
+ * @return int Nombre de champs
+ */
+int decouperVue(Vue ligne, Vue* champs, int maxChamps) {
+    const char* p = ligne.debut;
+    const char* fin = ligne.debut + ligne.longueur;
+    int n = 0;
+
+    while (n < maxChamps) {
+        while (p < fin && *p == ' ') p++;
+        if (p == fin) break;
+
+        const char* debut = p;
+        while (p < fin && *p != ' ') p++;
+        champs[n].debut = debut;
+        champs[n].longueur = (size_t)(p - debut);
+        n++;
+    }
+    return n;
+}
\ No newline at end of file
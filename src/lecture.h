@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+ * @def TAILLE_BLOC
+ * @brief Taille initiale du tampon de lecture
+ */
+#define TAILLE_BLOC 65536
+
+/**
+ * @struct Vue
+ * @brief Morceau de texte désigné sans copie : il n'est pas terminé par '\0'
+ */
+typedef struct {
+    const char* debut;
+    size_t longueur;
+} Vue;
+
+/**
+ * @struct Lecteur
+ * @brief Lit un flux par gros blocs et le découpe en lignes directement dans son tampon
+ */
+typedef struct {
+    int descripteur;  /* Descripteur du flux lu */
+    char* tampon;
+    size_t capacite;
+    size_t debut;     /* Début de la prochaine ligne dans le tampon */
+    size_t fin;       /* Fin des octets lus */
+    int finFlux;      /* 1 quand le flux est épuisé */
+} Lecteur;
+
+
+
+/**
+ * @brief Prépare la lecture d'un flux par blocs
+ * @param[out] l Pointeur vers le lecteur
+ * @param[in] flux Flux à lire. Il ne doit plus être lu par stdio ensuite
+ */
+void initLecteur(Lecteur* l, FILE* flux);
+
+/**
+ * @brief Libère le tampon du lecteur (le flux n'est pas fermé)
+ * @param[in,out] l Pointeur vers le lecteur
+ */
+void libererLecteur(Lecteur* l);
+
+/**
+ * @brief Donne la ligne suivante sans son '\n'. Une ligne à cheval sur deux blocs est recollée
+ *        dans le tampon. La vue reste valide jusqu'au prochain appel
+ * @param[in,out] l Pointeur vers le lecteur
+ * @param[out] ligne Vue sur la ligne lue
+ * @return int 1 si une ligne a été lue, 0 à la fin du flux
+ */
+int lireLigne(Lecteur* l, Vue* ligne);
+
+/**
+ * @brief Découpe une ligne en champs séparés par des espaces, sans copie
+ * @param[in] ligne La ligne à découper
+ * @param[out] champs Tableau recevant les vues sur chaque champ
+ * @param[in] maxChamps Nombre maximum de champs à extraire
+ * @return int Le nombre de champs trouvés
+ */
+int decouperVue(Vue ligne, Vue* champs, int maxChamps);
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "liste.h"
+#include "memoire.h"
 
 
  /**
@@ -31,7 +32,7 @@ int listeEstVide(const Liste* l) {
  * @param[in] val La valeur à stocker
  */
 void insererTete(Liste* l, Element val) {
-    Cellule* nouv = (Cellule*)malloc(sizeof(Cellule));
+    Cellule* nouv = (Cellule*)allouerMem(sousSystemeCellules(), sizeof(Cellule));
 
     if (nouv == NULL) {
         fprintf(stderr, "Erreur fatale : Echec d'allocation memoire dans insererTete\n");
@@ -58,7 +59,7 @@ Element supprimerTete(Liste* l) {
     Element valeur = aSupprimer->valeur; 
 
     l->tete = aSupprimer->suivant;   
-    free(aSupprimer);                
+    libererMem(aSupprimer);                
     l->taille--;
 
     return valeur;
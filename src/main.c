@@ -6,273 +6,583 @@
 #include <string.h>
 #include <time.h>
 #include "jeu.h"
+#include "affichage.h"
+#include "joueurs.h"
+#include "lecture.h"
+#include "rejeu.h"
+#include "classement.h"
+#include "soumission.h"
+#include "robot.h"
+#include "partie.h"
+#include "tournoi.h"
+#include "sondes.h"
+#include "memoire.h"
+#include "composantes.h"
+#include "distances.h"
+#include "denombrement.h"
+#include "journal.h"
+#include "reprise.h"
+#include "effets.h"
 
 
-#define MAX_JOUEURS 10
-#define LEN_CMD 256
 #define CONFIG_FILENAME "crazy.cfg"
 
+
 /**
- * @struct Joueur
- * @brief Reprsente un participant  la partie
+ * @struct Entree
+ * @brief Ce dont le fil de lecture a besoin
  */
 typedef struct {
-    char* nom;  /* Pointeur vers le nom (argv) */
-    int score;  /*Score courant */
-} Joueur;
-
+    FileSoumissions* file;   /* File ou deposer les soumissions */
+    Lecteur* lecteur;        /* Flux deja ouvert (stdin ou session rejouee) */
+    int parTour;             /* 1 si chaque ligne commence par son tour et son rang (session rejouee) */
+} Entree;
 
 /**
- * @brief Fonction de comparaison pour le tri des scores
+ * @brief Fil de lecture : lit l'entree par blocs, horodate chaque ligne et la depose dans la file
+ * @param[in] arg L'Entree a lire
+ * @return int 0
  */
-int compareJoueurs(const void* a, const void* b) {
-    const Joueur* j1 = (const Joueur*)a;
-    const Joueur* j2 = (const Joueur*)b;
-
-    if (j1->score != j2->score) {
-        return j2->score - j1->score;
-    }
-    return strcmp(j1->nom, j2->nom);
-}
-
-
-
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        printf("Usage: %s <Joueur1> <Joueur2> ...\n", argv[0]);
-        printf("Erreur : Il faut au moins 2 joueurs pour lancer la partie.\n");
-        return EXIT_FAILURE;
-    }
+static int lireEntree(void* arg) {
+    Entree* entree = (Entree*)arg;
+    FileSoumissions* file = entree->file;
+
+    for (;;) {
+        Soumission* s = (Soumission*)allouerMemZero(MEM_SOUMISSIONS, 1, sizeof(Soumission));
+        if (s == NULL) {
+            fprintf(stderr, "Erreur fatale : Echec d'allocation memoire dans lireEntree\n");
+            exit(EXIT_FAILURE);
+        }
 
-    Joueur joueurs[MAX_JOUEURS];
-    int nbJoueurs = 0;
+        Vue ligne;
+        if (lireLigne(entree->lecteur, &ligne)) {
+            /* La ligne n'est arbitree que dans le tour ou elle l'a ete a l'enregistrement */
+            if (entree->parTour && !lireLigneSession(&ligne, &s->tour)) s->tour = 0;
 
-    /* Rcupration des noms depuis la ligne de commande */
-    for (int i = 1; i < argc; i++) {
-        if (nbJoueurs >= MAX_JOUEURS) {
-            printf("Attention: Nombre maximum de joueurs (%d) atteint. Les suivants sont ignores.\n", MAX_JOUEURS);
-            break;
+            /* Seule copie de la ligne : le tampon du lecteur est reutilise au prochain bloc */
+            s->longueur = (ligne.longueur < LEN_CMD) ? ligne.longueur : LEN_CMD - 1;
+            memcpy(s->ligne, ligne.debut, s->longueur);
         }
-
-        /* Vrification des doublons de noms */
-        int existe = 0;
-        for (int k = 0; k < nbJoueurs; k++) {
-            if (strcmp(joueurs[k].nom, argv[i]) == 0) {
-                existe = 1;
-                break;
-            }
+        else {
+            s->fin = 1;
         }
-        if (existe) {
-            printf("Erreur: Les noms des joueurs doivent etre distincts (%s).\n", argv[i]);
-            return EXIT_FAILURE;
+        s->horodatage = horodatageNs();
+        /* Lu avant le depot : le consommateur peut liberer s aussitot */
+        int fin = s->fin;
+        deposerSoumission(file, s);
+
+        if (fin) {
+            libererLecteur(entree->lecteur);
+            return 0;
         }
-
-        /* Initialisation du joueur */
-        joueurs[nbJoueurs].nom = argv[i];
-        joueurs[nbJoueurs].score = 0;
-        nbJoueurs++;
     }
+}
 
+/**
+ * @brief Joue un tournoi entre robots avec 1, 2, 4... fils jusqu'au nombre de coeurs, puis affiche
+ *        l'efficacite de chaque repartition et le cumul par strategie
+ * @param[in] t Le tournoi
+ */
+static void lancerTournoi(const Tournoi* t) {
+    ResultatStrategie* resultats = (ResultatStrategie*)allouerMem(MEM_DIVERS, sizeof(ResultatStrategie) * t->nbStrategies);
+    if (resultats == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le tournoi.\n");
+        exit(EXIT_FAILURE);
+    }
 
+    int nbCoeurs = nombreCoeurs();
+    double reference = 0.0;
 
-    ConfigJeu config;
+    printf("Tournoi : %ld parties, %d strategies\n", t->nbParties, t->nbStrategies);
+    printf("Fils | Parties/s | Acceleration | Efficacite\n");
+    for (int nbFils = 1; ; nbFils = (2 * nbFils < nbCoeurs) ? 2 * nbFils : nbCoeurs) {
+        double secondes = jouerTournoi(t, nbFils, resultats);
+        if (secondes <= 0) secondes = 1e-9;
+        double debit = t->nbParties / secondes;
+        if (nbFils == 1) reference = debit;
 
-    if (!chargerConfiguration(&config, CONFIG_FILENAME)) {
-        fprintf(stderr, "Erreur fatale : Impossible de lire le fichier de configuration %s.\n", CONFIG_FILENAME);
-        return EXIT_FAILURE;
-    }
-    if (!validerConfiguration(&config)) {
-        libererConfiguration(&config);
-        return EXIT_FAILURE;
+        printf("%4d | %9.1f | %12.2f | %8.0f %%\n", nbFils, debit, debit / reference, 100.0 * debit / reference / nbFils);
+        if (nbFils == nbCoeurs) break;
     }
 
+    printf("\nStrategie | Parties | Victoires | Points/partie\n");
+    for (int s = 0; s < t->nbStrategies; s++) {
+        printf("%s | %ld | %ld | %.2f\n", t->strategies[s], resultats[s].parties, resultats[s].victoires,
+               resultats[s].parties > 0 ? (double)resultats[s].points / resultats[s].parties : 0.0);
+    }
+    libererMem(resultats);
+}
 
-  
-
-    srand((unsigned int)time(NULL)); 
 
-    /* Gnration du paquet complet des positions */
-    Deck deck;
-    genererToutesPositions(&config, &deck);
 
-    /* Affichage des ordres disponibles*/
-    afficherOrdresPossibles(&config);
 
-    /* Tirage des tats initiaux */
-    EtatJeu* courant = tirerNouvelleCarte(&deck); /* Position de dpart */
-    EtatJeu* objectif = tirerNouvelleCarte(&deck); /* Position objectif */
+/**
+ * @brief Ferme le journal et signale sur l'erreur standard les evenements perdus faute de place
+ * @param[in,out] journal Le journal ouvert
+ */
+static void fermerJournalEtSignaler(Journal* journal) {
+    long long perdus = fermerJournal(journal);
+    if (perdus > 0) fprintf(stderr, "Journal : %lld evenement(s) perdu(s), anneau plein.\n", perdus);
+}
 
-    if (courant == NULL || objectif == NULL) {
-        printf("Erreur : Pas assez de combinaisons pour jouer.\n");
-        return EXIT_FAILURE;
+/**
+ * @brief Denombre les solutions de toutes les paires de cartes et affiche, pour chaque longueur
+ *        de plus courte solution, le nombre de paires et le nombre de solutions par paire
+ * @param[in] config La configuration validee
+ * @param[in] longueurMax Longueur maximale des solutions comptees
+ */
+static void afficherSolutions(const ConfigJeu* config, int longueurMax) {
+    StatistiquesSolutions st;
+    unsigned long long debut = horodatageNs();
+    denombrerDeck(config, longueurMax, nombreCoeurs(), &st);
+    double secondes = (double)(horodatageNs() - debut) / 1e9;
+
+    printf("Solutions de longueur <= %d, toutes paires de cartes (%d animaux, %.2f s)\n", st.longueurMax,
+           config->nbAnimaux, secondes);
+    printf("Distance | Paires | Min | Moyenne | Max | Saturees\n");
+    for (int d = 0; d <= st.longueurMax; d++) {
+        const LigneSolutions* l = &st.lignes[d];
+        if (l->nbPaires == 0) continue;
+        printf("%d | %llu | %llu | %.4g | %llu | %llu\n", d, (unsigned long long)l->nbPaires, (unsigned long long)l->min,
+               l->somme / (double)l->nbPaires, (unsigned long long)l->max, (unsigned long long)l->nbSaturees);
     }
+}
 
-    int* peutJouer = (int*)malloc(sizeof(int) * nbJoueurs);
-    for (int i = 0; i < nbJoueurs; i++) peutJouer[i] = 1;
-    int nbJoueursEnLice = nbJoueurs;
-
-
- 
-    while (objectif != NULL) {
-
-        afficherDuel(courant, objectif);
 
-        int tourTermine = 0;
 
 
-        while (!tourTermine) {
-            char buffer[LEN_CMD];
+int main(int argc, char* argv[]) {
+    const char* fichierRejeu = NULL;
+    const char* fichierEnregistrement = NULL;
+    long nbPartiesTournoi = 0;
+    int afficherMemoire = 0;
+    int distanceMin = -1, distanceMax = -1;
+    int longueurSolutions = -1;
+    const char* prefixeJournal = NULL;
+    const char* fichierReprise = NULL;
+    int capaciteEffets = EFFETS_CAPACITE;
+    int delaiTour = 0, delaiInactivite = 0;
+    int avecAnticipation = 0;
+    uint64_t graine = (uint64_t)time(NULL);
+
+    Registre registre;
+    initRegistre(&registre);
 
-            if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
-                tourTermine = 1;
-                objectif = NULL;
-                break;
+    ConfigJeu config;
+    Session session;
+    Lecteur lecteur;
+    PointReprise reprise;
+    Journal journal;
+    CacheEffets effets;
+    Solveur solveur;
+    Statistiques stats;
+    Deck deck;
+    Distances distances;
+    Rendu rendu;
+    Classement classement;
+    PoolJuges juges;
+    Anticipation anticipation;
+
+    /* Toutes les sorties passent par fin, qui rend ce qui a t pris : chaque pointeur reste NULL
+       tant que ce qu'il dsigne n'est pas initialis */
+    int code = EXIT_FAILURE;
+    ConfigJeu* pConfig = NULL;      /* Configuration lue dans crazy.cfg ; en rejeu, la session la possde */
+    Session* pSession = NULL;
+    Lecteur* pLecteur = NULL;       /* Lecteur pas encore confi au fil de lecture */
+    FILE* fichierSession = NULL;
+    PointReprise* pReprise = NULL;
+    Robot* robots = NULL;
+    Journal* pJournal = NULL;
+    CacheEffets* pEffets = NULL;
+    char** strategies = NULL;
+    Solveur* pSolveur = NULL;
+    FILE* enregistrement = NULL;
+    Statistiques* pStats = NULL;
+    Deck* pDeck = NULL;
+    Distances* pDistances = NULL;
+    Rendu* pRendu = NULL;
+    Classement* pClassement = NULL;
+    PoolJuges* pJuges = NULL;
+    Anticipation* pAnticipation = NULL;
+
+    /* Rcupration des options et des noms depuis la ligne de commande */
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rejouer") == 0 && i + 1 < argc) {
+            fichierRejeu = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--enregistrer") == 0 && i + 1 < argc) {
+            fichierEnregistrement = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            graine = (uint64_t)strtoull(argv[++i], NULL, 10);
+            continue;
+        }
+        if (strcmp(argv[i], "--sondes") == 0) {
+            activerSondes(1);
+            continue;
+        }
+        if (strcmp(argv[i], "--memoire") == 0) {
+            afficherMemoire = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--difficulte") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d:%d", &distanceMin, &distanceMax) != 2 || distanceMin < 0 || distanceMax < distanceMin) {
+                printf("Erreur: Bande de difficulte invalide (%s), attendu <min>:<max>.\n", argv[i]);
+                goto fin;
             }
-            buffer[strcspn(buffer, "\n")] = 0;
-
-            if (strlen(buffer) == 0) continue;
-
-            char* nomJoueur = strtok(buffer, " ");
-            char* sequence = strtok(NULL, " ");
-
-            int idJoueur = -1;
-            for (int i = 0; i < nbJoueurs; i++) {
-                if (strcmp(joueurs[i].nom, nomJoueur) == 0) {
-                    idJoueur = i;
-                    break;
-                }
+            continue;
+        }
+        if (strcmp(argv[i], "--solutions") == 0 && i + 1 < argc) {
+            longueurSolutions = atoi(argv[++i]);
+            if (longueurSolutions < 0 || longueurSolutions > LONGUEUR_MAX_DENOMBREE) {
+                printf("Erreur: Longueur de solution invalide (%s), attendu 0 a %d.\n", argv[i], LONGUEUR_MAX_DENOMBREE);
+                goto fin;
             }
-
-            if (idJoueur == -1) {
-                printf("Joueur inconnu (%s)\n", nomJoueur);
-                continue; 
+            continue;
+        }
+        if (strcmp(argv[i], "--cache-effets") == 0 && i + 1 < argc) {
+            capaciteEffets = atoi(argv[++i]);
+            continue;
+        }
+        if ((strcmp(argv[i], "--delai-tour") == 0 || strcmp(argv[i], "--inactivite") == 0) && i + 1 < argc) {
+            double secondes = atof(argv[i + 1]);
+            if (secondes <= 0.0 || secondes > 86400.0) {
+                printf("Erreur: Delai invalide (%s), attendu une duree en secondes.\n", argv[i + 1]);
+                goto fin;
             }
+            if (strcmp(argv[i], "--delai-tour") == 0) delaiTour = (int)(secondes * 1000.0 + 0.5);
+            else delaiInactivite = (int)(secondes * 1000.0 + 0.5);
+            i++;
+            continue;
+        }
+        if (strcmp(argv[i], "--anticipation") == 0) {
+            avecAnticipation = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--reprise") == 0 && i + 1 < argc) {
+            fichierReprise = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            prefixeJournal = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--journal-csv") == 0 && i + 1 < argc) {
+            /* Tous les arguments suivants sont des segments, convertis sans lancer de partie */
+            code = convertirJournalCsv(argv + i + 1, argc - i - 1, stdout) ? EXIT_SUCCESS : EXIT_FAILURE;
+            goto fin;
+        }
+        if (strcmp(argv[i], "--tournoi") == 0 && i + 1 < argc) {
+            nbPartiesTournoi = atol(argv[++i]);
+            continue;
+        }
 
-            if (!peutJouer[idJoueur]) {
-                printf("%s ne peut pas jouer durant ce tour\n", nomJoueur);
-                continue;
-            }
+        /* Inscription du joueur, refuse si le nom est dj pris */
+        if (ajouterJoueur(&registre, argv[i]) < 0) {
+            printf("Erreur: Les noms des joueurs doivent etre distincts (%s).\n", argv[i]);
+            goto fin;
+        }
+    }
 
-            if (sequence == NULL) {
-                continue;
+    if (fichierRejeu != NULL) {
+        /* Rejeu : joueurs, configuration et graine viennent de la session enregistre */
+        if (registre.nbJoueurs > 0 || (fichierSession = fopen(fichierRejeu, "rb")) == NULL) {
+            printf("Usage: %s --rejouer <session>\n", argv[0]);
+            goto fin;
+        }
+        initLecteur(&lecteur, fichierSession);
+        pLecteur = &lecteur;
+        int enteteLue = lireEnteteSession(&lecteur, &session);
+        pSession = &session;
+        if (!enteteLue) {
+            fprintf(stderr, "Erreur fatale : En-tete de session invalide dans %s.\n", fichierRejeu);
+            goto fin;
+        }
+        for (int i = 0; i < session.nbJoueurs; i++) {
+            if (ajouterJoueur(&registre, session.nomsJoueurs[i]) < 0) {
+                printf("Erreur: Les noms des joueurs doivent etre distincts (%s).\n", session.nomsJoueurs[i]);
+                goto fin;
             }
+        }
+        config = session.config;
+        graine = session.graine;
+        distanceMin = session.distanceMin;
+        distanceMax = session.distanceMax;
+    }
+    else if (chargerConfiguration(&config, CONFIG_FILENAME)) {
+        pConfig = &config;
+    }
+    else {
+        fprintf(stderr, "Erreur fatale : Impossible de lire le fichier de configuration %s.\n", CONFIG_FILENAME);
+        goto fin;
+    }
 
+    /* Statistiques des cartes : ni joueurs ni partie */
+    if (longueurSolutions >= 0) {
+        int valide = validerConfiguration(&config);
+        if (valide) {
+            config.noyau = choisirNoyau(config.nbAnimaux);
+            afficherSolutions(&config, longueurSolutions);
+        }
+        if (afficherMemoire) ecrireMemoire(stderr);
+        code = valide ? EXIT_SUCCESS : EXIT_FAILURE;
+        goto fin;
+    }
 
+    if (registre.nbJoueurs < 2) {
+        printf("Usage: %s [--seed <graine>] [--difficulte <min>:<max>] [--enregistrer <session>] <Joueur1> <Joueur2> ...\n", argv[0]);
+        printf("       %s --rejouer <session>\n", argv[0]);
+        printf("       %s --solutions <longueurMax>\n", argv[0]);
+        printf("       %s [--seed <graine>] [--difficulte <min>:<max>] --tournoi <nbParties> bot:... bot:...\n", argv[0]);
+        printf("       %s --reprise <fichier> [--seed <graine>] <Joueur1> <Joueur2> ...\n", argv[0]);
+        printf("       %s [--delai-tour <secondes>] [--inactivite <secondes>] [--anticipation] <Joueur1> <Joueur2> ...\n", argv[0]);
+        printf("       %s --journal-csv <segment> ...\n", argv[0]);
+        printf("Erreur : Il faut au moins 2 joueurs pour lancer la partie.\n");
+        goto fin;
+    }
+    if (!validerConfiguration(&config)) goto fin;
+    compilerMacros(&config);
+    /* Le seul choix du noyau : solveur, composantes et distances le reprennent dans la configuration */
+    config.noyau = choisirNoyau(config.nbAnimaux);
+
+    /* Un rejeu ne reproduirait pas les delais, et les robots d'un tournoi repondent sans attendre */
+    if ((delaiTour > 0 || delaiInactivite > 0) && (fichierRejeu != NULL || nbPartiesTournoi > 0)) {
+        printf("Erreur : --delai-tour et --inactivite ne s'appliquent qu'a une partie, ni rejouee ni en tournoi.\n");
+        goto fin;
+    }
+    /* Les parties d'un tournoi occupent deja tous les coeurs */
+    if (avecAnticipation && nbPartiesTournoi > 0) {
+        printf("Erreur : --anticipation ne s'applique pas a un tournoi.\n");
+        goto fin;
+    }
 
-            EtatJeu testState;
-            initEtat(&testState);
-            copierEtat(courant, &testState);
-
-            int codeRetour = executerSequence(&testState, sequence);
-
-            if (codeRetour == -1) {
-
-                char ordreFaux[3] = "??";
-                for (size_t i = 0; i < strlen(sequence); i += 2) {
-                    char sub[3];
-                    sub[0] = sequence[i];
-                    sub[1] = sequence[i + 1];
-                    sub[2] = '\0';
+    /* Un point de reprise existant fixe la graine ; la configuration et les joueurs sont verifies plus loin */
+    int etatReprise = REPRISE_ABSENTE;
+    if (fichierReprise != NULL) {
+        if (fichierRejeu != NULL || nbPartiesTournoi > 0) {
+            printf("Erreur : --reprise ne s'applique qu'a une partie, ni rejouee ni en tournoi.\n");
+            goto fin;
+        }
+        etatReprise = lireReprise(fichierReprise, &reprise);
+        if (etatReprise == REPRISE_INVALIDE) {
+            fprintf(stderr, "Erreur fatale : Point de reprise %s illisible ou corrompu.\n", fichierReprise);
+            goto fin;
+        }
+        if (etatReprise == REPRISE_LUE) pReprise = &reprise;
+        if (etatReprise == REPRISE_LUE && fichierEnregistrement != NULL) {
+            printf("Erreur : Une partie reprise ne peut pas etre enregistree depuis son debut.\n");
+            goto fin;
+        }
+        if (etatReprise == REPRISE_LUE) graine = reprise.graine;
+    }
 
-                    int estValide = 0;
-                    if (strcmp(sub, "KI") == 0 || strcmp(sub, "LO") == 0 ||
-                        strcmp(sub, "SO") == 0 || strcmp(sub, "NI") == 0 ||
-                        strcmp(sub, "MA") == 0) {
-                        estValide = 1;
-                    }
+    /* Les joueurs dont le nom commence par "bot:" sont tenus par le programme */
+    robots = (Robot*)allouerMem(MEM_JOUEURS, sizeof(Robot) * registre.nbJoueurs);
+    if (robots == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les robots.\n");
+        goto fin;
+    }
+    int tousRobots = 1;
+    for (int i = 0; i < registre.nbJoueurs; i++) {
+        if (!lireRobot(registre.joueurs[i].nom, &robots[i])) {
+            printf("Erreur: Robot inconnu ou nom de plus de %d caracteres (%s). Utiliser bot:optimal ou bot:random:<probabilite>.\n",
+                   NOM_ROBOT_MAX, registre.joueurs[i].nom);
+            goto fin;
+        }
+        if (robots[i].type == ROBOT_AUCUN) tousRobots = 0;
+    }
+    /* Avant la creation des autres fils, qui doivent tous masquer SIGUSR1 */
+    if (atomic_load(&sondesActives)) ecouterSignalSondes(stderr);
+
+    /* Tours, soumissions et verdicts ecrits en binaire par un fil dedie, sans ralentir l'arbitre */
+    if (prefixeJournal != NULL) {
+        if (!ouvrirJournal(&journal, prefixeJournal, graine)) {
+            fprintf(stderr, "Erreur fatale : Impossible d'ouvrir le journal %s.\n", prefixeJournal);
+            goto fin;
+        }
+        pJournal = &journal;
+    }
 
-                    if (!estValide) {
-                        strcpy(ordreFaux, sub);
-                        break;
-                    }
-                }
-                printf("L'ordre %s n'existe pas\n", ordreFaux);
-            }
+    /* Les sequences deja jugees depuis la meme hauteur sont verifiees sans etre executees */
+    if (capaciteEffets > 0) {
+        initCacheEffets(&effets, capaciteEffets);
+        pEffets = &effets;
+    }
 
-            /* Vrification de la victoire */
-            int bonneSolution = 0;
-            if (codeRetour == 1) {
-                if (estMemeEtat(&testState, objectif)) {
-                    bonneSolution = 1;
-                }
-            }
+    /* Sur l'erreur standard pour ne pas se meler aux verdicts : --seed rejoue la meme partie */
+    if (fichierRejeu == NULL) fprintf(stderr, "Graine : %llu\n", (unsigned long long)graine);
 
-            libererEtat(&testState);
+    if (nbPartiesTournoi > 0) {
+        if (!tousRobots) {
+            printf("Erreur : Un tournoi ne se joue qu'entre robots.\n");
+            goto fin;
+        }
+        /* Modele copie par chaque partie */
+        genererToutesPositions(&config, &deck);
+        pDeck = &deck;
+        calculerComposantes(&deck, &config, nombreCoeurs());
+        if (distanceMin >= 0 && calculerDistances(&distances, &deck, &config, nombreCoeurs())) pDistances = &distances;
+        strategies = (char**)allouerMem(MEM_JOUEURS, sizeof(char*) * registre.nbJoueurs);
+        if (strategies == NULL) goto fin;
+        for (int i = 0; i < registre.nbJoueurs; i++) strategies[i] = registre.joueurs[i].nom;
+        Tournoi tournoi = { &config, &deck, strategies, robots, registre.nbJoueurs, nbPartiesTournoi, graine, pDistances,
+                            distanceMin, distanceMax, pJournal, pEffets };
+
+        lancerTournoi(&tournoi);
+        if (pEffets != NULL) ecrireCacheEffets(pEffets, stdout);
+        if (pJournal != NULL) fermerJournalEtSignaler(pJournal);
+        pJournal = NULL;
+        if (atomic_load(&sondesActives)) ecrireSondes(stderr);
+        if (afficherMemoire) ecrireMemoire(stderr);
+        code = EXIT_SUCCESS;
+        goto fin;
+    }
 
-            if (bonneSolution) {
-                /* VICTOIRE DU JOUEUR */
-                printf("%s gagne un point\n\n", nomJoueur);
-                joueurs[idJoueur].score++;
-                tourTermine = 1;
-            }
-            else {
-
-                if (codeRetour != -1) {
-                    printf("La sequence ne conduit pas a la situation attendue\n");
-                    printf("%s ne peut plus jouer durant ce tour\n", nomJoueur);
-                    peutJouer[idJoueur] = 0;
-                    nbJoueursEnLice--;
-                }
-
-
-                if (nbJoueursEnLice == 1) {
-                    int survivant = -1;
-                    for (int i = 0; i < nbJoueurs; i++) {
-                        if (peutJouer[i]) {
-                            survivant = i;
-                            break;
-                        }
-                    }
-                    /* agne par forfait */
-                    printf("%s gagne un point car lui seul peut encore jouer durant ce tour\n\n", joueurs[survivant].nom);
-                    joueurs[survivant].score++;
-                    tourTermine = 1;
-                }
-                else if (nbJoueursEnLice == 0) {
-                    printf("Tous les joueurs ont echoue. Fin du tour sans vainqueur.\n\n");
-                    tourTermine = 1;
-                }
-            }
+    initSolveur(&solveur, &config);
+    pSolveur = &solveur;
 
-        } 
+    if (fichierEnregistrement != NULL) {
+        enregistrement = fopen(fichierEnregistrement, "w");
+        if (enregistrement == NULL) {
+            fprintf(stderr, "Erreur fatale : Impossible de creer %s.\n", fichierEnregistrement);
+            goto fin;
+        }
+        ecrireEnteteSession(enregistrement, graine, &registre, &config, distanceMin, distanceMax);
+    }
+    if (fichierRejeu == NULL) {
+        initLecteur(&lecteur, stdin);
+        pLecteur = &lecteur;
+    }
 
+    /* Le rejeu et les parties entre robots n'affichent que les verdicts, puis les mesures */
+    int silencieux = (fichierRejeu != NULL || tousRobots);
+    initStatistiques(&stats);
+    pStats = &stats;
 
-        /* Prparation du Tour Suivant */
-        if (objectif != NULL) {
-            /* L'objectif atteint devient le nouveau point de dpart */
-            courant = objectif;
-             /* Tirage d'un nouvel objectif */
-            objectif = tirerNouvelleCarte(&deck);
+    /* Gnration du paquet complet des positions */
+    int aDistances = (distanceMin >= 0);
+    /* Une partie reprise n'attend pas le deck : il est gnr pendant le tour repris */
+    DeckDiffere differe = { 0 };
+    differe.config = &config;
+    differe.deck = &deck;
+    differe.distances = aDistances ? &distances : NULL;
+    differe.nbFils = nombreCoeurs();
+    if (etatReprise != REPRISE_LUE) {
+        genererToutesPositions(&config, &deck);
+        pDeck = &deck;
+        /* Avec un jeu d'ordres restreint, les objectifs ne sont tirs que parmi les positions atteignables */
+        calculerComposantes(&deck, &config, nombreCoeurs());
+        /* Les distances entre positions ne servent qu' tirer les objectifs dans une bande de difficult */
+        aDistances = (aDistances && calculerDistances(&distances, &deck, &config, nombreCoeurs()));
+        if (aDistances) pDistances = &distances;
+    }
 
-            /* Rinitialisation des droits de jeu pour tous */
-            for (int i = 0; i < nbJoueurs; i++) peutJouer[i] = 1;
-            nbJoueursEnLice = nbJoueurs;
+    /* Affichage des ordres disponibles*/
+    initRendu(&rendu, &config, 1);
+    pRendu = &rendu;
+    if (!silencieux) ecrireOrdres(&rendu);
+
+    initClassement(&classement, &registre);
+    pClassement = &classement;
+
+    /* Les lignes sont lues et horodatees par un fil dedie, puis jugees en parallele */
+    FileSoumissions file;
+    initFile(&file);
+
+    initPoolJuges(&juges, nombreCoeurs());
+    pJuges = &juges;
+
+    /* Sans joueur humain, personne n'ecrit sur l'entree : les robots alimentent seuls la file. Une
+       session qui porte les tours fournit aussi les lignes des robots, qui ne font que leurs tirages */
+    int rejeuParTour = (pSession != NULL && pSession->parTour);
+    Entree entree = { &file, &lecteur, rejeuParTour };
+    if (!tousRobots || rejeuParTour) {
+        thrd_t filLecture;
+        if (thrd_create(&filLecture, lireEntree, &entree) != thrd_success) {
+            fprintf(stderr, "Erreur fatale : Impossible de lancer la lecture des soumissions.\n");
+            goto fin;
         }
-
+        thrd_detach(filLecture);
+        /* Le fil de lecture peut encore s'en servir apres la partie */
+        pLecteur = NULL;
+        fichierSession = NULL;
     }
 
+    Alea alea;
+    initAlea(&alea, graine);
 
-    /*Fin de Partie et score */
-
-    /* Tri des joueurs selon le score */
-    qsort(joueurs, nbJoueurs, sizeof(Joueur), compareJoueurs);
+    /* Une seule partie sur ce fil : la roue ne porte que ses deux minuteries */
+    RoueTemps roue;
+    initRoue(&roue, horodatageNs() / 1000000ULL);
+    int avecDelais = (delaiTour > 0 || delaiInactivite > 0);
 
-    /* Affichage du classement final */
-    for (int i = 0; i < nbJoueurs; i++) {
-        printf("%s %d\n", joueurs[i].nom, joueurs[i].score);
+    /* Le tour suivant est prepare par un fil pendant que les joueurs reflechissent */
+    if (avecAnticipation) {
+        initAnticipation(&anticipation, &config);
+        pAnticipation = &anticipation;
     }
 
+    Partie partie = { &config, &registre, &classement, &deck, &alea, robots, &solveur, &file,
+                      &juges, silencieux ? NULL : &rendu, stdout, silencieux ? &stats : NULL,
+                      aDistances ? &distances : NULL, distanceMin, distanceMax, pJournal, 0,
+                      fichierReprise, NULL, graine, pEffets, avecDelais ? &roue : NULL, delaiTour, delaiInactivite,
+                      pAnticipation, NULL, enregistrement, rejeuParTour, 0 };
+    if (etatReprise == REPRISE_LUE) {
+        if (!restaurerPartie(&partie, &reprise, &differe)) {
+            fprintf(stderr, "Erreur fatale : Le point de reprise %s ne correspond pas a cette configuration ou a ces joueurs.\n", fichierReprise);
+            goto fin;
+        }
+        /* Genere par le fil du deck differe, attendu avant la fin de jouerPartie */
+        pDeck = &deck;
+        if (aDistances) pDistances = &distances;
+        fprintf(stderr, "Reprise au tour %u.\n", (unsigned)reprise.tour + 1);
+    }
+    if (!jouerPartie(&partie)) {
+        printf("Erreur : Pas assez de combinaisons pour jouer.\n");
+        goto fin;
+    }
 
 
-    free(peutJouer);
+    /*Fin de Partie et score */
 
-    for (int i = 0; i < deck.nbPositions; i++) {
-        libererEtat(&deck.positions[i]);
+    /* Affichage du classement final, dj tri par le classement */
+    int* ordre = (int*)allouerMem(MEM_JOUEURS, sizeof(int) * registre.nbJoueurs);
+    int nbClasses = meilleursJoueurs(&classement, registre.nbJoueurs, ordre);
+    for (int i = 0; i < nbClasses; i++) {
+        printf("%s %d\n", registre.joueurs[ordre[i]].nom, registre.joueurs[ordre[i]].score);
     }
-    free(deck.positions);
-    free(deck.estUtilisee);
-
-    libererConfiguration(&config);
-
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    libererMem(ordre);
+
+    if (tousRobots) stats.nbParties = 1;
+    if (silencieux) afficherStatistiques(&stats, tousRobots ? "Robots" : "Rejeu");
+    if (silencieux && pEffets != NULL) ecrireCacheEffets(pEffets, stdout);
+    if (atomic_load(&sondesActives)) ecrireSondes(stderr);
+    if (afficherMemoire) ecrireMemoire(stderr);
+    code = EXIT_SUCCESS;
+
+fin:
+    /* Les fils s'arretent avant que leurs donnees soient rendues. La file n'est pas detruite : le
+       fil de lecture peut encore etre bloque sur son entree */
+    if (pJuges != NULL) detruirePoolJuges(pJuges);
+    if (pAnticipation != NULL) detruireAnticipation(pAnticipation);
+    if (pJournal != NULL) fermerJournalEtSignaler(pJournal);
+    if (pStats != NULL) libererStatistiques(pStats);
+    if (pReprise != NULL) libererReprise(pReprise);
+    if (pClassement != NULL) libererClassement(pClassement);
+    if (pSolveur != NULL) libererSolveur(pSolveur);
+    libererMem(strategies);
+    libererMem(robots);
+    if (pRendu != NULL) libererRendu(pRendu);
+    if (pEffets != NULL) libererCacheEffets(pEffets);
+    if (pDistances != NULL) libererDistances(pDistances);
+    if (pDeck != NULL) libererDeck(pDeck);
+    if (enregistrement != NULL) fclose(enregistrement);
+    if (pLecteur != NULL) libererLecteur(pLecteur);
+    if (fichierSession != NULL) fclose(fichierSession);
+    if (pSession != NULL) libererSession(pSession);
+    if (pConfig != NULL) libererConfiguration(pConfig);
+    libererRegistre(&registre);
+    return code;
+}
@@ -0,0 +1,252 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "memoire.h"
+
+
+/**
+ * @union EnTete
+ * @brief Placé devant chaque bloc pour retrouver sa taille et son sous-système à la libération.
+ *        Sa taille préserve l'alignement garanti par malloc
+ */
+typedef union {
+    struct {
+        size_t taille;
+        int sousSysteme;
+    } info;
+    long double alignement;
+    void* pointeur;
+    long long entier;
+} EnTete;
+
+/**
+ * @def SEUIL_REPORT
+ * @brief Écart en octets au-delà duquel un fil reporte ses allocations dans les comptes globaux
+ */
+#define SEUIL_REPORT 4096
+
+/**
+ * @struct CompteMemoire
+ * @brief Compteurs globaux d'un sous-système, chacun sur sa propre ligne de cache
+ */
+typedef struct {
+    _Alignas(64) atomic_llong vivants;  /* Octets reportés par les fils et pas encore libérés */
+    atomic_llong pic;                   /* Maximum atteint par vivants */
+} CompteMemoire;
+
+/**
+ * @struct BlocMemoire
+ * @brief Compteurs d'un fil. Seul son fil les modifie, sans instruction atomique coûteuse ; les
+ *        lectures atomiques permettent de les additionner depuis un autre fil
+ */
+typedef struct BlocMemoire {
+    atomic_llong enAttente[NB_SOUS_SYSTEMES + 1];    /* Octets pas encore reportés dans comptes */
+    atomic_llong allocations[NB_SOUS_SYSTEMES];
+    struct BlocMemoire* suivant;                     /* Bloc du fil inscrit avant celui-ci */
+} BlocMemoire;
+
+static const char* nomsSousSystemes[NB_SOUS_SYSTEMES] = {
+    "config", "deck", "cellules", "essais", "joueurs", "soumissions", "solveur", "divers"
+};
+
+/* Le dernier compte cumule tous les sous-systèmes, pour que le pic global soit celui de la somme */
+static CompteMemoire comptes[NB_SOUS_SYSTEMES + 1];
+
+/* Blocs de tous les fils qui ont alloué, jamais libérés */
+static BlocMemoire* _Atomic tousLesBlocs = NULL;
+
+static _Thread_local BlocMemoire* blocDuFil = NULL;
+static _Thread_local int cellulesDuFil = MEM_CELLULES;
+
+
+/**
+ * @brief Bloc du fil appelant, créé et inscrit à sa première allocation
+ * @return BlocMemoire* Le bloc
+ */
+static BlocMemoire* bloc(void) {
+    if (blocDuFil != NULL) return blocDuFil;
+
+    BlocMemoire* b = (BlocMemoire*)calloc(1, sizeof(BlocMemoire));
+    if (b == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le suivi de la memoire.\n");
+        exit(EXIT_FAILURE);
+    }
+    b->suivant = atomic_load(&tousLesBlocs);
+    while (!atomic_compare_exchange_weak(&tousLesBlocs, &b->suivant, b)) {
+    }
+    blocDuFil = b;
+    return b;
+}
+
+/**
+ * @brief Relève le pic d'un compte s'il est dépassé
+ * @param[in,out] c Le compte
+ * @param[in] vivants Octets vivants observés
+ */
+static void releverPic(CompteMemoire* c, long long vivants) {
+    long long pic = atomic_load_explicit(&c->pic, memory_order_relaxed);
+    while (vivants > pic &&
+           !atomic_compare_exchange_weak_explicit(&c->pic, &pic, vivants, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Ajoute delta octets vivants au compte i du fil et les reporte dans le compte global quand
+ *        l'écart dépasse SEUIL_REPORT. Le pic tient compte de l'écart du fil appelant : il n'est
+ *        sous-estimé que des octets pas encore reportés par les autres fils
+ * @param[in,out] b Le bloc du fil
+ * @param[in] i Le sous-système ou NB_SOUS_SYSTEMES pour le total
+ * @param[in] delta Octets alloués (positif) ou libérés (négatif)
+ */
+static void ajouter(BlocMemoire* b, int i, long long delta) {
+    CompteMemoire* c = &comptes[i];
+    long long attente = atomic_load_explicit(&b->enAttente[i], memory_order_relaxed) + delta;
+
+    if (attente > -SEUIL_REPORT && attente < SEUIL_REPORT) {
+        atomic_store_explicit(&b->enAttente[i], attente, memory_order_relaxed);
+        if (delta > 0) {
+            /* Simples lectures : les comptes globaux ne changent qu'aux reports */
+            long long vivants = atomic_load_explicit(&c->vivants, memory_order_relaxed) + attente;
+            if (vivants > atomic_load_explicit(&c->pic, memory_order_relaxed)) releverPic(c, vivants);
+        }
+        return;
+    }
+
+    atomic_store_explicit(&b->enAttente[i], 0, memory_order_relaxed);
+    releverPic(c, atomic_fetch_add_explicit(&c->vivants, attente, memory_order_relaxed) + attente);
+}
+
+/**
+ * @brief Enregistre un bloc alloué dans son sous-système et son en-tête
+ * @param[in] e L'en-tête du bloc
+ * @param[in] sousSysteme Le sous-système
+ * @param[in] taille Taille utile
+ * @return void* Le bloc rendu à l'appelant
+ */
+static void* enregistrer(EnTete* e, int sousSysteme, size_t taille) {
+    e->info.taille = taille;
+    e->info.sousSysteme = sousSysteme;
+
+    BlocMemoire* b = bloc();
+    ajouter(b, sousSysteme, (long long)taille);
+    ajouter(b, NB_SOUS_SYSTEMES, (long long)taille);
+    atomic_store_explicit(&b->allocations[sousSysteme],
+                          atomic_load_explicit(&b->allocations[sousSysteme], memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    return e + 1;
+}
+
+/**
+ * @brief Alloue un bloc attribué à un sous-système
+ * @param[in] sousSysteme Le sous-système
+ * @param[in] taille La taille
+ * @return void* Le bloc ou NULL
+ */
+void* allouerMem(int sousSysteme, size_t taille) {
+    EnTete* e = (EnTete*)malloc(sizeof(EnTete) + taille);
+    if (e == NULL) return NULL;
+    return enregistrer(e, sousSysteme, taille);
+}
+
+/**
+ * @brief Alloue un bloc mis à zéro
+ * @param[in] sousSysteme Le sous-système
+ * @param[in] nb Nombre d'éléments
+ * @param[in] taille Taille d'un élément
+ * @return void* Le bloc ou NULL
+ */
+void* allouerMemZero(int sousSysteme, size_t nb, size_t taille) {
+    if (taille != 0 && nb > (SIZE_MAX - sizeof(EnTete)) / taille) return NULL;
+
+    EnTete* e = (EnTete*)calloc(1, sizeof(EnTete) + nb * taille);
+    if (e == NULL) return NULL;
+    return enregistrer(e, sousSysteme, nb * taille);
+}
+
+/**
+ * @brief Redimensionne un bloc
+ * @param[in] sousSysteme Sous-système si p vaut NULL
+ * @param[in] p Le bloc
+ * @param[in] taille La nouvelle taille
+ * @return void* Le bloc ou NULL
+ */
+void* reallouerMem(int sousSysteme, void* p, size_t taille) {
+    if (p == NULL) return allouerMem(sousSysteme, taille);
+
+    EnTete* ancien = (EnTete*)p - 1;
+    size_t ancienneTaille = ancien->info.taille;
+    sousSysteme = ancien->info.sousSysteme;
+
+    EnTete* e = (EnTete*)realloc(ancien, sizeof(EnTete) + taille);
+    if (e == NULL) return NULL;
+
+    long long delta = (long long)taille - (long long)ancienneTaille;
+    e->info.taille = taille;
+    BlocMemoire* b = bloc();
+    ajouter(b, sousSysteme, delta);
+    ajouter(b, NB_SOUS_SYSTEMES, delta);
+    return e + 1;
+}
+
+/**
+ * @brief Libère un bloc
+ * @param[in] p Le bloc ou NULL
+ */
+void libererMem(void* p) {
+    if (p == NULL) return;
+
+    EnTete* e = (EnTete*)p - 1;
+    BlocMemoire* b = bloc();
+    ajouter(b, e->info.sousSysteme, -(long long)e->info.taille);
+    ajouter(b, NB_SOUS_SYSTEMES, -(long long)e->info.taille);
+    free(e);
+}
+
+/**
+ * @brief Change le sous-système des cellules du fil appelant
+ * @param[in] sousSysteme Le nouveau sous-système
+ * @return int L'ancien
+ */
+int attribuerCellules(int sousSysteme) {
+    int precedent = cellulesDuFil;
+    cellulesDuFil = sousSysteme;
+    return precedent;
+}
+
+/**
+ * @brief Sous-système actuel des cellules du fil appelant
+ * @return int Le sous-système
+ */
+int sousSystemeCellules(void) {
+    return cellulesDuFil;
+}
+
+/**
+ * @brief Écrit le tableau d'occupation mémoire. Les octets vivants comprennent ceux que les fils
+ *        n'ont pas encore reportés ; le pic reste à SEUIL_REPORT octets près par fil concurrent
+ * @param[in] f Le flux
+ */
+void ecrireMemoire(FILE* f) {
+    long long attente[NB_SOUS_SYSTEMES + 1] = { 0 };
+    long long allocations[NB_SOUS_SYSTEMES + 1] = { 0 };
+
+    for (BlocMemoire* b = atomic_load(&tousLesBlocs); b != NULL; b = b->suivant) {
+        for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+            attente[i] += atomic_load_explicit(&b->enAttente[i], memory_order_relaxed);
+            allocations[i] += atomic_load_explicit(&b->allocations[i], memory_order_relaxed);
+        }
+        attente[NB_SOUS_SYSTEMES] += atomic_load_explicit(&b->enAttente[NB_SOUS_SYSTEMES], memory_order_relaxed);
+    }
+
+    fprintf(f, "%-12s %14s %14s %14s\n", "Memoire", "vivants (o)", "pic (o)", "allocations");
+    for (int i = 0; i <= NB_SOUS_SYSTEMES; i++) {
+        if (i < NB_SOUS_SYSTEMES) allocations[NB_SOUS_SYSTEMES] += allocations[i];
+        long long vivants = atomic_load(&comptes[i].vivants) + attente[i];
+        long long pic = atomic_load(&comptes[i].pic);
+        fprintf(f, "%-12s %14lld %14lld %14lld\n", i < NB_SOUS_SYSTEMES ? nomsSousSystemes[i] : "total",
+                vivants, pic > vivants ? pic : vivants, allocations[i]);
+    }
+    fflush(f);
+}
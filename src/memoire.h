@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @def COMMANDE_MEMOIRE
+ * @brief Ligne saisie qui affiche l'occupation mémoire sur l'erreur standard
+ */
+#define COMMANDE_MEMOIRE "!memoire"
+
+/* Sous-systèmes auxquels les allocations sont attribuées */
+#define MEM_CONFIG 0       /* Noms des animaux et des ordres */
+#define MEM_DECK 1         /* Positions du deck (et leurs cellules) et marqueurs de cartes tirées */
+#define MEM_CELLULES 2     /* Cellules des podiums en cours de partie */
+#define MEM_ESSAIS 3       /* Cellules des états d'essai et cache des effets des juges */
+#define MEM_JOUEURS 4      /* Registre, classement et robots */
+#define MEM_SOUMISSIONS 5  /* Lignes en attente de jugement */
+#define MEM_SOLVEUR 6      /* Tables des solveurs des robots et des tirages par difficulté */
+#define MEM_DIVERS 7       /* Lecture, rendu, rejeu, tournoi, journal, reprise */
+#define NB_SOUS_SYSTEMES 8
+
+
+
+/**
+ * @brief Alloue un bloc attribué à un sous-système
+ * @param[in] sousSysteme Le sous-système (MEM_...)
+ * @param[in] taille Taille demandée en octets
+ * @return void* Le bloc ou NULL si la mémoire manque
+ */
+void* allouerMem(int sousSysteme, size_t taille);
+
+/**
+ * @brief Alloue un bloc mis à zéro attribué à un sous-système
+ * @param[in] sousSysteme Le sous-système (MEM_...)
+ * @param[in] nb Nombre d'éléments
+ * @param[in] taille Taille d'un élément
+ * @return void* Le bloc ou NULL si la mémoire manque
+ */
+void* allouerMemZero(int sousSysteme, size_t nb, size_t taille);
+
+/**
+ * @brief Redimensionne un bloc, qui reste attribué à son sous-système d'origine
+ * @param[in] sousSysteme Sous-système utilisé si p vaut NULL
+ * @param[in] p Bloc rendu par allouerMem ou NULL
+ * @param[in] taille Nouvelle taille en octets
+ * @return void* Le nouveau bloc ou NULL si la mémoire manque (p reste alors valide)
+ */
+void* reallouerMem(int sousSysteme, void* p, size_t taille);
+
+/**
+ * @brief Libère un bloc rendu par allouerMem, allouerMemZero ou reallouerMem
+ * @param[in] p Le bloc, NULL est accepté
+ */
+void libererMem(void* p);
+
+/**
+ * @brief Change le sous-système auquel le fil appelant attribue les cellules des piles
+ * @param[in] sousSysteme Le nouveau sous-système (MEM_CELLULES par défaut)
+ * @return int Le sous-système précédent, à rétablir ensuite
+ */
+int attribuerCellules(int sousSysteme);
+
+/**
+ * @brief Sous-système auquel le fil appelant attribue actuellement les cellules
+ * @return int Le sous-système
+ */
+int sousSystemeCellules(void);
+
+/**
+ * @brief Écrit les octets vivants, le pic et le nombre d'allocations de chaque sous-système
+ * @param[in] f Flux de sortie
+ */
+void ecrireMemoire(FILE* f);
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include "moteur.h"
+
+
+/**
+ * @brief Tire une carte atteignable depuis courant, dans la bande de difficulté du contexte
+ *        s'il y en a une et qu'elle contient encore une carte libre
+ * @param[in,out] ctx Le contexte
+ * @param[in] courant Position de départ
+ * @return EtatJeu* La carte ou NULL
+ */
+static EtatJeu* tirerDepuis(ContexteJeu* ctx, const EtatJeu* courant) {
+    EtatJeu* carte = NULL;
+    if (ctx->distances != NULL) {
+        carte = tirerCarteDifficulte(ctx->distances, ctx->deck, ctx->alea, ctx->config, courant, ctx->distanceMin,
+                                     ctx->distanceMax);
+    }
+    if (carte == NULL) carte = tirerCarteAtteignable(ctx->deck, ctx->alea, courant);
+    return carte;
+}
+
+/**
+ * @brief Tire l'objectif suivant parmi les cartes atteignables depuis courant. Quand il n'en
+ *        reste plus alors que le deck n'est pas vide, repart d'une nouvelle position de départ
+ * @param[in,out] ctx Le contexte
+ * @param[in,out] courant Position de départ, remplacée en cas de nouveau départ
+ * @return EtatJeu* L'objectif ou NULL si plus aucune carte ne peut être jouée
+ */
+static EtatJeu* tirerObjectif(ContexteJeu* ctx, EtatJeu** courant) {
+    EtatJeu* objectif = tirerDepuis(ctx, *courant);
+    while (objectif == NULL && atomic_load(&ctx->deck->nbRestantes) > 0) {
+        *courant = tirerCarteAvec(ctx->deck, ctx->alea);
+        if (*courant == NULL) break;
+        objectif = tirerDepuis(ctx, *courant);
+    }
+    return objectif;
+}
+
+/**
+ * @brief Ajoute un événement
+ */
+static int ajouterEvenement(EvenementJeu* evts, int nb, int type, int joueur) {
+    evts[nb].type = type;
+    evts[nb].joueur = joueur;
+    evts[nb].codeRetour = 0;
+    evts[nb].bonneSolution = 0;
+    evts[nb].forfait = 0;
+    return nb + 1;
+}
+
+/**
+ * @brief Finit le tour : l'objectif devient le départ du suivant, dont l'objectif est tiré
+ * @return int Nombre d'événements après celui du passage au tour suivant ou de la fin de partie
+ */
+static int finirTour(ContexteJeu* ctx, EvenementJeu* evts, int nb) {
+    EtatJeu* courant = ctx->objectif;
+    EtatJeu* objectif;
+    if (ctx->anticipe) {
+        courant = ctx->suivantCourant;
+        objectif = ctx->suivantObjectif;
+        ctx->anticipe = 0;
+    }
+    else {
+        objectif = tirerObjectif(ctx, &courant);
+    }
+    if (objectif == NULL) {
+        ctx->objectif = NULL;
+        return ajouterEvenement(evts, nb, EVENEMENT_FIN_PARTIE, -1);
+    }
+    placerTour(ctx, courant, objectif, ctx->tour + 1);
+    return ajouterEvenement(evts, nb, EVENEMENT_NOUVEAU_TOUR, -1);
+}
+
+/**
+ * @brief Ouvre le premier tour
+ * @param[in,out] ctx Le contexte
+ * @return int 1 si ouvert
+ */
+int commencerPartie(ContexteJeu* ctx) {
+    EtatJeu* courant = tirerCarteAvec(ctx->deck, ctx->alea);
+    EtatJeu* objectif = tirerObjectif(ctx, &courant);
+    if (courant == NULL || objectif == NULL) {
+        ctx->objectif = NULL;
+        return 0;
+    }
+    placerTour(ctx, courant, objectif, 1);
+    return 1;
+}
+
+/**
+ * @brief Ouvre un tour
+ * @param[in,out] ctx Le contexte
+ * @param[in] courant Départ
+ * @param[in] objectif Objectif
+ * @param[in] tour Numéro du tour
+ */
+void placerTour(ContexteJeu* ctx, EtatJeu* courant, EtatJeu* objectif, int tour) {
+    ctx->courant = courant;
+    ctx->objectif = objectif;
+    ctx->tour = tour;
+    ctx->anticipe = 0;
+    nouveauTour(ctx->registre);
+}
+
+/**
+ * @brief Juge puis arbitre une séquence
+ * @param[in,out] ctx Le contexte
+ * @param[in] joueur Le joueur
+ * @param[in] sequence La séquence
+ * @param[out] evts Les événements
+ * @return int Nombre d'événements ou refus
+ */
+int soumettre(ContexteJeu* ctx, int joueur, const char* sequence, EvenementJeu evts[JEU_EVENEMENTS_MAX]) {
+    if (ctx->objectif == NULL) return JEU_PARTIE_FINIE;
+    if (joueur < 0 || joueur >= ctx->registre->nbJoueurs) return JEU_JOUEUR_INCONNU;
+    if (!estEnLice(ctx->registre, joueur)) return JEU_HORS_TOUR;
+
+    int bonneSolution;
+    int codeRetour = jugerParEffet(ctx->effets, ctx->courant, ctx->objectif, ctx->config, sequence, &bonneSolution);
+    return arbitrerVerdict(ctx, joueur, codeRetour, bonneSolution, evts);
+}
+
+/**
+ * @brief Arbitre un verdict
+ * @param[in,out] ctx Le contexte
+ * @param[in] joueur Le joueur
+ * @param[in] codeRetour Retour du jugement
+ * @param[in] bonneSolution 1 si gagnante
+ * @param[out] evts Les événements
+ * @return int Nombre d'événements ou refus
+ */
+int arbitrerVerdict(ContexteJeu* ctx, int joueur, int codeRetour, int bonneSolution,
+                    EvenementJeu evts[JEU_EVENEMENTS_MAX]) {
+    Registre* registre = ctx->registre;
+    if (ctx->objectif == NULL) return JEU_PARTIE_FINIE;
+    if (joueur < 0 || joueur >= registre->nbJoueurs) return JEU_JOUEUR_INCONNU;
+    if (!estEnLice(registre, joueur)) return JEU_HORS_TOUR;
+
+    int nb = ajouterEvenement(evts, 0, EVENEMENT_VERDICT, joueur);
+    evts[0].codeRetour = codeRetour;
+    evts[0].bonneSolution = bonneSolution;
+
+    if (bonneSolution) {
+        marquerPoint(ctx->classement, joueur);
+        nb = ajouterEvenement(evts, nb, EVENEMENT_POINT, joueur);
+        return finirTour(ctx, evts, nb);
+    }
+
+    /* Un ordre inconnu n'élimine pas : le joueur peut corriger sa saisie */
+    if (codeRetour != -1) {
+        eliminerDuTour(registre, joueur);
+        nb = ajouterEvenement(evts, nb, EVENEMENT_ELIMINE, joueur);
+    }
+
+    int enLice = nbJoueursEnLice(registre);
+    if (enLice == 1) {
+        int survivant = premierEnLice(registre);
+        marquerPoint(ctx->classement, survivant);
+        nb = ajouterEvenement(evts, nb, EVENEMENT_POINT, survivant);
+        evts[nb - 1].forfait = 1;
+        return finirTour(ctx, evts, nb);
+    }
+    if (enLice == 0) {
+        nb = ajouterEvenement(evts, nb, EVENEMENT_SANS_VAINQUEUR, -1);
+        return finirTour(ctx, evts, nb);
+    }
+    return nb;
+}
+
+/**
+ * @brief Termine un tour à son échéance
+ * @param[in,out] ctx Le contexte
+ * @param[out] evts Les événements
+ * @return int Nombre d'événements ou refus
+ */
+int expirerTour(ContexteJeu* ctx, EvenementJeu evts[JEU_EVENEMENTS_MAX]) {
+    if (ctx->objectif == NULL) return JEU_PARTIE_FINIE;
+    int nb = ajouterEvenement(evts, 0, EVENEMENT_TEMPS_ECOULE, -1);
+    return finirTour(ctx, evts, nb);
+}
+
+/**
+ * @brief Tire d'avance les cartes du tour suivant
+ * @param[in,out] ctx Le contexte
+ */
+void anticiperTour(ContexteJeu* ctx) {
+    if (ctx->objectif == NULL || ctx->anticipe) return;
+    EtatJeu* courant = ctx->objectif;
+    ctx->suivantObjectif = tirerObjectif(ctx, &courant);
+    ctx->suivantCourant = courant;
+    ctx->anticipe = 1;
+}
+
+/**
+ * @brief Indique si un verdict finirait le tour
+ * @param[in] ctx Le contexte
+ * @param[in] joueur Le joueur
+ * @param[in] codeRetour Retour du jugement
+ * @param[in] bonneSolution 1 si gagnante
+ * @return int 1 si le tour finirait
+ */
+int verdictFinitTour(const ContexteJeu* ctx, int joueur, int codeRetour, int bonneSolution) {
+    const Registre* registre = ctx->registre;
+    if (ctx->objectif == NULL || joueur < 0 || joueur >= registre->nbJoueurs || !estEnLice(registre, joueur)) return 0;
+    if (bonneSolution) return 1;
+    int enLice = nbJoueursEnLice(registre) - (codeRetour != -1 ? 1 : 0);
+    return enLice <= 1;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "jeu.h"
+#include "alea.h"
+#include "joueurs.h"
+#include "classement.h"
+#include "distances.h"
+#include "effets.h"
+
+/**
+ * @def JEU_EVENEMENTS_MAX
+ * @brief Événements produits au plus par une soumission : verdict, élimination, point, tour suivant
+ */
+#define JEU_EVENEMENTS_MAX 4
+
+/* Types d'EvenementJeu */
+#define EVENEMENT_VERDICT 1         /* Séquence jugée, codeRetour et bonneSolution remplis */
+#define EVENEMENT_ELIMINE 2         /* Le joueur ne peut plus jouer durant ce tour */
+#define EVENEMENT_POINT 3           /* Le joueur gagne un point, par forfait si forfait vaut 1 */
+#define EVENEMENT_SANS_VAINQUEUR 4  /* Tous les joueurs ont échoué */
+#define EVENEMENT_NOUVEAU_TOUR 5    /* Le tour est fini et les cartes du suivant sont tirées */
+#define EVENEMENT_FIN_PARTIE 6      /* Le tour est fini et plus aucune carte ne peut être jouée */
+#define EVENEMENT_TEMPS_ECOULE 7    /* Le délai du tour est passé sans vainqueur */
+
+/* Refus de soumettre, rendus à la place d'un nombre d'événements */
+#define JEU_JOUEUR_INCONNU -1
+#define JEU_HORS_TOUR -2            /* Le joueur a déjà échoué durant ce tour */
+#define JEU_PARTIE_FINIE -3
+
+
+/**
+ * @struct ContexteJeu
+ * @brief Règles d'une partie sans entrée ni sortie : les cartes du tour, les droits de jeu et
+ *        les scores. Rien n'est global ni bloquant, et aucune soumission n'alloue : un même fil
+ *        peut mener autant de parties qu'il a de contextes. Rempli dans l'ordre des champs,
+ *        les suivants (courant, objectif, tour et tirage anticipé) étant posés par le moteur
+ */
+typedef struct {
+    const ConfigJeu* config;
+    Registre* registre;          /* Joueurs remis en lice à chaque tour */
+    Classement* classement;      /* Scores de la partie */
+    Deck* deck;                  /* Paquet propre à la partie */
+    Alea* alea;                  /* Hasard des tirages */
+    CacheEffets* effets;         /* Cache partagé, NULL pour calculer chaque effet sans le garder */
+    const Distances* distances;  /* NULL pour tirer les objectifs sans regarder leur difficulté */
+    int distanceMin;             /* Bande de longueur de solution des objectifs, si distances est donné */
+    int distanceMax;
+    EtatJeu* courant;            /* Position de départ du tour */
+    EtatJeu* objectif;           /* Position à atteindre, NULL une fois la partie finie */
+    int tour;                    /* Numéro du tour en cours, à partir de 1 */
+    EtatJeu* suivantCourant;     /* Cartes du tour suivant tirées d'avance par anticiperTour */
+    EtatJeu* suivantObjectif;    /* NULL si plus aucune carte ne pourra être jouée */
+    int anticipe;                /* 1 si la fin du tour prend ces cartes au lieu de les tirer */
+} ContexteJeu;
+
+/**
+ * @struct EvenementJeu
+ * @brief Conséquence d'une soumission, dans l'ordre où elle doit être annoncée
+ */
+typedef struct {
+    int type;                    /* EVENEMENT_* */
+    int joueur;                  /* Joueur concerné, -1 pour un événement du tour */
+    int codeRetour;              /* EVENEMENT_VERDICT : retour de executerSequenceConfig */
+    int bonneSolution;           /* EVENEMENT_VERDICT : 1 si la séquence mène à l'objectif */
+    int forfait;                 /* EVENEMENT_POINT : 1 si gagné parce que seul encore en lice */
+} EvenementJeu;
+
+
+
+/**
+ * @brief Tire la position de départ et le premier objectif, puis ouvre le tour 1
+ * @param[in,out] ctx Le contexte, dont le deck est plein et les joueurs inscrits
+ * @return int 1 si la partie peut commencer, 0 si le deck n'a pas assez de cartes
+ */
+int commencerPartie(ContexteJeu* ctx);
+
+/**
+ * @brief Ouvre un tour sur des cartes déjà tirées, par exemple celles d'un point de reprise
+ * @param[in,out] ctx Le contexte
+ * @param[in] courant Position de départ
+ * @param[in] objectif Position à atteindre
+ * @param[in] tour Numéro du tour
+ */
+void placerTour(ContexteJeu* ctx, EtatJeu* courant, EtatJeu* objectif, int tour);
+
+/**
+ * @brief Juge la séquence d'un joueur sur le tour en cours et applique son verdict
+ * @param[in,out] ctx Le contexte
+ * @param[in] joueur Indice du joueur dans le registre
+ * @param[in] sequence La séquence saisie
+ * @param[out] evts Les événements produits
+ * @return int Nombre d'événements, ou JEU_JOUEUR_INCONNU, JEU_HORS_TOUR, JEU_PARTIE_FINIE
+ */
+int soumettre(ContexteJeu* ctx, int joueur, const char* sequence, EvenementJeu evts[JEU_EVENEMENTS_MAX]);
+
+/**
+ * @brief Applique le verdict d'une séquence déjà jugée, par exemple par le pool des juges :
+ *        point, élimination, forfait, fin du tour sans vainqueur et passage au tour suivant
+ * @param[in,out] ctx Le contexte
+ * @param[in] joueur Indice du joueur dans le registre
+ * @param[in] codeRetour Retour du jugement : 1, 0 ou -1 (ordre inconnu, le joueur reste en lice)
+ * @param[in] bonneSolution 1 si la séquence mène à l'objectif
+ * @param[out] evts Les événements produits
+ * @return int Nombre d'événements, ou JEU_JOUEUR_INCONNU, JEU_HORS_TOUR, JEU_PARTIE_FINIE
+ */
+int arbitrerVerdict(ContexteJeu* ctx, int joueur, int codeRetour, int bonneSolution,
+                    EvenementJeu evts[JEU_EVENEMENTS_MAX]);
+
+/**
+ * @brief Termine sans vainqueur un tour dont le délai est passé, par le même passage au tour
+ *        suivant que lorsque tous les joueurs ont échoué
+ * @param[in,out] ctx Le contexte
+ * @param[out] evts Les événements produits : temps écoulé, puis nouveau tour ou fin de partie
+ * @return int Nombre d'événements, ou JEU_PARTIE_FINIE
+ */
+int expirerTour(ContexteJeu* ctx, EvenementJeu evts[JEU_EVENEMENTS_MAX]);
+
+/**
+ * @brief Tire dès maintenant les cartes du tour suivant, qui partira de l'objectif en cours :
+ *        la fin du tour les prendra telles quelles. Le générateur et le deck sont consommés dans
+ *        le même ordre qu'un tirage en fin de tour, tant que rien d'autre ne s'en sert entre-temps.
+ *        Peut être appelé depuis un autre fil pendant que le tour se joue, si le fil de la partie
+ *        attend sa fin avant tout verdict pour lequel verdictFinitTour vaut 1 et avant expirerTour
+ * @param[in,out] ctx Le contexte
+ */
+void anticiperTour(ContexteJeu* ctx);
+
+/**
+ * @brief Indique si un verdict finirait le tour en cours, sans rien modifier
+ * @param[in] ctx Le contexte
+ * @param[in] joueur Indice du joueur dans le registre
+ * @param[in] codeRetour Retour du jugement
+ * @param[in] bonneSolution 1 si la séquence mène à l'objectif
+ * @return int 1 si arbitrerVerdict passerait au tour suivant
+ */
+int verdictFinitTour(const ContexteJeu* ctx, int joueur, int codeRetour, int bonneSolution);
@@ -0,0 +1,127 @@
+/*
+ * Modèle d'un noyau spécialisé, inclus par noyaux.c une fois par nombre d'animaux avec
+ * N_ANIMAUX défini. Pas de #pragma once : chaque inclusion produit un nouveau jeu de fonctions
+ */
+
+#define NOM(f) NOM_(f, N_ANIMAUX)
+#define NOM_(f, n) NOM__(f, n)
+#define NOM__(f, n) f##_##n
+
+/**
+ * @brief appliquerOrdre pour N_ANIMAUX animaux
+ */
+static int NOM(appliquerOrdre)(EtatCompact* c, int ordre) {
+    int h = c->hauteur;
+    uint8_t* a = c->animaux;
+    uint8_t tmp;
+
+    switch (ordre) {
+    case ORDRE_KI:
+        if (h == 0) return 0;
+        c->hauteur--;
+        return 1;
+    case ORDRE_LO:
+        if (h == N_ANIMAUX) return 0;
+        c->hauteur++;
+        return 1;
+    case ORDRE_SO:
+        if (h == 0 || h == N_ANIMAUX) return 0;
+        tmp = a[h - 1];
+        a[h - 1] = a[h];
+        a[h] = tmp;
+        return 1;
+    case ORDRE_NI:
+        if (h == 0) return 0;
+        tmp = a[0];
+        DEROULER
+        for (int i = 0; i < N_ANIMAUX - 1; i++) {
+            if (i + 1 < h) a[i] = a[i + 1];
+        }
+        a[h - 1] = tmp;
+        return 1;
+    case ORDRE_MA:
+        if (h == N_ANIMAUX) return 0;
+        tmp = a[N_ANIMAUX - 1];
+        DEROULER
+        for (int i = N_ANIMAUX - 1; i > 0; i--) {
+            if (i > h) a[i] = a[i - 1];
+        }
+        a[h] = tmp;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief rangEtat pour N_ANIMAUX animaux
+ */
+static uint32_t NOM(rangEtat)(const EtatCompact* c) {
+    const uint8_t* a = c->animaux;
+    uint32_t rang = 0;
+
+    DEROULER
+    for (int i = 0; i < N_ANIMAUX; i++) {
+        uint32_t plusPetits = 0;
+        DEROULER
+        for (int j = i + 1; j < N_ANIMAUX; j++) plusPetits += (a[j] < a[i]);
+        rang = rang * (uint32_t)(N_ANIMAUX - i) + plusPetits;
+    }
+    return rang * (uint32_t)(N_ANIMAUX + 1) + c->hauteur;
+}
+
+/**
+ * @brief etatDeRang pour N_ANIMAUX animaux. Les cases libres sont rangées par quartets dans un
+ *        entier : prendre la k-ième et la retirer ne coûte que des décalages
+ */
+static void NOM(etatDeRang)(uint32_t rang, int n, EtatCompact* c) {
+    (void)n;
+    c->nb = (uint8_t)N_ANIMAUX;
+    c->hauteur = (uint8_t)(rang % (uint32_t)(N_ANIMAUX + 1));
+    rang /= (uint32_t)(N_ANIMAUX + 1);
+
+    uint32_t chiffres[N_ANIMAUX];
+    DEROULER
+    for (int i = N_ANIMAUX - 1; i >= 0; i--) {
+        chiffres[i] = rang % (uint32_t)(N_ANIMAUX - i);
+        rang /= (uint32_t)(N_ANIMAUX - i);
+    }
+
+    uint64_t libres = 0xFEDCBA9876543210ULL;
+    DEROULER
+    for (int i = 0; i < N_ANIMAUX; i++) {
+        unsigned decalage = 4 * chiffres[i];
+        uint64_t bas = libres & ((1ULL << decalage) - 1);
+        c->animaux[i] = (uint8_t)((libres >> decalage) & 0xF);
+        libres = bas | ((libres >> (decalage + 4)) << decalage);
+    }
+}
+
+/**
+ * @brief estMemeEtatCompact pour N_ANIMAUX animaux
+ */
+static int NOM(estMemeEtat)(const EtatCompact* a, const EtatCompact* b) {
+    return a->nb == b->nb && a->hauteur == b->hauteur && memcmp(a->animaux, b->animaux, N_ANIMAUX) == 0;
+}
+
+/**
+ * @brief Voisins d'un état pour N_ANIMAUX animaux : un seul etatDeRang, puis un ordre et un
+ *        rang par voisin, tous en ligne
+ */
+static void NOM(voisins)(uint32_t rang, int n, const int* ordres, int nbOrdres, uint32_t* rangs) {
+    EtatCompact e;
+    NOM(etatDeRang)(rang, n, &e);
+
+    for (int k = 0; k < nbOrdres; k++) {
+        EtatCompact voisin = e;
+        rangs[k] = NOM(appliquerOrdre)(&voisin, ordres[k]) ? NOM(rangEtat)(&voisin) : RANG_IMPOSSIBLE;
+    }
+}
+
+static const Noyau NOM(noyau) = {
+    N_ANIMAUX, NOM(appliquerOrdre), NOM(rangEtat), NOM(etatDeRang), NOM(estMemeEtat), NOM(voisins)
+};
+
+#undef NOM
+#undef NOM_
+#undef NOM__
@@ -0,0 +1,84 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "noyaux.h"
+
+/**
+ * @def DEROULER
+ * @brief Demande le déroulement complet de la boucle qui suit, de longueur connue à la compilation
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#define DEROULER _Pragma("GCC unroll 16")
+#elif defined(__clang__)
+#define DEROULER _Pragma("unroll")
+#else
+#define DEROULER
+#endif
+
+
+/**
+ * @brief Voisins d'un état avec les fonctions génériques
+ */
+static void voisinsGeneriques(uint32_t rang, int n, const int* ordres, int nbOrdres, uint32_t* rangs) {
+    EtatCompact e;
+    etatDeRang(rang, n, &e);
+
+    for (int k = 0; k < nbOrdres; k++) {
+        EtatCompact voisin = e;
+        rangs[k] = appliquerOrdre(&voisin, ordres[k]) ? rangEtat(&voisin) : RANG_IMPOSSIBLE;
+    }
+}
+
+static const Noyau noyauGeneral = {
+    0, appliquerOrdre, rangEtat, etatDeRang, estMemeEtatCompact, voisinsGeneriques
+};
+
+/* Un noyau par nombre d'animaux, de NOYAU_MIN à MAX_ANIMAUX */
+#define N_ANIMAUX 3
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 4
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 5
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 6
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 7
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 8
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 9
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+#define N_ANIMAUX 10
+#include "noyau_modele.h"
+#undef N_ANIMAUX
+
+static const Noyau* const noyauxSpecialises[MAX_ANIMAUX - NOYAU_MIN + 1] = {
+    &noyau_3, &noyau_4, &noyau_5, &noyau_6, &noyau_7, &noyau_8, &noyau_9, &noyau_10
+};
+
+
+/**
+ * @brief Noyau d'un nombre d'animaux
+ * @param[in] n Nombre d'animaux
+ * @return const Noyau* Le noyau
+ */
+const Noyau* choisirNoyau(int n) {
+    if (n < NOYAU_MIN || n > MAX_ANIMAUX) return &noyauGeneral;
+    return noyauxSpecialises[n - NOYAU_MIN];
+}
+
+/**
+ * @brief Noyau générique
+ * @return const Noyau* Le noyau
+ */
+const Noyau* noyauGenerique(void) {
+    return &noyauGeneral;
+}
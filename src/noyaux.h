@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include "etatcompact.h"
+
+/**
+ * @def RANG_IMPOSSIBLE
+ * @brief Rang rendu par voisins pour un ordre impossible depuis l'état
+ */
+#define RANG_IMPOSSIBLE UINT32_MAX
+
+/**
+ * @def NOYAU_MIN
+ * @brief Plus petit nombre d'animaux qui a son noyau spécialisé
+ */
+#define NOYAU_MIN 3
+
+
+/**
+ * @struct Noyau
+ * @brief Opérations de l'état compact compilées pour un nombre d'animaux fixé : les boucles sur
+ *        les cases ont une longueur connue à la compilation et sont entièrement déroulées, les
+ *        divisions du rang deviennent des multiplications. Le noyau générique accepte tout
+ *        nombre d'animaux et reprend les fonctions de etatcompact.h. Les signatures sont celles
+ *        du générique : nb et n sont ignorés par les noyaux spécialisés
+ */
+typedef struct Noyau {
+    int nbAnimaux;                                           /* 0 pour le noyau générique */
+    int (*appliquerOrdre)(EtatCompact* c, int ordre);
+    uint32_t (*rangEtat)(const EtatCompact* c);
+    void (*etatDeRang)(uint32_t rang, int n, EtatCompact* c);
+    int (*estMemeEtat)(const EtatCompact* a, const EtatCompact* b);
+    /* Rangs des voisins d'un état par chaque ordre, RANG_IMPOSSIBLE si l'ordre est impossible */
+    void (*voisins)(uint32_t rang, int n, const int* ordres, int nbOrdres, uint32_t* rangs);
+} Noyau;
+
+
+
+/**
+ * @brief Choisit le noyau d'un nombre d'animaux, une fois pour toutes après validerConfiguration :
+ *        il est gardé dans ConfigJeu.noyau, où le solveur, les composantes et les distances le prennent
+ * @param[in] n Nombre d'animaux
+ * @return const Noyau* Le noyau spécialisé pour n, le générique si n n'en a pas
+ */
+const Noyau* choisirNoyau(int n);
+
+/**
+ * @brief Renvoie le noyau générique, valable pour tout nombre d'animaux
+ * @return const Noyau* Le noyau générique
+ */
+const Noyau* noyauGenerique(void);
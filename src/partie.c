@@ -0,0 +1,513 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "partie.h"
+#include "moteur.h"
+#include "composantes.h"
+#include "etatcompact.h"
+#include "sondes.h"
+#include "memoire.h"
+
+/* Issues possibles de l'arbitrage d'une soumission */
+#define ARBITRAGE_CONTINUE 0
+#define ARBITRAGE_FIN_TOUR 1
+#define ARBITRAGE_FIN_ENTREE 2
+
+/* Types des minuteries d'une partie */
+#define MINUTERIE_TOUR 1
+#define MINUTERIE_INACTIVITE 2
+
+
+/**
+ * @brief Écrit un verdict sur la sortie de la partie, s'il y en a une
+ * @param[in] p La partie
+ * @param[in] format Format à la printf
+ */
+static void annoncer(const Partie* p, const char* format, ...) {
+    if (p->sortie == NULL) return;
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(p->sortie, format, args);
+    va_end(args);
+}
+
+/**
+ * @brief Insere une soumission dans le lot en gardant l'ordre des horodatages
+ * @param[in,out] lot Le lot trie
+ * @param[in,out] taille Nombre de soumissions du lot
+ * @param[in] s La soumission a inserer
+ */
+static void insererParHorodatage(Soumission** lot, int* taille, Soumission* s) {
+    int i = *taille;
+    while (i > 0 && lot[i - 1]->horodatage > s->horodatage) {
+        lot[i] = lot[i - 1];
+        i--;
+    }
+    lot[i] = s;
+    (*taille)++;
+}
+
+/**
+ * @brief Decoupe la ligne d'une soumission et retrouve le joueur concerne
+ * @param[in,out] s La soumission
+ * @param[in] registre Registre des joueurs
+ */
+static void analyserSoumission(Soumission* s, const Registre* registre) {
+    if (s->analysee || s->fin) return;
+    s->analysee = 1;
+
+    unsigned long long sonde = debutSonde();
+
+    s->idJoueur = -1;
+
+    /* Decoupage sur place : les champs sont termines par '\0' dans la ligne elle-meme */
+    Vue ligne = { s->ligne, s->longueur };
+    Vue champs[2];
+    int nbChamps = decouperVue(ligne, champs, 2);
+    if (nbChamps == 0) {
+        finSonde(SONDE_ANALYSE, sonde);
+        return;
+    }
+
+    s->nomJoueur = s->ligne + (champs[0].debut - s->ligne);
+    s->nomJoueur[champs[0].longueur] = '\0';
+    if (nbChamps == 2) {
+        s->sequence = s->ligne + (champs[1].debut - s->ligne);
+        s->sequence[champs[1].longueur] = '\0';
+    }
+
+    s->idJoueur = chercherJoueur(registre, s->nomJoueur);
+    finSonde(SONDE_ANALYSE, sonde);
+}
+
+/**
+ * @brief Annonce les evenements d'un verdict et les reporte dans le journal
+ * @return int ARBITRAGE_FIN_TOUR si le tour est fini, ARBITRAGE_CONTINUE sinon
+ */
+static int annoncerEvenements(Partie* p, const EvenementJeu* evts, int nb, uint32_t tour) {
+    const Registre* registre = p->registre;
+    int etat = ARBITRAGE_CONTINUE;
+
+    for (int i = 0; i < nb; i++) {
+        const EvenementJeu* e = &evts[i];
+        switch (e->type) {
+        case EVENEMENT_ELIMINE:
+            annoncer(p, "La sequence ne conduit pas a la situation attendue\n");
+            annoncer(p, "%s ne peut plus jouer durant ce tour\n", registre->joueurs[e->joueur].nom);
+            break;
+        case EVENEMENT_POINT:
+            if (e->forfait) {
+                annoncer(p, "%s gagne un point car lui seul peut encore jouer durant ce tour\n\n",
+                         registre->joueurs[e->joueur].nom);
+            }
+            else {
+                annoncer(p, "%s gagne un point\n\n", registre->joueurs[e->joueur].nom);
+            }
+            journaliserPoint(p->journal, p->numero, tour, e->joueur, e->forfait);
+            break;
+        case EVENEMENT_SANS_VAINQUEUR:
+            annoncer(p, "Tous les joueurs ont echoue. Fin du tour sans vainqueur.\n\n");
+            break;
+        case EVENEMENT_TEMPS_ECOULE:
+            annoncer(p, "Temps ecoule. Fin du tour sans vainqueur.\n\n");
+            break;
+        case EVENEMENT_NOUVEAU_TOUR:
+        case EVENEMENT_FIN_PARTIE:
+            etat = ARBITRAGE_FIN_TOUR;
+            break;
+        default:
+            break;
+        }
+    }
+    return etat;
+}
+
+/**
+ * @brief Rang d'EtatCompact d'une carte
+ */
+static uint32_t rangCarte(const ConfigJeu* config, const EtatJeu* carte) {
+    EtatCompact c;
+    compacterEtat(config, carte, &c);
+    return rangEtat(&c);
+}
+
+/**
+ * @brief Fil du deck differe : genere le deck et ses tables comme pour une nouvelle partie,
+ *        verifie que les cartes du tour repris sont aux indices du point puis remet ses marqueurs
+ * @param[in,out] arg Le deck differe
+ * @return int 0
+ */
+static int genererDeckDiffere(void* arg) {
+    DeckDiffere* d = (DeckDiffere*)arg;
+    const PointReprise* r = d->reprise;
+    genererToutesPositions(d->config, d->deck);
+    calculerComposantes(d->deck, d->config, d->nbFils);
+    if (d->distances != NULL) calculerDistances(d->distances, d->deck, d->config, d->nbFils);
+
+    /* Les indices evitent de chercher les cartes, leurs rangs verifient que le deck est range pareil */
+    d->valide = (d->deck->nbPositions == r->nbPositions &&
+                 rangCarte(d->config, &d->deck->positions[r->indiceCourant]) == r->rangCourant &&
+                 rangCarte(d->config, &d->deck->positions[r->indiceObjectif]) == r->rangObjectif);
+    if (d->valide) restaurerDeck(d->deck, r->utilisees);
+    return 0;
+}
+
+/**
+ * @brief Attend le deck d'une partie reprise avant le premier tirage, puis met ses cartes a la
+ *        place de celles du tour repris. Ne fait rien si le deck est deja pret
+ * @param[in,out] p La partie
+ * @param[in,out] ctx Le contexte, dont le tour repris peut etre en cours
+ */
+static void attendreDeckDiffere(Partie* p, ContexteJeu* ctx) {
+    DeckDiffere* d = p->differe;
+    if (d == NULL) return;
+    thrd_join(d->fil, NULL);
+    p->differe = NULL;
+    if (!d->valide) {
+        fprintf(stderr, "Erreur fatale : Le deck ne correspond pas au point de reprise %s.\n", p->fichierReprise);
+        exit(EXIT_FAILURE);
+    }
+
+    if (ctx->courant == &d->courant) ctx->courant = &p->deck->positions[d->reprise->indiceCourant];
+    if (ctx->objectif == &d->objectif) ctx->objectif = &p->deck->positions[d->reprise->indiceObjectif];
+    libererEtat(&d->courant);
+    libererEtat(&d->objectif);
+}
+
+/**
+ * @brief Applique le verdict d'une soumission deja jugee par le moteur de la partie
+ * @return int ARBITRAGE_CONTINUE, ARBITRAGE_FIN_TOUR ou ARBITRAGE_FIN_ENTREE
+ */
+static int arbitrerSoumission(Partie* p, ContexteJeu* ctx, Soumission* s) {
+    Registre* registre = p->registre;
+    int tour = ctx->tour;
+
+    if (s->fin) return ARBITRAGE_FIN_ENTREE;
+
+    /* Proposition d'un robot pour un tour deja termine */
+    if (s->tour != 0 && s->tour != tour) return ARBITRAGE_CONTINUE;
+
+    if (s->nomJoueur == NULL) return ARBITRAGE_CONTINUE;
+
+    /* Enregistree dans l'ordre de l'arbitrage, robots compris, pour etre rejouee dans le meme tour */
+    if (p->enregistrement != NULL) ecrireLigneSession(p->enregistrement, tour, ++p->rangTour, s->nomJoueur, s->sequence);
+
+    char* nomJoueur = s->nomJoueur;
+    char* sequence = s->sequence;
+    int idJoueur = s->idJoueur;
+
+    if (idJoueur == -1 && strcmp(nomJoueur, COMMANDE_SONDES) == 0) {
+        ecrireSondes(stderr);
+        return ARBITRAGE_CONTINUE;
+    }
+    if (idJoueur == -1 && strcmp(nomJoueur, COMMANDE_MEMOIRE) == 0) {
+        ecrireMemoire(stderr);
+        return ARBITRAGE_CONTINUE;
+    }
+
+    if (idJoueur == -1) {
+        annoncer(p, "Joueur inconnu (%s)\n", nomJoueur);
+        return ARBITRAGE_CONTINUE;
+    }
+
+    if (!estEnLice(registre, idJoueur)) {
+        annoncer(p, "%s ne peut pas jouer durant ce tour\n", nomJoueur);
+        return ARBITRAGE_CONTINUE;
+    }
+
+    if (sequence == NULL) {
+        return ARBITRAGE_CONTINUE;
+    }
+
+    if (!s->jugee) {
+        jugerSoumission(ctx->courant, ctx->objectif, p->config, p->effets, s);
+    }
+    journaliserSoumission(p->journal, p->config, p->numero, (uint32_t)tour, s);
+    if (p->stats != NULL) {
+        noterJugement(p->stats, s->dureeJugement);
+    }
+
+    if (s->codeRetour == -1) {
+
+        char ordreFaux[3] = "??";
+        for (size_t i = 0; i < strlen(sequence); i += 2) {
+            char sub[3];
+            sub[0] = sequence[i];
+            sub[1] = sequence[i + 1];
+            sub[2] = '\0';
+
+            int estValide = (codeCommande(sub, p->config) != 0);
+
+            if (!estValide) {
+                strcpy(ordreFaux, sub);
+                break;
+            }
+        }
+        annoncer(p, "L'ordre %s n'existe pas\n", ordreFaux);
+    }
+
+    /* Le tour suivant ne peut etre pris qu'une fois completement prepare */
+    if (verdictFinitTour(ctx, idJoueur, s->codeRetour, s->bonneSolution)) {
+        if (p->anticipation != NULL) attendreAnticipation(p->anticipation);
+        attendreDeckDiffere(p, ctx);
+    }
+
+    EvenementJeu evts[JEU_EVENEMENTS_MAX];
+    int nb = arbitrerVerdict(ctx, idJoueur, s->codeRetour, s->bonneSolution, evts);
+    return annoncerEvenements(p, evts, nb, (uint32_t)tour);
+}
+
+/**
+ * @brief Top de la roue des minuteries : l'instant present en millisecondes
+ */
+static uint64_t topRoue(void) {
+    return horodatageNs() / 1000000ULL;
+}
+
+/**
+ * @brief Attend la prochaine soumission, au plus jusqu'a la premiere echeance armee de la partie
+ * @return Soumission* La soumission ou NULL si une echeance est passee
+ */
+static Soumission* attendreSoumission(Partie* p, const Minuterie* finTour, const Minuterie* inactivite) {
+    if (!estArmee(finTour) && !estArmee(inactivite)) return retirerSoumission(p->file, 1);
+
+    uint64_t echeance = UINT64_MAX;
+    if (estArmee(finTour)) echeance = finTour->echeance;
+    if (estArmee(inactivite) && inactivite->echeance < echeance) echeance = inactivite->echeance;
+    return retirerSoumissionAvant(p->file, echeance * 1000000ULL);
+}
+
+/**
+ * @brief Avance la roue jusqu'a maintenant et applique les echeances passees : un tour echu
+ *        passe par le moteur comme un tour ou tous ont echoue, un silence trop long finit la partie
+ * @return int ARBITRAGE_CONTINUE, ARBITRAGE_FIN_TOUR ou ARBITRAGE_FIN_ENTREE
+ */
+static int traiterEcheances(Partie* p, ContexteJeu* ctx) {
+    int etat = ARBITRAGE_CONTINUE;
+    for (Minuterie* m = avancerRoue(p->roue, topRoue()); m != NULL; m = m->suivante) {
+        if (m->type == MINUTERIE_INACTIVITE) {
+            annoncer(p, "Aucune soumission depuis %.1f s. Fin de la partie.\n\n", p->delaiInactivite / 1000.0);
+            etat = ARBITRAGE_FIN_ENTREE;
+        }
+        else if (m->type == MINUTERIE_TOUR && etat == ARBITRAGE_CONTINUE) {
+            uint32_t tour = (uint32_t)ctx->tour;
+            if (p->anticipation != NULL) attendreAnticipation(p->anticipation);
+            attendreDeckDiffere(p, ctx);
+            EvenementJeu evts[JEU_EVENEMENTS_MAX];
+            int nb = expirerTour(ctx, evts);
+            etat = annoncerEvenements(p, evts, nb, tour);
+        }
+    }
+    return etat;
+}
+
+/**
+ * @brief Tire les consequences d'un arbitrage sur la boucle des tours
+ * @return int 1 si le tour en cours est fini
+ */
+static int conclureArbitrage(Partie* p, int etat, int* finEntree) {
+    if (etat == ARBITRAGE_FIN_ENTREE) {
+        *finEntree = 1;
+        return 1;
+    }
+    if (etat == ARBITRAGE_FIN_TOUR) {
+        if (p->stats != NULL) p->stats->nbTours++;
+        if (p->rendu != NULL) afficherClassement(p->classement, TOP_CLASSEMENT);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Écrit le point de reprise du tour qui commence. Un échec est signalé sans arrêter la
+ *        partie : le point précédent reste en place
+ * @param[in] p La partie
+ * @param[in] courant Position de départ du tour
+ * @param[in] objectif Objectif du tour
+ * @param[in] tour Tours déjà commencés
+ */
+static void noterReprise(const Partie* p, const EtatJeu* courant, const EtatJeu* objectif, int tour) {
+    PointReprise r;
+    memset(&r, 0, sizeof(r));
+    r.empreinteConfig = empreinteConfiguration(p->config);
+    r.empreinteJoueurs = empreinteRegistre(p->registre);
+    r.graine = p->graine;
+    r.alea = *p->alea;
+    r.tour = (uint32_t)tour;
+    r.rangCourant = rangCarte(p->config, courant);
+    r.rangObjectif = rangCarte(p->config, objectif);
+    r.indiceCourant = (int32_t)(courant - p->deck->positions);
+    r.indiceObjectif = (int32_t)(objectif - p->deck->positions);
+
+    if (!ecrireReprise(p->fichierReprise, &r, p->deck, p->registre)) {
+        fprintf(stderr, "Erreur : Impossible d'ecrire le point de reprise %s.\n", p->fichierReprise);
+    }
+}
+
+/**
+ * @brief Applique un point de reprise
+ * @param[in,out] p La partie
+ * @param[in] r Le point
+ * @param[in,out] d Le deck différé
+ * @return int 1 si appliqué
+ */
+int restaurerPartie(Partie* p, const PointReprise* r, DeckDiffere* d) {
+    int nbPositions = (int)nbEtatsPossibles(p->config->nbAnimaux);
+    if (r->empreinteConfig != empreinteConfiguration(p->config) || r->empreinteJoueurs != empreinteRegistre(p->registre) ||
+        r->nbJoueurs != p->registre->nbJoueurs || r->nbPositions != nbPositions) {
+        return 0;
+    }
+    if (r->indiceCourant < 0 || r->indiceCourant >= nbPositions || r->indiceObjectif < 0 ||
+        r->indiceObjectif >= nbPositions || r->rangCourant >= (uint32_t)nbPositions ||
+        r->rangObjectif >= (uint32_t)nbPositions) {
+        return 0;
+    }
+
+    /* Les cartes du tour repris se retrouvent par leur rang, sans attendre le deck */
+    EtatCompact c;
+    initEtat(&d->courant);
+    initEtat(&d->objectif);
+    etatDeRang(r->rangCourant, p->config->nbAnimaux, &c);
+    developperEtat(p->config, &c, &d->courant);
+    etatDeRang(r->rangObjectif, p->config->nbAnimaux, &c);
+    developperEtat(p->config, &c, &d->objectif);
+
+    d->reprise = r;
+    d->valide = 0;
+    if (thrd_create(&d->fil, genererDeckDiffere, d) != thrd_success) {
+        fprintf(stderr, "Erreur fatale : Impossible de lancer la generation du deck.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    *p->alea = r->alea;
+    for (int i = 0; i < r->nbJoueurs; i++) fixerScore(p->classement, i, r->scores[i]);
+    p->reprise = r;
+    p->differe = d;
+    return 1;
+}
+
+/**
+ * @brief Joue une partie complète
+ * @param[in,out] p La partie
+ * @return int 1 si jouée, 0 si le deck est trop petit
+ */
+int jouerPartie(Partie* p) {
+    ContexteJeu ctx = { p->config, p->registre, p->classement, p->deck, p->alea, p->effets, p->distances,
+                        p->distanceMin, p->distanceMax, NULL, NULL, 0, NULL, NULL, 0 };
+
+    if (p->reprise != NULL) {
+        /* Les cartes du tour repris seront marquées tirées avec les autres par le deck différé */
+        placerTour(&ctx, &p->differe->courant, &p->differe->objectif, (int)p->reprise->tour + 1);
+    }
+    else if (!commencerPartie(&ctx)) {
+        return 0;
+    }
+
+    Soumission* lot[LOT_MAX];
+    int tailleLot = 0;
+    int finEntree = 0;
+
+    /* Minuteries sur la pile : desarmees avant de quitter la partie */
+    Minuterie finTour, inactivite;
+    initMinuterie(&finTour, p, MINUTERIE_TOUR);
+    initMinuterie(&inactivite, p, MINUTERIE_INACTIVITE);
+    if (p->roue != NULL && p->delaiInactivite > 0) armerMinuterie(p->roue, &inactivite, topRoue() + (uint64_t)p->delaiInactivite);
+
+    /* La solution preparee d'avance ne sert qu'aux robots */
+    int avecRobots = 0;
+    for (int i = 0; i < p->registre->nbJoueurs; i++) {
+        if (p->robots[i].type != ROBOT_AUCUN) avecRobots = 1;
+    }
+
+    while (ctx.objectif != NULL && !finEntree) {
+
+        /* Entre deux tours, l'etat de la partie tient dans le point de reprise, deja a jour pour le tour repris */
+        if (p->fichierReprise != NULL && p->differe == NULL) noterReprise(p, ctx.courant, ctx.objectif, ctx.tour - 1);
+
+        /* Ce que le fil d'anticipation a prepare pendant le tour precedent est pris tel quel */
+        Anticipation* a = p->anticipation;
+        int prepare = (a != NULL && estAnticipe(a, ctx.courant, ctx.objectif));
+
+        if (p->rendu != NULL) {
+            if (prepare && a->avecRendu) ecrireTrame(&a->rendu);
+            else ecrireDuel(p->rendu, ctx.courant, ctx.objectif);
+        }
+
+        /* Les robots jouent des le debut du tour, par la meme file que les lignes saisies. En rejeu,
+           leurs lignes enregistrees arrivent par l'entree : ils ne font que les memes tirages */
+        journaliserTour(p->journal, p->config, p->numero, (uint32_t)ctx.tour, ctx.courant, ctx.objectif);
+        p->rangTour = 0;
+        jouerRobotsResolus(p->robots, p->registre, p->solveur, p->config, ctx.courant, ctx.objectif, ctx.tour, p->alea,
+                           p->rejeuParTour ? NULL : p->file, prepare ? a->longueurSolution : -2, prepare ? a->solution : NULL);
+
+        /* Plus rien ne touche au generateur, au deck ni au solveur avant la fin du tour. Le tour
+           repris n'est pas anticipe : son suivant est tire en fin de tour, dans le meme ordre */
+        if (a != NULL && p->differe == NULL) lancerAnticipation(a, &ctx, avecRobots ? p->solveur : NULL, p->rendu != NULL);
+
+        if (p->roue != NULL && p->delaiTour > 0) armerMinuterie(p->roue, &finTour, topRoue() + (uint64_t)p->delaiTour);
+
+        int tourTermine = 0;
+
+
+        while (!tourTermine) {
+
+            /* Les echeances passees, meme pendant que les soumissions affluent, finissent le tour */
+            if (p->roue != NULL) {
+                tourTermine = conclureArbitrage(p, traiterEcheances(p, &ctx), &finEntree);
+                if (tourTermine) continue;
+            }
+
+            /* Attente d'au moins une soumission puis ramassage de celles deja arrivees */
+            if (tailleLot == 0) {
+                Soumission* s = (p->roue != NULL) ? attendreSoumission(p, &finTour, &inactivite) : retirerSoumission(p->file, 1);
+                if (s == NULL) continue;
+                lot[tailleLot++] = s;
+            }
+            while (tailleLot < LOT_MAX) {
+                Soumission* s = retirerSoumission(p->file, 0);
+                if (s == NULL) break;
+                insererParHorodatage(lot, &tailleLot, s);
+            }
+            if (estArmee(&inactivite)) armerMinuterie(p->roue, &inactivite, topRoue() + (uint64_t)p->delaiInactivite);
+
+            for (int i = 0; i < tailleLot; i++) {
+                analyserSoumission(lot[i], p->registre);
+            }
+
+            jugerLot(p->juges, ctx.courant, ctx.objectif, p->config, p->effets, p->registre, ctx.tour, lot, tailleLot);
+
+            /* Arbitrage dans l'ordre d'arrivee : la premiere bonne solution l'emporte et le moteur
+               tire aussitot les cartes du tour suivant */
+            int traitees = 0;
+            while (traitees < tailleLot && !tourTermine) {
+                Soumission* s = lot[traitees++];
+                int etat = arbitrerSoumission(p, &ctx, s);
+                libererMem(s);
+                tourTermine = conclureArbitrage(p, etat, &finEntree);
+            }
+
+            /* Les soumissions restantes seront jugees sur le tour suivant */
+            tailleLot -= traitees;
+            memmove(lot, lot + traitees, sizeof(Soumission*) * tailleLot);
+            for (int i = 0; i < tailleLot; i++) lot[i]->jugee = 0;
+        }
+    }
+
+    /* Une partie finie ne se reprend pas : la meme commande en commencera une nouvelle */
+    if (p->fichierReprise != NULL && ctx.objectif == NULL && !effacerReprise(p->fichierReprise)) {
+        fprintf(stderr, "Erreur : Impossible d'effacer le point de reprise %s.\n", p->fichierReprise);
+    }
+
+    /* Le fil d'anticipation peut encore lire le contexte, qui vit sur cette pile */
+    if (p->anticipation != NULL) attendreAnticipation(p->anticipation);
+    attendreDeckDiffere(p, &ctx);
+    if (p->roue != NULL) {
+        annulerMinuterie(p->roue, &finTour);
+        annulerMinuterie(p->roue, &inactivite);
+    }
+    for (int i = 0; i < tailleLot; i++) libererMem(lot[i]);
+    return 1;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdio.h>
+#include <threads.h>
+#include "jeu.h"
+#include "affichage.h"
+#include "distances.h"
+#include "classement.h"
+#include "rejeu.h"
+#include "robot.h"
+#include "soumission.h"
+#include "journal.h"
+#include "reprise.h"
+#include "roue.h"
+#include "anticipation.h"
+
+/**
+ * @struct DeckDiffere
+ * @brief Deck d'une partie reprise et ses tables, générés sur un fil pendant le tour repris :
+ *        seules les deux cartes de ce tour sont retrouvées avant de jouer, par leur rang
+ */
+typedef struct {
+    const ConfigJeu* config;
+    Deck* deck;                  /* Généré, découpé en composantes puis remis dans l'état du point */
+    Distances* distances;        /* Calculées sur le deck, NULL sans bande de difficulté */
+    int nbFils;                  /* Fils de calcul des composantes et des distances */
+    const PointReprise* reprise;
+    EtatJeu courant;             /* Cartes du tour repris, hors du deck jusqu'à ce qu'il soit prêt */
+    EtatJeu objectif;
+    int valide;                  /* 1 si le deck prêt a les cartes du tour aux indices du point */
+    thrd_t fil;
+} DeckDiffere;
+
+/**
+ * @struct Partie
+ * @brief Tout ce dont une partie a besoin. Rien n'est global : plusieurs parties peuvent être
+ *        jouées en même temps sur des fils différents tant qu'elles ne partagent aucun champ
+ *        modifiable (seule la configuration peut être commune)
+ */
+typedef struct {
+    const ConfigJeu* config;
+    Registre* registre;          /* Joueurs remis en lice à chaque tour */
+    Classement* classement;      /* Scores de la partie */
+    Deck* deck;                  /* Paquet propre à la partie */
+    Alea* alea;                  /* Hasard des tirages et des robots */
+    const Robot* robots;         /* Réglages de chaque joueur, indexés comme le registre */
+    Solveur* solveur;            /* Utilisé par les robots */
+    FileSoumissions* file;       /* Lignes saisies et propositions des robots */
+    PoolJuges* juges;            /* NULL pour juger sur le fil de la partie */
+    Rendu* rendu;                /* NULL pour ne pas afficher les podiums ni le classement */
+    FILE* sortie;                /* Flux des verdicts, NULL pour n'en écrire aucun */
+    Statistiques* stats;         /* NULL si rien n'est mesuré */
+    const Distances* distances;  /* NULL pour tirer les objectifs sans regarder leur difficulté */
+    int distanceMin;             /* Bande de longueur de solution des objectifs, si distances est donné */
+    int distanceMax;
+    Journal* journal;            /* NULL pour ne rien journaliser */
+    uint32_t numero;             /* Numéro de la partie dans le journal */
+    const char* fichierReprise;  /* Point de reprise réécrit au début de chaque tour, NULL sinon */
+    const PointReprise* reprise; /* Point appliqué par restaurerPartie, NULL pour une nouvelle partie */
+    uint64_t graine;             /* Écrite dans le point de reprise */
+    CacheEffets* effets;         /* Effets des séquences déjà jugées, NULL pour juger sur une copie des piles */
+    RoueTemps* roue;             /* Roue du fil de la partie, à la milliseconde, NULL pour attendre sans délai */
+    int delaiTour;               /* Durée maximale d'un tour en millisecondes, 0 pour aucune */
+    int delaiInactivite;         /* Fin de la partie après ce silence en millisecondes, 0 pour jamais */
+    Anticipation* anticipation;  /* Fil qui prépare le tour suivant pendant le tour, NULL pour tout faire en fin de tour */
+    DeckDiffere* differe;        /* Deck d'une partie reprise encore en génération, NULL s'il est prêt */
+    FILE* enregistrement;        /* Lignes arbitrées, avec leur tour et leur rang, NULL pour ne rien enregistrer */
+    int rejeuParTour;            /* 1 si les lignes des robots viennent de la session rejouée */
+    int rangTour;                /* Lignes déjà enregistrées durant le tour en cours */
+} Partie;
+
+
+
+/**
+ * @brief Joue une partie jusqu'à épuisement du deck ou jusqu'au marqueur de fin d'entrée.
+ *        Les scores se lisent ensuite dans le registre et le classement
+ * @param[in,out] p Pointeur vers la partie, dont le deck est plein et les joueurs inscrits
+ * @return int 1 si la partie a eu lieu, 0 si le deck n'a pas assez de cartes
+ */
+int jouerPartie(Partie* p);
+
+/**
+ * @brief Remet le générateur et les scores dans l'état d'un point de reprise, retrouve les
+ *        cartes du tour sauvegardé par leur rang et lance la génération du deck sur un fil :
+ *        jouerPartie reprend aussitôt ce tour, et n'attend le deck qu'au premier tirage
+ * @param[in,out] p La partie, dont le classement est initialisé et le deck pas encore généré
+ * @param[in] r Le point lu, qui doit rester en vie jusqu'à la fin de jouerPartie
+ * @param[in,out] d Le deck différé, dont config, deck, distances et nbFils sont remplis
+ * @return int 1 si appliqué, 0 si le point ne correspond pas à cette configuration ou à ces joueurs
+ */
+int restaurerPartie(Partie* p, const PointReprise* r, DeckDiffere* d);
@@ -0,0 +1,287 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "rejeu.h"
+#include "soumission.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Copie une vue dans une chaîne allouée terminée par '\0'
+ */
+static char* copierVue(Vue v) {
+    char* s = (char*)allouerMem(MEM_DIVERS, v.longueur + 1);
+    if (s == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour la session.\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(s, v.debut, v.longueur);
+    s[v.longueur] = '\0';
+    return s;
+}
+
+/**
+ * @brief Indique si une vue est égale à une chaîne
+ */
+static int vueEgale(Vue v, const char* s) {
+    return strlen(s) == v.longueur && memcmp(v.debut, s, v.longueur) == 0;
+}
+
+/**
+ * @brief Lit l'en-tête d'une session
+ * @param[in,out] l Le lecteur
+ * @param[out] s La session
+ * @return int 1 si l'en-tête est complet
+ */
+int lireEnteteSession(Lecteur* l, Session* s) {
+    s->graine = 0;
+    s->nomsJoueurs = NULL;
+    s->nbJoueurs = 0;
+    s->aConfig = 0;
+    s->distanceMin = -1;
+    s->distanceMax = -1;
+    s->parTour = 0;
+    s->config.nbAnimaux = 0;
+    s->config.nbOrdres = 0;
+
+    char* animaux = NULL;
+    char* ordres = NULL;
+    int aGraine = 0;
+    int complet = 0;
+
+    Vue ligne;
+    while (lireLigne(l, &ligne)) {
+        if (ligne.longueur > 0 && ligne.debut[ligne.longueur - 1] == '\r') ligne.longueur--;
+        if (vueEgale(ligne, FIN_ENTETE_SESSION)) {
+            complet = 1;
+            break;
+        }
+
+        Vue cle;
+        if (decouperVue(ligne, &cle, 1) == 0 || cle.debut[0] == '#') continue;
+
+        /* Le reste de la ligne après la clé */
+        Vue valeur = { cle.debut + cle.longueur, (size_t)(ligne.debut + ligne.longueur - (cle.debut + cle.longueur)) };
+
+        if (vueEgale(cle, "graine")) {
+            char* texte = copierVue(valeur);
+            s->graine = (uint64_t)strtoull(texte, NULL, 10);
+            aGraine = 1;
+            libererMem(texte);
+        }
+        else if (vueEgale(cle, "joueurs")) {
+            int max = (int)valeur.longueur / 2 + 1;
+            Vue* noms = (Vue*)allouerMem(MEM_DIVERS, sizeof(Vue) * max);
+            s->nomsJoueurs = (char**)allouerMem(MEM_DIVERS, sizeof(char*) * max);
+            if (noms == NULL || s->nomsJoueurs == NULL) {
+                fprintf(stderr, "Erreur fatale : Memoire insuffisante pour la session.\n");
+                exit(EXIT_FAILURE);
+            }
+            s->nbJoueurs = decouperVue(valeur, noms, max);
+            for (int i = 0; i < s->nbJoueurs; i++) s->nomsJoueurs[i] = copierVue(noms[i]);
+            libererMem(noms);
+        }
+        else if (vueEgale(cle, "animaux")) {
+            libererMem(animaux);
+            animaux = copierVue(valeur);
+        }
+        else if (vueEgale(cle, "ordres")) {
+            libererMem(ordres);
+            ordres = copierVue(valeur);
+        }
+        else if (vueEgale(cle, "difficulte")) {
+            char* texte = copierVue(valeur);
+            if (sscanf(texte, "%d %d", &s->distanceMin, &s->distanceMax) != 2) s->distanceMin = s->distanceMax = -1;
+            libererMem(texte);
+        }
+        else if (vueEgale(cle, "tours")) {
+            s->parTour = 1;
+        }
+    }
+
+    if (animaux != NULL) {
+        chargerConfigurationLignes(&s->config, animaux, ordres);
+        s->aConfig = 1;
+    }
+    libererMem(animaux);
+    libererMem(ordres);
+
+    return complet && aGraine && s->aConfig && s->nbJoueurs > 0;
+}
+
+/**
+ * @brief Libère une session
+ * @param[in,out] s La session
+ */
+void libererSession(Session* s) {
+    for (int i = 0; i < s->nbJoueurs; i++) libererMem(s->nomsJoueurs[i]);
+    libererMem(s->nomsJoueurs);
+    s->nomsJoueurs = NULL;
+    s->nbJoueurs = 0;
+    if (s->aConfig) libererConfiguration(&s->config);
+    s->aConfig = 0;
+}
+
+/**
+ * @brief Écrit l'en-tête d'une session
+ * @param[in,out] f Le fichier
+ * @param[in] graine La graine
+ * @param[in] registre Les joueurs
+ * @param[in] config La configuration
+ * @param[in] distanceMin Borne basse de la bande, -1 sans bande
+ * @param[in] distanceMax Borne haute de la bande
+ */
+void ecrireEnteteSession(FILE* f, uint64_t graine, const Registre* registre, const ConfigJeu* config,
+                         int distanceMin, int distanceMax) {
+    fprintf(f, "graine %llu\n", (unsigned long long)graine);
+
+    fprintf(f, "joueurs");
+    for (int i = 0; i < registre->nbJoueurs; i++) fprintf(f, " %s", registre->joueurs[i].nom);
+
+    fprintf(f, "\nanimaux");
+    for (int i = 0; i < config->nbAnimaux; i++) fprintf(f, " %s", config->nomsAnimaux[i]);
+
+    fprintf(f, "\nordres");
+    for (int i = 0; i < config->nbOrdres; i++) fprintf(f, " %s", config->ordres[i]);
+    for (int i = 0; i < config->nbMacros; i++) fprintf(f, " %s=%s", config->macros[i].nom, config->macros[i].expansion);
+
+    if (distanceMin >= 0) fprintf(f, "\ndifficulte %d %d", distanceMin, distanceMax);
+
+    /* Les lignes suivantes portent leur tour et leur rang */
+    fprintf(f, "\ntours");
+
+    fprintf(f, "\n%s\n", FIN_ENTETE_SESSION);
+    fflush(f);
+}
+
+/**
+ * @brief Écrit une ligne arbitrée avec son tour et son rang
+ * @param[in,out] f Le fichier
+ * @param[in] tour Le tour
+ * @param[in] rang Le rang dans le tour
+ * @param[in] nomJoueur Le nom
+ * @param[in] sequence La séquence, NULL si absente
+ */
+void ecrireLigneSession(FILE* f, int tour, int rang, const char* nomJoueur, const char* sequence) {
+    fprintf(f, "%d %d %s", tour, rang, nomJoueur);
+    if (sequence != NULL) fprintf(f, " %s", sequence);
+    fputc('\n', f);
+    fflush(f);
+}
+
+/**
+ * @brief Lit un entier positif au début d'une vue et l'espace qui le suit
+ * @return int 1 si lu
+ */
+static int lireEntierVue(Vue* v, int* n) {
+    size_t i = 0;
+    long valeur = 0;
+    while (i < v->longueur && v->debut[i] >= '0' && v->debut[i] <= '9' && valeur < INT_MAX / 10) {
+        valeur = valeur * 10 + (v->debut[i] - '0');
+        i++;
+    }
+    if (i == 0 || i == v->longueur || v->debut[i] != ' ') return 0;
+    *n = (int)valeur;
+    v->debut += i + 1;
+    v->longueur -= i + 1;
+    return 1;
+}
+
+/**
+ * @brief Retire le tour et le rang d'une ligne de session
+ * @param[in,out] ligne La ligne
+ * @param[out] tour Son tour
+ * @return int 1 si la ligne les portait
+ */
+int lireLigneSession(Vue* ligne, int* tour) {
+    Vue reste = *ligne;
+    int rang;
+    if (!lireEntierVue(&reste, tour) || !lireEntierVue(&reste, &rang) || *tour <= 0) return 0;
+    *ligne = reste;
+    return 1;
+}
+
+/**
+ * @brief Démarre les statistiques
+ * @param[out] st Les statistiques
+ */
+void initStatistiques(Statistiques* st) {
+    st->debut = horodatageNs();
+    st->nbParties = 0;
+    st->nbTours = 0;
+    st->nbSoumissions = 0;
+    st->capacite = 1024;
+    st->durees = (unsigned long long*)allouerMem(MEM_DIVERS, sizeof(unsigned long long) * st->capacite);
+    if (st->durees == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les statistiques.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Libère les statistiques
+ * @param[in,out] st Les statistiques
+ */
+void libererStatistiques(Statistiques* st) {
+    libererMem(st->durees);
+    st->durees = NULL;
+    st->capacite = 0;
+}
+
+/**
+ * @brief Enregistre la durée d'un jugement
+ * @param[in,out] st Les statistiques
+ * @param[in] duree Durée en nanosecondes
+ */
+void noterJugement(Statistiques* st, unsigned long long duree) {
+    if (st->nbSoumissions == st->capacite) {
+        st->capacite *= 2;
+        unsigned long long* nouv = (unsigned long long*)reallouerMem(MEM_DIVERS, st->durees, sizeof(unsigned long long) * st->capacite);
+        if (nouv == NULL) {
+            fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les statistiques.\n");
+            exit(EXIT_FAILURE);
+        }
+        st->durees = nouv;
+    }
+    st->durees[st->nbSoumissions++] = duree;
+}
+
+/**
+ * @brief Comparaison de deux durées pour qsort
+ */
+static int compareDurees(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a;
+    unsigned long long y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Durée au centile p (entre 0 et 100) d'un tableau trié, en microsecondes
+ */
+static double centile(const Statistiques* st, double p) {
+    if (st->nbSoumissions == 0) return 0.0;
+    long i = (long)(p / 100.0 * (double)(st->nbSoumissions - 1) + 0.5);
+    return (double)st->durees[i] / 1000.0;
+}
+
+/**
+ * @brief Affiche les débits et les centiles
+ * @param[in,out] st Les statistiques
+ * @param[in] titre Début de la ligne des débits
+ */
+void afficherStatistiques(Statistiques* st, const char* titre) {
+    double secondes = (double)(horodatageNs() - st->debut) / 1e9;
+    if (secondes <= 0) secondes = 1e-9;
+
+    qsort(st->durees, st->nbSoumissions, sizeof(unsigned long long), compareDurees);
+
+    if (st->nbParties > 0) {
+        printf("Parties : %ld en %.3f s (%.2f parties/s)\n", st->nbParties, secondes, st->nbParties / secondes);
+    }
+    printf("%s : %ld tours en %.3f s (%.1f tours/s), %ld soumissions (%.1f soumissions/s)\n",
+           titre, st->nbTours, secondes, st->nbTours / secondes, st->nbSoumissions, st->nbSoumissions / secondes);
+    printf("Jugement (us) : p50 %.2f | p90 %.2f | p99 %.2f | max %.2f\n",
+           centile(st, 50), centile(st, 90), centile(st, 99), centile(st, 100));
+}
\ No newline at end of file
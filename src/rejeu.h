@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include "animal.h"
+#include "joueurs.h"
+#include "lecture.h"
+
+/**
+ * @def FIN_ENTETE_SESSION
+ * @brief Ligne qui sépare l'en-tête d'une session enregistrée des lignes saisies
+ */
+#define FIN_ENTETE_SESSION "---"
+
+/**
+ * @struct Session
+ * @brief En-tête d'une partie enregistrée : tout ce qu'il faut pour la rejouer à l'identique.
+ *        Format, une clé par ligne puis les lignes saisies :
+ *        graine 1234 / joueurs A B / animaux LION OURS / ordres KI LO SO / ---
+ *        La ligne facultative difficulte 4 6 donne la bande de difficulté des objectifs. Avec la
+ *        ligne tours, chaque ligne jugée, robots compris, est précédée de son tour et de son rang
+ *        d'arrivée dans ce tour (ex : 3 1 A KISO) : le rejeu l'arbitre dans ce tour et dans cet ordre
+ */
+typedef struct {
+    uint64_t graine;      /* Graine du générateur de la partie */
+    char** nomsJoueurs;   /* Copies des noms des joueurs */
+    int nbJoueurs;
+    ConfigJeu config;     /* Configuration de la partie */
+    int aConfig;          /* 1 si les lignes animaux et ordres ont été lues */
+    int distanceMin;      /* Bande de difficulté des objectifs, -1 sans ligne difficulte */
+    int distanceMax;
+    int parTour;          /* 1 si les lignes portent leur tour et leur rang (ligne tours) */
+} Session;
+
+/**
+ * @struct Statistiques
+ * @brief Mesures relevées pendant un rejeu ou une partie entre robots
+ */
+typedef struct {
+    unsigned long long debut;     /* Horodatage du début de la partie */
+    long nbParties;               /* Parties terminées, affichées si non nul */
+    long nbTours;                 /* Tours terminés */
+    long nbSoumissions;           /* Soumissions jugées */
+    unsigned long long* durees;   /* Durée de chaque jugement en nanosecondes */
+    long capacite;
+} Statistiques;
+
+
+
+/**
+ * @brief Lit l'en-tête d'une session jusqu'à la ligne FIN_ENTETE_SESSION
+ * @param[in,out] l Lecteur placé au début du fichier, laissé sur la première ligne saisie
+ * @param[out] s Pointeur vers la session à remplir
+ * @return int 1 si l'en-tête est complet, 0 sinon
+ */
+int lireEnteteSession(Lecteur* l, Session* s);
+
+/**
+ * @brief Libère les noms et la configuration d'une session
+ * @param[in,out] s Pointeur vers la session
+ */
+void libererSession(Session* s);
+
+/**
+ * @brief Écrit l'en-tête d'une session pour pouvoir la rejouer plus tard
+ * @param[in,out] f Fichier d'enregistrement
+ * @param[in] graine Graine de la partie
+ * @param[in] registre Joueurs inscrits
+ * @param[in] config Configuration de la partie
+ * @param[in] distanceMin Plus courte solution des objectifs, -1 pour ne pas écrire de bande
+ * @param[in] distanceMax Plus longue solution des objectifs
+ */
+void ecrireEnteteSession(FILE* f, uint64_t graine, const Registre* registre, const ConfigJeu* config,
+                         int distanceMin, int distanceMax);
+
+/**
+ * @brief Écrit une ligne arbitrée, précédée de son tour et de son rang d'arrivée dans ce tour
+ * @param[in,out] f Fichier d'enregistrement
+ * @param[in] tour Tour où la ligne a été arbitrée (à partir de 1)
+ * @param[in] rang Rang de la ligne parmi celles arbitrées durant ce tour (à partir de 1)
+ * @param[in] nomJoueur Premier mot de la ligne
+ * @param[in] sequence Second mot, NULL s'il n'y en a pas
+ */
+void ecrireLigneSession(FILE* f, int tour, int rang, const char* nomJoueur, const char* sequence);
+
+/**
+ * @brief Retire le tour et le rang du début d'une ligne écrite par ecrireLigneSession
+ * @param[in,out] ligne La ligne, réduite au texte saisi
+ * @param[out] tour Tour de la ligne
+ * @return int 1 si la ligne commence bien par un tour et un rang, 0 sinon (ligne inchangée)
+ */
+int lireLigneSession(Vue* ligne, int* tour);
+
+
+/**
+ * @brief Initialise les statistiques et démarre le chronomètre
+ * @param[out] st Pointeur vers les statistiques
+ */
+void initStatistiques(Statistiques* st);
+
+/**
+ * @brief Libère les mesures
+ * @param[in,out] st Pointeur vers les statistiques
+ */
+void libererStatistiques(Statistiques* st);
+
+/**
+ * @brief Enregistre la durée d'un jugement
+ * @param[in,out] st Pointeur vers les statistiques
+ * @param[in] duree Durée en nanosecondes
+ */
+void noterJugement(Statistiques* st, unsigned long long duree);
+
+/**
+ * @brief Affiche les débits (parties/s, tours/s, soumissions/s) et les centiles de durée de jugement
+ * @param[in,out] st Pointeur vers les statistiques (les durées sont triées)
+ * @param[in] titre Début de la ligne des débits (ex : "Rejeu")
+ */
+void afficherStatistiques(Statistiques* st, const char* titre);
\ No newline at end of file
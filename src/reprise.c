@@ -0,0 +1,311 @@
+#define _POSIX_C_SOURCE 200809L
+#define _CRT_SECURE_NO_WARNINGS
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "reprise.h"
+#include "etatcompact.h"
+#include "memoire.h"
+
+#define FNV_BASE 0xCBF29CE484222325ULL
+#define FNV_PREMIER 0x100000001B3ULL
+
+/**
+ * @def MOTS_PAR_ECRITURE
+ * @brief Marqueurs du deck copiés sur la pile avant chaque fwrite
+ */
+#define MOTS_PAR_ECRITURE 512
+
+
+/**
+ * @struct EnteteReprise
+ * @brief Début du fichier, suivi des scores (int32_t), des marqueurs (uint64_t) puis de la somme
+ *        FNV-1a de tout ce qui précède. Ordre des octets de la machine
+ */
+typedef struct {
+    char magie[4];
+    uint32_t nbJoueurs;
+    uint64_t empreinteConfig;
+    uint64_t empreinteJoueurs;
+    uint64_t graine;
+    uint64_t alea[4];
+    uint32_t tour;
+    uint32_t rangCourant;
+    uint32_t rangObjectif;
+    int32_t indiceCourant;
+    int32_t indiceObjectif;
+    uint32_t nbPositions;
+    uint32_t nbMots;
+    uint32_t reserve;
+} EnteteReprise;
+
+_Static_assert(sizeof(EnteteReprise) == 96, "EnteteReprise ne doit pas avoir de remplissage");
+
+
+/**
+ * @brief Poursuit une empreinte FNV-1a sur des octets
+ */
+static uint64_t hacher(uint64_t h, const void* octets, size_t taille) {
+    const unsigned char* o = (const unsigned char*)octets;
+    for (size_t i = 0; i < taille; i++) {
+        h ^= o[i];
+        h *= FNV_PREMIER;
+    }
+    return h;
+}
+
+/**
+ * @brief Poursuit une empreinte sur une chaîne, terminateur compris pour séparer les noms
+ */
+static uint64_t hacherChaine(uint64_t h, const char* s) {
+    return hacher(h, s, strlen(s) + 1);
+}
+
+/**
+ * @brief Empreinte de la configuration
+ * @param[in] config La configuration
+ * @return uint64_t L'empreinte
+ */
+uint64_t empreinteConfiguration(const ConfigJeu* config) {
+    uint64_t h = FNV_BASE;
+    for (int i = 0; i < config->nbAnimaux; i++) h = hacherChaine(h, config->nomsAnimaux[i]);
+    h = hacherChaine(h, "|");
+    for (int i = 0; i < config->nbOrdres; i++) h = hacherChaine(h, config->ordres[i]);
+    for (int i = 0; i < config->nbMacros; i++) {
+        h = hacherChaine(h, config->macros[i].nom);
+        h = hacherChaine(h, config->macros[i].expansion);
+    }
+    return h;
+}
+
+/**
+ * @brief Empreinte des joueurs
+ * @param[in] registre Le registre
+ * @return uint64_t L'empreinte
+ */
+uint64_t empreinteRegistre(const Registre* registre) {
+    uint64_t h = FNV_BASE;
+    for (int i = 0; i < registre->nbJoueurs; i++) h = hacherChaine(h, registre->joueurs[i].nom);
+    return h;
+}
+
+/**
+ * @brief Écrit un bloc et l'ajoute à la somme de contrôle
+ * @return int 1 si écrit
+ */
+static int ecrireBloc(FILE* f, const void* octets, size_t taille, uint64_t* somme) {
+    *somme = hacher(*somme, octets, taille);
+    return fwrite(octets, 1, taille, f) == taille;
+}
+
+/**
+ * @brief Lit un bloc et l'ajoute à la somme de contrôle
+ * @return int 1 si lu en entier
+ */
+static int lireBloc(FILE* f, void* octets, size_t taille, uint64_t* somme) {
+    if (fread(octets, 1, taille, f) != taille) return 0;
+    *somme = hacher(*somme, octets, taille);
+    return 1;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Synchronise sur le disque le répertoire d'un fichier, pour que son renommage survive
+ *        à une coupure
+ * @return int 1 si synchronisé
+ */
+static int synchroniserRepertoire(const char* chemin) {
+    const char* fin = strrchr(chemin, '/');
+    /* "." pour un fichier du répertoire courant, "/" pour un fichier à la racine */
+    size_t taille = (fin == NULL) ? 1 : (fin == chemin) ? 1 : (size_t)(fin - chemin);
+    char* repertoire = (char*)allouerMem(MEM_DIVERS, taille + 1);
+    if (repertoire == NULL) return 0;
+    memcpy(repertoire, (fin == NULL) ? "." : chemin, taille);
+    repertoire[taille] = '\0';
+
+    int fd = open(repertoire, O_RDONLY);
+    libererMem(repertoire);
+    if (fd < 0) return 0;
+    int ok = (fsync(fd) == 0);
+    if (close(fd) != 0) ok = 0;
+    return ok;
+}
+#endif
+
+/**
+ * @brief Remplace atomiquement destination par source, renommage compris sur le disque
+ * @return int 1 si remplacé
+ */
+static int remplacerFichier(const char* source, const char* destination) {
+#ifdef _WIN32
+    return MoveFileExA(source, destination, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(source, destination) == 0 && synchroniserRepertoire(destination);
+#endif
+}
+
+/**
+ * @brief Écrit le point de reprise
+ * @param[in] chemin Chemin visé
+ * @param[in] r En-tête
+ * @param[in] deck Le deck
+ * @param[in] registre Le registre
+ * @return int 1 si écrit
+ */
+int ecrireReprise(const char* chemin, const PointReprise* r, const Deck* deck, const Registre* registre) {
+    size_t taille = strlen(chemin) + 5;
+    char* temporaire = (char*)allouerMem(MEM_DIVERS, taille);
+    if (temporaire == NULL) return 0;
+    snprintf(temporaire, taille, "%s.tmp", chemin);
+
+    FILE* f = fopen(temporaire, "wb");
+    if (f == NULL) {
+        libererMem(temporaire);
+        return 0;
+    }
+
+    EnteteReprise e;
+    memset(&e, 0, sizeof(e));
+    memcpy(e.magie, REPRISE_MAGIE, 4);
+    e.nbJoueurs = (uint32_t)registre->nbJoueurs;
+    e.empreinteConfig = r->empreinteConfig;
+    e.empreinteJoueurs = r->empreinteJoueurs;
+    e.graine = r->graine;
+    memcpy(e.alea, r->alea.etat, sizeof(e.alea));
+    e.tour = r->tour;
+    e.rangCourant = r->rangCourant;
+    e.rangObjectif = r->rangObjectif;
+    e.indiceCourant = r->indiceCourant;
+    e.indiceObjectif = r->indiceObjectif;
+    e.nbPositions = (uint32_t)deck->nbPositions;
+    e.nbMots = (uint32_t)deck->nbMots;
+
+    uint64_t somme = FNV_BASE;
+    int ok = ecrireBloc(f, &e, sizeof(e), &somme);
+    for (int i = 0; ok && i < registre->nbJoueurs; i++) {
+        int32_t score = registre->joueurs[i].score;
+        ok = ecrireBloc(f, &score, sizeof(score), &somme);
+    }
+
+    uint64_t mots[MOTS_PAR_ECRITURE];
+    for (int m = 0; ok && m < deck->nbMots; m += MOTS_PAR_ECRITURE) {
+        int nb = (deck->nbMots - m < MOTS_PAR_ECRITURE) ? deck->nbMots - m : MOTS_PAR_ECRITURE;
+        for (int k = 0; k < nb; k++) mots[k] = atomic_load_explicit(&deck->estUtilisee[m + k], memory_order_relaxed);
+        ok = ecrireBloc(f, mots, sizeof(uint64_t) * (size_t)nb, &somme);
+    }
+    if (ok) ok = (fwrite(&somme, sizeof(somme), 1, f) == 1);
+
+    /* Le contenu doit être sur le disque avant le renommage, sinon une coupure peut laisser un fichier vide */
+    if (ok) ok = (fflush(f) == 0);
+#ifdef _WIN32
+    if (ok) ok = (_commit(_fileno(f)) == 0);
+#else
+    if (ok) ok = (fsync(fileno(f)) == 0);
+#endif
+    if (fclose(f) != 0) ok = 0;
+
+    if (ok) ok = remplacerFichier(temporaire, chemin);
+    if (!ok) remove(temporaire);
+    libererMem(temporaire);
+    return ok;
+}
+
+/**
+ * @brief Efface le point de reprise
+ * @param[in] chemin Chemin du point
+ * @return int 1 si effacé ou absent
+ */
+int effacerReprise(const char* chemin) {
+    FILE* f = fopen(chemin, "rb");
+    if (f == NULL) return 1;
+    fclose(f);
+    if (remove(chemin) != 0) return 0;
+#ifdef _WIN32
+    return 1;
+#else
+    return synchroniserRepertoire(chemin);
+#endif
+}
+
+/**
+ * @brief Lit un point de reprise
+ * @param[in] chemin Chemin du point
+ * @param[out] r Le point
+ * @return int REPRISE_LUE, REPRISE_ABSENTE ou REPRISE_INVALIDE
+ */
+int lireReprise(const char* chemin, PointReprise* r) {
+    memset(r, 0, sizeof(PointReprise));
+    FILE* f = fopen(chemin, "rb");
+    if (f == NULL) return REPRISE_ABSENTE;
+
+    EnteteReprise e;
+    uint64_t somme = FNV_BASE;
+    if (!lireBloc(f, &e, sizeof(e), &somme) || memcmp(e.magie, REPRISE_MAGIE, 4) != 0 ||
+        e.nbJoueurs >= INT_MAX || e.nbPositions > nbEtatsPossibles(MAX_ANIMAUX) || e.nbMots != (e.nbPositions + 63) / 64) {
+        fclose(f);
+        return REPRISE_INVALIDE;
+    }
+
+    /* Les tailles viennent d'un en-tête pas encore vérifié par la somme : elles doivent décrire
+       exactement le fichier avant de servir à allouer */
+    uint64_t attendu = sizeof(e) + sizeof(int32_t) * (uint64_t)e.nbJoueurs + sizeof(uint64_t) * (uint64_t)e.nbMots +
+                       sizeof(uint64_t);
+    long debut = ftell(f);
+    long taille = (debut >= 0 && fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    if (taille < 0 || (uint64_t)taille != attendu || fseek(f, debut, SEEK_SET) != 0) {
+        fclose(f);
+        return REPRISE_INVALIDE;
+    }
+
+    r->empreinteConfig = e.empreinteConfig;
+    r->empreinteJoueurs = e.empreinteJoueurs;
+    r->graine = e.graine;
+    memcpy(r->alea.etat, e.alea, sizeof(e.alea));
+    r->tour = e.tour;
+    r->rangCourant = e.rangCourant;
+    r->rangObjectif = e.rangObjectif;
+    r->indiceCourant = e.indiceCourant;
+    r->indiceObjectif = e.indiceObjectif;
+    r->nbJoueurs = (int)e.nbJoueurs;
+    r->nbPositions = (int)e.nbPositions;
+    r->nbMots = (int)e.nbMots;
+    r->scores = (int*)allouerMem(MEM_DIVERS, sizeof(int) * (r->nbJoueurs + 1));
+    r->utilisees = (uint64_t*)allouerMem(MEM_DIVERS, sizeof(uint64_t) * (r->nbMots + 1));
+
+    int ok = (r->scores != NULL && r->utilisees != NULL);
+    for (int i = 0; ok && i < r->nbJoueurs; i++) {
+        int32_t score;
+        ok = lireBloc(f, &score, sizeof(score), &somme);
+        r->scores[i] = score;
+    }
+    if (ok) ok = lireBloc(f, r->utilisees, sizeof(uint64_t) * (size_t)r->nbMots, &somme);
+
+    uint64_t attendue;
+    if (ok) ok = (fread(&attendue, sizeof(attendue), 1, f) == 1 && attendue == somme);
+    fclose(f);
+
+    if (!ok) {
+        libererReprise(r);
+        return REPRISE_INVALIDE;
+    }
+    return REPRISE_LUE;
+}
+
+/**
+ * @brief Libère un point lu
+ * @param[in,out] r Le point
+ */
+void libererReprise(PointReprise* r) {
+    libererMem(r->scores);
+    libererMem(r->utilisees);
+    r->scores = NULL;
+    r->utilisees = NULL;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+#include "jeu.h"
+#include "alea.h"
+#include "joueurs.h"
+
+/**
+ * @def REPRISE_MAGIE
+ * @brief Quatre premiers octets d'un point de reprise
+ */
+#define REPRISE_MAGIE "CCR1"
+
+/* Retours de lireReprise */
+#define REPRISE_ABSENTE 0     /* Pas de fichier : nouvelle partie */
+#define REPRISE_LUE 1
+#define REPRISE_INVALIDE -1   /* Fichier tronqué, corrompu ou d'un autre format */
+
+
+/**
+ * @struct PointReprise
+ * @brief État d'une partie entre deux tours : assez pour la poursuivre exactement là où elle
+ *        s'était arrêtée, avec les mêmes tirages et les mêmes choix des robots. Les cartes sont
+ *        repérées par leur indice dans le deck, vérifié par leur rang d'EtatCompact
+ */
+typedef struct {
+    uint64_t empreinteConfig;   /* empreinteConfiguration, vérifiée à la reprise */
+    uint64_t empreinteJoueurs;  /* empreinteRegistre, vérifiée à la reprise */
+    uint64_t graine;
+    Alea alea;                  /* Générateur de la partie au début du tour */
+    uint32_t tour;              /* Tours déjà commencés, le tour repris compris non */
+    uint32_t rangCourant;       /* Rangs des cartes du tour repris */
+    uint32_t rangObjectif;
+    int32_t indiceCourant;      /* Indices de ces cartes dans le deck */
+    int32_t indiceObjectif;
+    int nbJoueurs;
+    int* scores;                /* Lu par lireReprise, NULL pour ecrireReprise */
+    int nbPositions;
+    int nbMots;
+    uint64_t* utilisees;        /* Marqueurs du deck, lus par lireReprise, NULL pour ecrireReprise */
+} PointReprise;
+
+
+
+/**
+ * @brief Empreinte FNV-1a de la configuration : animaux, ordres et macros, dans l'ordre lu
+ * @param[in] config La configuration
+ * @return uint64_t L'empreinte
+ */
+uint64_t empreinteConfiguration(const ConfigJeu* config);
+
+/**
+ * @brief Empreinte FNV-1a des noms des joueurs, dans l'ordre d'inscription
+ * @param[in] registre Le registre
+ * @return uint64_t L'empreinte
+ */
+uint64_t empreinteRegistre(const Registre* registre);
+
+/**
+ * @brief Écrit le point de reprise dans un fichier temporaire, le synchronise sur le disque puis
+ *        le renomme et synchronise le répertoire : le fichier visé contient toujours un point de
+ *        reprise complet
+ * @param[in] chemin Chemin du point de reprise
+ * @param[in] r En-tête du point (scores et utilisees ignorés)
+ * @param[in] deck Deck dont les marqueurs sont écrits
+ * @param[in] registre Registre dont les scores sont écrits
+ * @return int 1 si écrit, 0 sinon (l'ancien point de reprise reste en place)
+ */
+int ecrireReprise(const char* chemin, const PointReprise* r, const Deck* deck, const Registre* registre);
+
+/**
+ * @brief Efface le point de reprise d'une partie terminée, puis synchronise le répertoire : la
+ *        même commande lancera une nouvelle partie
+ * @param[in] chemin Chemin du point de reprise
+ * @return int 1 si effacé ou absent, 0 sinon
+ */
+int effacerReprise(const char* chemin);
+
+/**
+ * @brief Lit un point de reprise et vérifie sa somme de contrôle. Les nombres de joueurs et de
+ *        cartes de l'en-tête doivent décrire exactement la taille du fichier avant toute allocation
+ * @param[in] chemin Chemin du point de reprise
+ * @param[out] r Le point, dont scores et utilisees sont alloués
+ * @return int REPRISE_LUE, REPRISE_ABSENTE ou REPRISE_INVALIDE
+ */
+int lireReprise(const char* chemin, PointReprise* r);
+
+/**
+ * @brief Libère les tableaux d'un point lu
+ * @param[in,out] r Le point
+ */
+void libererReprise(PointReprise* r);
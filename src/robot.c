@@ -0,0 +1,154 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "robot.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Reconnaît un nom de robot
+ * @param[in] nom Le nom
+ * @param[out] r Les réglages
+ * @return int 1 si valide, 0 sinon
+ */
+int lireRobot(const char* nom, Robot* r) {
+    size_t lenPrefixe = strlen(PREFIXE_ROBOT);
+
+    r->type = ROBOT_AUCUN;
+    r->hasard = 0.0;
+    if (strncmp(nom, PREFIXE_ROBOT, lenPrefixe) != 0) return 1;
+    /* Au-delà, la ligne déposée par le robot serait tronquée et jugée fausse */
+    if (strlen(nom) > NOM_ROBOT_MAX) return 0;
+
+    /* Le suffixe "#..." ne sert qu'à distinguer les noms */
+    char reglage[64];
+    size_t len = strcspn(nom + lenPrefixe, "#");
+    if (len >= sizeof(reglage)) return 0;
+    memcpy(reglage, nom + lenPrefixe, len);
+    reglage[len] = '\0';
+
+    if (strcmp(reglage, "optimal") == 0) {
+        r->type = ROBOT_OPTIMAL;
+        return 1;
+    }
+    if (strncmp(reglage, "random", 6) == 0) {
+        r->type = ROBOT_ALEATOIRE;
+        r->hasard = 1.0;
+        if (reglage[6] == '\0') return 1;
+        if (reglage[6] != ':') return 0;
+
+        char* fin;
+        r->hasard = strtod(reglage + 7, &fin);
+        return fin != reglage + 7 && *fin == '\0' && r->hasard >= 0.0 && r->hasard <= 1.0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Marche au hasard parmi les ordres possibles depuis l'état de départ
+ * @param[in] solveur Donne les ordres autorisés
+ * @param[in] depart État de départ
+ * @param[in] longueur Nombre d'ordres voulus, au plus COUPS_MAX
+ * @param[in,out] alea Générateur de la partie
+ * @param[out] coups Les ordres tirés
+ * @return int Nombre d'ordres effectivement tirés
+ */
+static int marcheAleatoire(const Solveur* solveur, const EtatCompact* depart, int longueur, Alea* alea, int* coups) {
+    EtatCompact e = *depart;
+    int nb = 0;
+
+    while (nb < longueur) {
+        int possibles[NB_ORDRES_CONNUS];
+        int nbPossibles = 0;
+        for (int i = 0; i < solveur->nbOrdres; i++) {
+            EtatCompact essai = e;
+            if (appliquerOrdre(&essai, solveur->ordres[i])) possibles[nbPossibles++] = solveur->ordres[i];
+        }
+        if (nbPossibles == 0) break;
+
+        coups[nb] = possibles[tirerBorne(alea, (uint32_t)nbPossibles)];
+        appliquerOrdre(&e, coups[nb]);
+        nb++;
+    }
+    return nb;
+}
+
+/**
+ * @brief Fait jouer les robots en lice
+ * @return int Nombre de soumissions déposées
+ */
+int jouerRobots(const Robot* robots, const Registre* registre, Solveur* solveur, const ConfigJeu* config,
+                const EtatJeu* courant, const EtatJeu* objectif, int tour, Alea* alea, FileSoumissions* f) {
+    return jouerRobotsResolus(robots, registre, solveur, config, courant, objectif, tour, alea, f, -2, NULL);
+}
+
+/**
+ * @brief Fait jouer les robots en lice avec une solution peut-être déjà connue
+ * @return int Nombre de soumissions déposées
+ */
+int jouerRobotsResolus(const Robot* robots, const Registre* registre, Solveur* solveur, const ConfigJeu* config,
+                       const EtatJeu* courant, const EtatJeu* objectif, int tour, Alea* alea, FileSoumissions* f,
+                       int longueurConnue, const int* solutionConnue) {
+    EtatCompact depart, arrivee;
+    int solution[COUPS_MAX];
+    int longueurSolution = longueurConnue;  /* -2 : pas encore calculée */
+    int nbDeposees = 0;
+
+    if (longueurSolution > 0) memcpy(solution, solutionConnue, sizeof(int) * longueurSolution);
+
+    compacterEtat(config, courant, &depart);
+    compacterEtat(config, objectif, &arrivee);
+
+    /* Le premier robot à répondre change à chaque tour pour ne favoriser aucun joueur */
+    int premier = (int)tirerBorne(alea, (uint32_t)registre->nbJoueurs);
+
+    for (int k = 0; k < registre->nbJoueurs; k++) {
+        int id = (premier + k) % registre->nbJoueurs;
+        if (robots[id].type == ROBOT_AUCUN || !estEnLice(registre, id)) continue;
+
+        int auHasard = (robots[id].type == ROBOT_ALEATOIRE && tirerReel(alea) < robots[id].hasard);
+
+        /* La solution est partagée par tous les robots du tour */
+        if (longueurSolution == -2) {
+            longueurSolution = resoudre(solveur, &depart, &arrivee, solution);
+        }
+
+        int coups[COUPS_MAX];
+        int nbCoups;
+        if (!auHasard && longueurSolution > 0) {
+            memcpy(coups, solution, sizeof(int) * longueurSolution);
+            nbCoups = longueurSolution;
+        }
+        else {
+            /* Sans solution, un robot optimal joue aussi au hasard pour ne pas bloquer le tour */
+            /* Bornée à COUPS_MAX : coups et sequence n'ont pas plus de place */
+            int longueurMax = (longueurSolution > 0 ? 2 * longueurSolution : 8);
+            if (longueurMax > COUPS_MAX) longueurMax = COUPS_MAX;
+            nbCoups = marcheAleatoire(solveur, &depart, 1 + (int)tirerBorne(alea, (uint32_t)longueurMax), alea, coups);
+        }
+
+        /* Les tirages ont eu lieu : le générateur avance comme si la proposition était déposée */
+        if (f == NULL) continue;
+
+        Soumission* s = (Soumission*)allouerMemZero(MEM_SOUMISSIONS, 1, sizeof(Soumission));
+        if (s == NULL) {
+            fprintf(stderr, "Erreur fatale : Echec d'allocation memoire dans jouerRobots\n");
+            exit(EXIT_FAILURE);
+        }
+        char sequence[2 * COUPS_MAX + 1];
+        ecrireSequence(coups, nbCoups, sequence);
+        int len = snprintf(s->ligne, LEN_CMD, "%s %s", registre->joueurs[id].nom, sequence);
+        /* Exclu par NOM_ROBOT_MAX, mais une ligne tronquée ne doit jamais être jugée */
+        if (len < 0 || len >= LEN_CMD) {
+            libererMem(s);
+            continue;
+        }
+        s->longueur = (size_t)len;
+        s->tour = tour;
+        s->horodatage = horodatageNs();
+        deposerSoumission(f, s);
+        nbDeposees++;
+    }
+    return nbDeposees;
+}
\ No newline at end of file
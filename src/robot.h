@@ -0,0 +1,76 @@
+#pragma once
+
+#include "solveur.h"
+#include "soumission.h"
+
+/**
+ * @def PREFIXE_ROBOT
+ * @brief Préfixe des noms de joueurs tenus par le programme
+ */
+#define PREFIXE_ROBOT "bot:"
+
+/**
+ * @def NOM_ROBOT_MAX
+ * @brief Longueur maximale d'un nom de robot : le nom, une espace et COUPS_MAX ordres tiennent dans LEN_CMD
+ */
+#define NOM_ROBOT_MAX (LEN_CMD - 2 - 2 * COUPS_MAX)
+
+
+/**
+ * @enum TypeRobot
+ * @brief Façon dont un joueur choisit ses séquences
+ */
+typedef enum {
+    ROBOT_AUCUN,      /* Joueur humain, ses lignes arrivent par l'entrée */
+    ROBOT_OPTIMAL,    /* Propose toujours une plus courte solution */
+    ROBOT_ALEATOIRE   /* Propose une marche au hasard avec une probabilité donnée, sinon la solution */
+} TypeRobot;
+
+/**
+ * @struct Robot
+ * @brief Réglages d'un joueur robot, tirés de son nom (ex : "bot:optimal", "bot:random:0.3")
+ */
+typedef struct {
+    TypeRobot type;
+    double hasard;    /* Probabilité de jouer au hasard (ROBOT_ALEATOIRE) */
+} Robot;
+
+
+
+/**
+ * @brief Reconnaît un nom de robot. Un suffixe "#..." permet d'inscrire plusieurs fois le même robot
+ * @param[in] nom Nom du joueur (ex : "bot:optimal", "bot:random:0.3#2")
+ * @param[out] r Réglages lus, type ROBOT_AUCUN pour un humain
+ * @return int 1 si le nom est valide, 0 s'il commence par PREFIXE_ROBOT sans être reconnu ou dépasse NOM_ROBOT_MAX
+ */
+int lireRobot(const char* nom, Robot* r);
+
+/**
+ * @brief Fait jouer les robots encore en lice : chacun dépose sa séquence dans la file, comme une
+ *        ligne saisie, pour être jugé et arbitré avec les autres soumissions
+ * @param[in] robots Réglages de chaque joueur, indexés comme le registre
+ * @param[in] registre Registre des joueurs
+ * @param[in,out] solveur Solveur préparé pour la configuration de la partie
+ * @param[in] config Configuration de la partie
+ * @param[in] courant État de départ du tour
+ * @param[in] objectif État à atteindre
+ * @param[in] tour Numéro du tour, recopié dans chaque soumission
+ * @param[in,out] alea Générateur de la partie
+ * @param[in,out] f File des soumissions, NULL pour faire les mêmes tirages sans rien déposer
+ *            (rejeu d'une session où les lignes des robots sont enregistrées)
+ * @return int Nombre de soumissions déposées
+ */
+int jouerRobots(const Robot* robots, const Registre* registre, Solveur* solveur, const ConfigJeu* config,
+                const EtatJeu* courant, const EtatJeu* objectif, int tour, Alea* alea, FileSoumissions* f);
+
+/**
+ * @brief Comme jouerRobots, avec la plus courte solution du tour si elle a déjà été cherchée
+ *        (par exemple d'avance, pendant le tour précédent)
+ * @param[in] longueurConnue Longueur de la solution, -1 si l'objectif est inaccessible, -2 si
+ *            elle n'a pas été cherchée
+ * @param[in] solutionConnue Codes des ordres de la solution, ignorés si longueurConnue <= 0
+ * @return int Nombre de soumissions déposées
+ */
+int jouerRobotsResolus(const Robot* robots, const Registre* registre, Solveur* solveur, const ConfigJeu* config,
+                       const EtatJeu* courant, const EtatJeu* objectif, int tour, Alea* alea, FileSoumissions* f,
+                       int longueurConnue, const int* solutionConnue);
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <string.h>
+#include "roue.h"
+
+#define ROUE_MASQUE ((uint64_t)ROUE_CASES - 1)
+
+
+/**
+ * @brief Prépare une roue
+ * @param[out] roue La roue
+ * @param[in] maintenant Top de départ
+ */
+void initRoue(RoueTemps* roue, uint64_t maintenant) {
+    memset(roue->cases, 0, sizeof(roue->cases));
+    roue->top = maintenant;
+    roue->nbArmees = 0;
+}
+
+/**
+ * @brief Prépare une minuterie
+ * @param[out] m La minuterie
+ * @param[in] donnees Données de l'appelant
+ * @param[in] type Type de l'appelant
+ */
+void initMinuterie(Minuterie* m, void* donnees, int type) {
+    m->suivante = NULL;
+    m->lien = NULL;
+    m->echeance = 0;
+    m->donnees = donnees;
+    m->type = type;
+}
+
+/**
+ * @brief Range une minuterie dans la case de son échéance, au niveau le plus bas qui la couvre.
+ *        Une échéance égale au top en cours tombe dans la case traitée juste après la descente
+ */
+static void ranger(RoueTemps* roue, Minuterie* m) {
+    uint64_t echeance = m->echeance;
+    uint64_t ecart = echeance - roue->top;
+
+    int niveau = 0;
+    while (niveau < ROUE_NIVEAUX - 1 && ecart >= (1ULL << (ROUE_BITS * (niveau + 1)))) niveau++;
+
+    /* Au-delà du dernier niveau, la minuterie attend dans sa dernière case et sera rangée à nouveau */
+    uint64_t portee = 1ULL << (ROUE_BITS * ROUE_NIVEAUX);
+    if (ecart >= portee) echeance = roue->top + portee - 1;
+
+    Minuterie** tete = &roue->cases[niveau][(echeance >> (ROUE_BITS * niveau)) & ROUE_MASQUE];
+    m->suivante = *tete;
+    if (*tete != NULL) (*tete)->lien = &m->suivante;
+    *tete = m;
+    m->lien = tete;
+}
+
+/**
+ * @brief Retire une minuterie de sa case
+ */
+static void decrocherMinuterie(Minuterie* m) {
+    *m->lien = m->suivante;
+    if (m->suivante != NULL) m->suivante->lien = m->lien;
+    m->suivante = NULL;
+    m->lien = NULL;
+}
+
+/**
+ * @brief Arme une minuterie
+ * @param[in,out] roue La roue
+ * @param[in,out] m La minuterie
+ * @param[in] echeance Top d'expiration
+ */
+void armerMinuterie(RoueTemps* roue, Minuterie* m, uint64_t echeance) {
+    annulerMinuterie(roue, m);
+    /* Le top en cours est déjà traité */
+    m->echeance = (echeance > roue->top) ? echeance : roue->top + 1;
+    ranger(roue, m);
+    roue->nbArmees++;
+}
+
+/**
+ * @brief Désarme une minuterie
+ * @param[in,out] roue La roue
+ * @param[in,out] m La minuterie
+ */
+void annulerMinuterie(RoueTemps* roue, Minuterie* m) {
+    if (m->lien == NULL) return;
+    decrocherMinuterie(m);
+    roue->nbArmees--;
+}
+
+/**
+ * @brief Indique si une minuterie est armée
+ * @param[in] m La minuterie
+ * @return int 1 si armée
+ */
+int estArmee(const Minuterie* m) {
+    return m->lien != NULL;
+}
+
+/**
+ * @brief Redescend les minuteries d'une case d'un niveau supérieur vers les niveaux inférieurs
+ */
+static void redescendre(RoueTemps* roue, int niveau, int indice) {
+    Minuterie* m = roue->cases[niveau][indice];
+    roue->cases[niveau][indice] = NULL;
+    while (m != NULL) {
+        Minuterie* suivante = m->suivante;
+        ranger(roue, m);
+        m = suivante;
+    }
+}
+
+/**
+ * @brief Avance la roue
+ * @param[in,out] roue La roue
+ * @param[in] maintenant Top atteint
+ * @return Minuterie* Les minuteries échues
+ */
+Minuterie* avancerRoue(RoueTemps* roue, uint64_t maintenant) {
+    Minuterie* echues = NULL;
+
+    while (roue->top < maintenant) {
+        /* Sans minuterie armée, aucune case n'a besoin d'être visitée */
+        if (roue->nbArmees == 0) {
+            roue->top = maintenant;
+            break;
+        }
+        roue->top++;
+
+        /* Au passage d'un tour complet d'un niveau, la case suivante du niveau au-dessus redescend */
+        for (int niveau = 1; niveau < ROUE_NIVEAUX; niveau++) {
+            if (((roue->top >> (ROUE_BITS * (niveau - 1))) & ROUE_MASQUE) != 0) break;
+            redescendre(roue, niveau, (int)((roue->top >> (ROUE_BITS * niveau)) & ROUE_MASQUE));
+        }
+
+        Minuterie* m = roue->cases[0][roue->top & ROUE_MASQUE];
+        while (m != NULL) {
+            Minuterie* suivante = m->suivante;
+            decrocherMinuterie(m);
+            roue->nbArmees--;
+            m->suivante = echues;
+            echues = m;
+            m = suivante;
+        }
+    }
+    return echues;
+}
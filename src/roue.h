@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @def ROUE_BITS
+ * @brief Chaque niveau de la roue a 2^ROUE_BITS cases
+ */
+#define ROUE_BITS 6
+#define ROUE_CASES (1 << ROUE_BITS)
+
+/**
+ * @def ROUE_NIVEAUX
+ * @brief Niveaux de la roue : le niveau k couvre 2^(ROUE_BITS * (k + 1)) tops, soit un peu plus
+ *        de 4 heures pour 4 niveaux de 64 cases à la milliseconde. Une échéance plus lointaine
+ *        est rangée dans la dernière case puis redescendue quand elle est atteinte
+ */
+#define ROUE_NIVEAUX 4
+
+
+/**
+ * @struct Minuterie
+ * @brief Échéance rangée dans une case de la roue. Appartient à l'appelant, qui la garde en vie
+ *        tant qu'elle est armée : la roue n'alloue rien
+ */
+typedef struct Minuterie {
+    struct Minuterie* suivante;
+    struct Minuterie** lien;     /* Pointeur qui désigne la minuterie dans sa case, NULL si désarmée */
+    uint64_t echeance;           /* En tops de la roue */
+    void* donnees;               /* Libres pour l'appelant, par exemple la partie concernée */
+    int type;
+} Minuterie;
+
+/**
+ * @struct RoueTemps
+ * @brief Roue hiérarchique de minuteries : armer et annuler coûtent O(1) quel que soit leur
+ *        nombre, et avancer d'un top ne touche que les minuteries de la case atteinte. Une roue
+ *        n'est pas protégée par un verrou : un seul fil l'utilise
+ */
+typedef struct {
+    Minuterie* cases[ROUE_NIVEAUX][ROUE_CASES];
+    uint64_t top;                /* Dernier top traité */
+    int nbArmees;
+} RoueTemps;
+
+
+
+/**
+ * @brief Prépare une roue vide
+ * @param[out] roue La roue
+ * @param[in] maintenant Top de départ
+ */
+void initRoue(RoueTemps* roue, uint64_t maintenant);
+
+/**
+ * @brief Prépare une minuterie désarmée
+ * @param[out] m La minuterie
+ * @param[in] donnees Pointeur rendu tel quel à l'expiration
+ * @param[in] type Valeur rendue telle quelle à l'expiration
+ */
+void initMinuterie(Minuterie* m, void* donnees, int type);
+
+/**
+ * @brief Arme une minuterie, en la désarmant d'abord si elle l'était déjà
+ * @param[in,out] roue La roue
+ * @param[in,out] m La minuterie
+ * @param[in] echeance Top d'expiration ; une échéance passée expire au prochain top
+ */
+void armerMinuterie(RoueTemps* roue, Minuterie* m, uint64_t echeance);
+
+/**
+ * @brief Désarme une minuterie, sans effet si elle ne l'est pas
+ * @param[in,out] roue La roue
+ * @param[in,out] m La minuterie
+ */
+void annulerMinuterie(RoueTemps* roue, Minuterie* m);
+
+/**
+ * @brief Indique si une minuterie est armée
+ * @param[in] m La minuterie
+ * @return int 1 si armée
+ */
+int estArmee(const Minuterie* m);
+
+/**
+ * @brief Avance la roue jusqu'à un top et désarme les minuteries échues
+ * @param[in,out] roue La roue
+ * @param[in] maintenant Top atteint
+ * @return Minuterie* Les minuteries échues chaînées par suivante, ou NULL
+ */
+Minuterie* avancerRoue(RoueTemps* roue, uint64_t maintenant);
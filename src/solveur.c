@@ -0,0 +1,138 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "solveur.h"
+#include "memoire.h"
+
+#define COUP_NON_VU 0xFF
+#define COUP_DEPART 0xFE
+
+
+/**
+ * @brief Prépare un solveur
+ * @param[out] s Le solveur
+ * @param[in] config La configuration
+ */
+void initSolveur(Solveur* s, const ConfigJeu* config) {
+    s->nbAnimaux = config->nbAnimaux;
+    s->nbOrdres = 0;
+    for (int i = 0; i < config->nbOrdres; i++) {
+        int code = codeOrdre(config->ordres[i]);
+        if (code < 0) continue;
+
+        int dejaVu = 0;
+        for (int j = 0; j < s->nbOrdres; j++) {
+            if (s->ordres[j] == code) dejaVu = 1;
+        }
+        if (!dejaVu) s->ordres[s->nbOrdres++] = code;
+    }
+    s->nbEtats = nbEtatsPossibles(s->nbAnimaux);
+    s->noyau = config->noyau;
+    s->coup = NULL;
+    s->file = NULL;
+}
+
+/**
+ * @brief Libère le solveur
+ * @param[in,out] s Le solveur
+ */
+void libererSolveur(Solveur* s) {
+    libererMem(s->coup);
+    libererMem(s->file);
+    s->coup = NULL;
+    s->file = NULL;
+}
+
+/**
+ * @brief Alloue les tableaux du parcours au premier appel
+ * @param[in,out] s Le solveur
+ */
+static void allouerTableaux(Solveur* s) {
+    if (s->coup != NULL) return;
+
+    s->coup = (uint8_t*)allouerMem(MEM_SOLVEUR, s->nbEtats);
+    s->file = (uint32_t*)allouerMem(MEM_SOLVEUR, sizeof(uint32_t) * s->nbEtats);
+    if (s->coup == NULL || s->file == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le solveur.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(s->coup, COUP_NON_VU, s->nbEtats);
+}
+
+/**
+ * @brief Plus courte solution par parcours en largeur
+ * @param[in,out] s Le solveur
+ * @param[in] depart État de départ
+ * @param[in] arrivee État à atteindre
+ * @param[out] coups La solution
+ * @return int Sa longueur ou -1
+ */
+int resoudre(Solveur* s, const EtatCompact* depart, const EtatCompact* arrivee, int* coups) {
+    allouerTableaux(s);
+
+    const Noyau* k = s->noyau;
+    uint32_t cible = k->rangEtat(arrivee);
+    uint32_t debut = 0, fin = 0;
+    int trouve = 0;
+
+    s->file[fin++] = k->rangEtat(depart);
+    s->coup[s->file[0]] = COUP_DEPART;
+    trouve = (s->file[0] == cible);
+
+    while (!trouve && debut < fin) {
+        uint32_t voisins[NB_ORDRES_CONNUS];
+        k->voisins(s->file[debut++], s->nbAnimaux, s->ordres, s->nbOrdres, voisins);
+
+        for (int i = 0; i < s->nbOrdres && !trouve; i++) {
+            uint32_t r = voisins[i];
+            if (r == RANG_IMPOSSIBLE || s->coup[r] != COUP_NON_VU) continue;
+            s->coup[r] = (uint8_t)s->ordres[i];
+            s->file[fin++] = r;
+            trouve = (r == cible);
+        }
+    }
+
+    int nbCoups = -1;
+    if (trouve) {
+        /* On remonte de l'arrivée au départ en défaisant chaque ordre */
+        EtatCompact e = *arrivee;
+        int longueur = 0;
+        uint32_t r = cible;
+        while (s->coup[r] != COUP_DEPART) {
+            int ordre = s->coup[r];
+            annulerOrdre(&e, ordre);
+            if (longueur < COUPS_MAX) coups[longueur] = ordre;
+            longueur++;
+            r = k->rangEtat(&e);
+        }
+        if (longueur <= COUPS_MAX) {
+            for (int i = 0; i < longueur / 2; i++) {
+                int tmp = coups[i];
+                coups[i] = coups[longueur - 1 - i];
+                coups[longueur - 1 - i] = tmp;
+            }
+            nbCoups = longueur;
+        }
+    }
+
+    /* Seuls les états mis en file ont été marqués */
+    for (uint32_t i = 0; i < fin; i++) {
+        s->coup[s->file[i]] = COUP_NON_VU;
+    }
+    return nbCoups;
+}
+
+/**
+ * @brief Écrit une séquence
+ * @param[in] coups Les codes
+ * @param[in] nbCoups Leur nombre
+ * @param[out] dest La chaîne
+ */
+void ecrireSequence(const int* coups, int nbCoups, char* dest) {
+    for (int i = 0; i < nbCoups; i++) {
+        dest[2 * i] = NOMS_ORDRES[coups[i]][0];
+        dest[2 * i + 1] = NOMS_ORDRES[coups[i]][1];
+    }
+    dest[2 * nbCoups] = '\0';
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include "etatcompact.h"
+#include "noyaux.h"
+
+/**
+ * @def COUPS_MAX
+ * @brief Longueur maximale d'une solution renvoyée par le solveur
+ */
+#define COUPS_MAX 64
+
+
+/**
+ * @struct Solveur
+ * @brief Parcours en largeur du graphe des états avec les ordres autorisés par la configuration.
+ *        Les tableaux sont alloués au premier appel puis réutilisés d'un tour à l'autre
+ */
+typedef struct {
+    int nbAnimaux;
+    int ordres[NB_ORDRES_CONNUS];  /* Codes des ordres autorisés */
+    int nbOrdres;
+    uint32_t nbEtats;              /* nbEtatsPossibles(nbAnimaux) */
+    const Noyau* noyau;            /* Noyau du nombre d'animaux, celui de la configuration */
+    uint8_t* coup;                 /* Ordre qui a mené à chaque état visité, COUP_NON_VU sinon */
+    uint32_t* file;                /* File du parcours, sert aussi à remettre coup à zéro */
+} Solveur;
+
+
+
+/**
+ * @brief Prépare un solveur pour une configuration validée
+ * @param[out] s Pointeur vers le solveur
+ * @param[in] config Configuration qui fixe le nombre d'animaux et les ordres autorisés
+ */
+void initSolveur(Solveur* s, const ConfigJeu* config);
+
+/**
+ * @brief Libère les tableaux du solveur
+ * @param[in,out] s Pointeur vers le solveur
+ */
+void libererSolveur(Solveur* s);
+
+/**
+ * @brief Cherche une plus courte suite d'ordres qui mène de depart à arrivee
+ * @param[in,out] s Pointeur vers le solveur
+ * @param[in] depart État de départ
+ * @param[in] arrivee État à atteindre
+ * @param[out] coups Codes des ordres de la solution (COUPS_MAX cases)
+ * @return int Nombre d'ordres de la solution, -1 si arrivee est inaccessible
+ */
+int resoudre(Solveur* s, const EtatCompact* depart, const EtatCompact* arrivee, int* coups);
+
+/**
+ * @brief Écrit une suite de codes d'ordres sous forme de séquence (ex : "KISO")
+ * @param[in] coups Codes des ordres
+ * @param[in] nbCoups Nombre d'ordres
+ * @param[out] dest Chaîne de destination, d'au moins 2 * nbCoups + 1 caractères
+ */
+void ecrireSequence(const int* coups, int nbCoups, char* dest);
\ No newline at end of file
@@ -0,0 +1,193 @@
+#define _POSIX_C_SOURCE 200809L
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <threads.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#endif
+#include "sondes.h"
+#include "soumission.h"
+
+
+/**
+ * @struct BlocSondes
+ * @brief Mesures d'un fil. Seul son fil les modifie ; les lectures atomiques permettent de les
+ *        additionner depuis un autre fil sans verrou
+ */
+typedef struct BlocSondes {
+    _Atomic(uint64_t) seaux[NB_SONDES][NB_SEAUX];
+    _Atomic(uint64_t) somme[NB_SONDES];           /* Durée totale en ns */
+    _Atomic(uint64_t) compteurs[NB_COMPTEURS];
+    struct BlocSondes* suivant;                   /* Bloc du fil inscrit avant celui-ci */
+} BlocSondes;
+
+static const char* nomsSondes[NB_SONDES] = { "analyse", "copie", "execution", "comparaison", "tirage", "rendu" };
+
+atomic_int sondesActives = 0;
+
+/* Blocs de tous les fils qui ont relevé au moins une mesure, jamais libérés */
+static BlocSondes* _Atomic tousLesBlocs = NULL;
+
+static _Thread_local BlocSondes* blocDuFil = NULL;
+
+
+/**
+ * @brief Active ou désactive les mesures
+ * @param[in] actif 1 pour activer
+ */
+void activerSondes(int actif) {
+    atomic_store(&sondesActives, actif);
+}
+
+/**
+ * @brief Bloc du fil appelant, créé et inscrit à la première mesure
+ * @return BlocSondes* Le bloc
+ */
+static BlocSondes* bloc(void) {
+    if (blocDuFil != NULL) return blocDuFil;
+
+    BlocSondes* b = (BlocSondes*)calloc(1, sizeof(BlocSondes));
+    if (b == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les sondes.\n");
+        exit(EXIT_FAILURE);
+    }
+    b->suivant = atomic_load(&tousLesBlocs);
+    while (!atomic_compare_exchange_weak(&tousLesBlocs, &b->suivant, b)) {
+    }
+    blocDuFil = b;
+    return b;
+}
+
+/**
+ * @brief Démarre le chronomètre
+ * @return unsigned long long L'instant ou 0
+ */
+unsigned long long debutSonde(void) {
+    if (!atomic_load_explicit(&sondesActives, memory_order_relaxed)) return 0;
+    return horodatageNs();
+}
+
+/**
+ * @brief Indice du seau d'une durée : nombre de bits significatifs
+ */
+static int seau(uint64_t ns) {
+    int k = 0;
+    while (ns != 0 && k < NB_SEAUX - 1) {
+        ns >>= 1;
+        k++;
+    }
+    return k;
+}
+
+/**
+ * @brief Relève la durée d'une étape
+ * @param[in] sonde L'étape
+ * @param[in] debut Le début
+ */
+void finSonde(int sonde, unsigned long long debut) {
+    if (debut == 0) return;
+
+    uint64_t duree = horodatageNs() - debut;
+    BlocSondes* b = bloc();
+    atomic_fetch_add_explicit(&b->seaux[sonde][seau(duree)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&b->somme[sonde], duree, memory_order_relaxed);
+}
+
+/**
+ * @brief Incrémente un compteur
+ * @param[in] compteur Le compteur
+ * @param[in] n La valeur à ajouter
+ */
+void compterSonde(int compteur, long n) {
+    if (!atomic_load_explicit(&sondesActives, memory_order_relaxed)) return;
+
+    atomic_fetch_add_explicit(&bloc()->compteurs[compteur], (uint64_t)n, memory_order_relaxed);
+}
+
+/**
+ * @brief Écrit les mesures cumulées
+ * @param[in] f Le flux
+ */
+void ecrireSondes(FILE* f) {
+    uint64_t seaux[NB_SONDES][NB_SEAUX] = { { 0 } };
+    uint64_t somme[NB_SONDES] = { 0 };
+    uint64_t compteurs[NB_COMPTEURS] = { 0 };
+
+    for (BlocSondes* b = atomic_load(&tousLesBlocs); b != NULL; b = b->suivant) {
+        for (int s = 0; s < NB_SONDES; s++) {
+            for (int k = 0; k < NB_SEAUX; k++) {
+                seaux[s][k] += atomic_load_explicit(&b->seaux[s][k], memory_order_relaxed);
+            }
+            somme[s] += atomic_load_explicit(&b->somme[s], memory_order_relaxed);
+        }
+        for (int c = 0; c < NB_COMPTEURS; c++) {
+            compteurs[c] += atomic_load_explicit(&b->compteurs[c], memory_order_relaxed);
+        }
+    }
+
+    fprintf(f, "# TYPE crazy_duree_ns histogram\n");
+    for (int s = 0; s < NB_SONDES; s++) {
+        uint64_t cumul = 0;
+        for (int k = 0; k < NB_SEAUX - 1; k++) {
+            cumul += seaux[s][k];
+            fprintf(f, "crazy_duree_ns_bucket{etape=\"%s\",le=\"%llu\"} %llu\n",
+                    nomsSondes[s], (unsigned long long)((1ULL << k) - 1), (unsigned long long)cumul);
+        }
+        cumul += seaux[s][NB_SEAUX - 1];
+        fprintf(f, "crazy_duree_ns_bucket{etape=\"%s\",le=\"+Inf\"} %llu\n", nomsSondes[s], (unsigned long long)cumul);
+        fprintf(f, "crazy_duree_ns_sum{etape=\"%s\"} %llu\n", nomsSondes[s], (unsigned long long)somme[s]);
+        fprintf(f, "crazy_duree_ns_count{etape=\"%s\"} %llu\n", nomsSondes[s], (unsigned long long)cumul);
+    }
+
+    fprintf(f, "# TYPE crazy_ordres_executes_total counter\n");
+    fprintf(f, "crazy_ordres_executes_total %llu\n", (unsigned long long)compteurs[COMPTEUR_ORDRES]);
+    fprintf(f, "# TYPE crazy_echecs_total counter\n");
+    fprintf(f, "crazy_echecs_total{type=\"ordre_inconnu\"} %llu\n", (unsigned long long)compteurs[COMPTEUR_ORDRE_INCONNU]);
+    fprintf(f, "crazy_echecs_total{type=\"mouvement_impossible\"} %llu\n",
+            (unsigned long long)compteurs[COMPTEUR_MOUVEMENT_IMPOSSIBLE]);
+    fprintf(f, "# TYPE crazy_cartes_tirees_total counter\n");
+    fprintf(f, "crazy_cartes_tirees_total %llu\n", (unsigned long long)compteurs[COMPTEUR_CARTES]);
+    fflush(f);
+}
+
+#ifndef _WIN32
+/**
+ * @brief Fil qui attend SIGUSR1 et écrit les mesures
+ * @param[in] arg Le flux
+ * @return int 0
+ */
+static int attendreSignal(void* arg) {
+    FILE* f = (FILE*)arg;
+    sigset_t ensemble;
+    sigemptyset(&ensemble);
+    sigaddset(&ensemble, SIGUSR1);
+
+    for (;;) {
+        int signal;
+        if (sigwait(&ensemble, &signal) == 0) ecrireSondes(f);
+    }
+    return 0;
+}
+#endif
+
+/**
+ * @brief Lance le fil d'écoute de SIGUSR1
+ * @param[in] f Le flux
+ */
+void ecouterSignalSondes(FILE* f) {
+#ifndef _WIN32
+    /* Masqué dans ce fil et donc dans tous ceux créés ensuite : seul sigwait le reçoit */
+    sigset_t ensemble;
+    sigemptyset(&ensemble);
+    sigaddset(&ensemble, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &ensemble, NULL);
+
+    thrd_t fil;
+    if (thrd_create(&fil, attendreSignal, f) == thrd_success) thrd_detach(fil);
+#else
+    (void)f;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+/**
+ * @def NB_SEAUX
+ * @brief Nombre de seaux des histogrammes : le seau k compte les durées de 2^(k-1) à 2^k - 1 ns
+ */
+#define NB_SEAUX 40
+
+/**
+ * @def COMMANDE_SONDES
+ * @brief Ligne saisie qui affiche les mesures sur l'erreur standard
+ */
+#define COMMANDE_SONDES "!sondes"
+
+/* Étapes chronométrées */
+#define SONDE_ANALYSE 0
+#define SONDE_COPIE 1
+#define SONDE_EXECUTION 2
+#define SONDE_COMPARAISON 3
+#define SONDE_TIRAGE 4
+#define SONDE_RENDU 5
+#define NB_SONDES 6
+
+/* Compteurs */
+#define COMPTEUR_ORDRES 0
+#define COMPTEUR_ORDRE_INCONNU 1
+#define COMPTEUR_MOUVEMENT_IMPOSSIBLE 2
+#define COMPTEUR_CARTES 3
+#define NB_COMPTEURS 4
+
+
+/**
+ * @brief 1 si les mesures sont relevées. Désactivées par défaut : chaque sonde ne coûte alors
+ *        qu'une lecture de ce drapeau
+ */
+extern atomic_int sondesActives;
+
+
+
+/**
+ * @brief Active ou désactive les mesures
+ * @param[in] actif 1 pour activer
+ */
+void activerSondes(int actif);
+
+/**
+ * @brief Démarre le chronomètre d'une étape
+ * @return unsigned long long L'instant présent, ou 0 si les mesures sont désactivées
+ */
+unsigned long long debutSonde(void);
+
+/**
+ * @brief Ajoute la durée écoulée depuis debut à l'histogramme du fil appelant
+ * @param[in] sonde Étape mesurée (SONDE_...)
+ * @param[in] debut Valeur rendue par debutSonde, rien n'est relevé si elle vaut 0
+ */
+void finSonde(int sonde, unsigned long long debut);
+
+/**
+ * @brief Incrémente un compteur du fil appelant si les mesures sont actives
+ * @param[in] compteur Compteur visé (COMPTEUR_...)
+ * @param[in] n Valeur à ajouter
+ */
+void compterSonde(int compteur, long n);
+
+/**
+ * @brief Additionne les mesures de tous les fils et les écrit au format texte de Prometheus
+ * @param[in] f Flux de sortie
+ */
+void ecrireSondes(FILE* f);
+
+/**
+ * @brief Lance un fil qui écrit les mesures sur f à chaque SIGUSR1 (sans effet sous Windows).
+ *        Doit être appelée avant de créer les autres fils, qui héritent du signal masqué
+ * @param[in] f Flux de sortie
+ */
+void ecouterSignalSondes(FILE* f);
\ No newline at end of file
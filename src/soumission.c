@@ -0,0 +1,369 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#include "soumission.h"
+#include "sondes.h"
+#include "memoire.h"
+
+
+/**
+ * @brief Renvoie l'instant présent en nanosecondes
+ * @return unsigned long long L'horodatage
+ */
+unsigned long long horodatageNs(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * @brief Renvoie le nombre de coeurs disponibles
+ * @return int Au moins 1
+ */
+int nombreCoeurs(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+
+
+/**
+ * @brief Initialise la file avec son maillon factice
+ * @param[out] f La file
+ */
+void initFile(FileSoumissions* f) {
+    atomic_store(&f->bouchon.suivant, NULL);
+    atomic_store(&f->entree, &f->bouchon);
+    f->sortie = &f->bouchon;
+    atomic_store(&f->enAttente, 0);
+    mtx_init(&f->verrou, mtx_plain);
+    cnd_init(&f->reveil);
+}
+
+/**
+ * @brief Vide la file et libère ses ressources
+ * @param[in,out] f La file
+ */
+void detruireFile(FileSoumissions* f) {
+    Soumission* s;
+    while ((s = retirerSoumission(f, 0)) != NULL) {
+        libererMem(s);
+    }
+    cnd_destroy(&f->reveil);
+    mtx_destroy(&f->verrou);
+}
+
+/**
+ * @brief Accroche un maillon en fin de file (sans verrou)
+ * @param[in,out] f La file
+ * @param[in] s Le maillon
+ */
+static void accrocher(FileSoumissions* f, Soumission* s) {
+    atomic_store(&s->suivant, NULL);
+    Soumission* precedent = atomic_exchange(&f->entree, s);
+    atomic_store(&precedent->suivant, s);
+}
+
+/**
+ * @brief Dépose une soumission et réveille le consommateur s'il dort
+ * @param[in,out] f La file
+ * @param[in] s La soumission
+ */
+void deposerSoumission(FileSoumissions* f, Soumission* s) {
+    accrocher(f, s);
+
+    if (atomic_load(&f->enAttente)) {
+        mtx_lock(&f->verrou);
+        cnd_signal(&f->reveil);
+        mtx_unlock(&f->verrou);
+    }
+}
+
+/**
+ * @brief Retire un maillon sans attendre
+ * @param[in,out] f La file
+ * @return Soumission* Le maillon ou NULL si rien n'est encore visible
+ */
+static Soumission* decrocher(FileSoumissions* f) {
+    Soumission* sortie = f->sortie;
+    Soumission* suivant = atomic_load(&sortie->suivant);
+
+    if (sortie == &f->bouchon) {
+        if (suivant == NULL) return NULL;
+        f->sortie = suivant;
+        sortie = suivant;
+        suivant = atomic_load(&sortie->suivant);
+    }
+
+    if (suivant != NULL) {
+        f->sortie = suivant;
+        return sortie;
+    }
+
+    /* Un producteur est en train d'accrocher derrière ce maillon */
+    if (sortie != atomic_load(&f->entree)) return NULL;
+
+    /* Dernier maillon : on remet le bouchon derrière lui pour pouvoir le détacher */
+    accrocher(f, &f->bouchon);
+    suivant = atomic_load(&sortie->suivant);
+    if (suivant != NULL) {
+        f->sortie = suivant;
+        return sortie;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Retire la plus ancienne soumission
+ * @param[in,out] f La file
+ * @param[in] bloquant 1 pour attendre si la file est vide
+ * @return Soumission* La soumission ou NULL
+ */
+Soumission* retirerSoumission(FileSoumissions* f, int bloquant) {
+    Soumission* s = decrocher(f);
+
+    while (s == NULL && bloquant) {
+        mtx_lock(&f->verrou);
+        atomic_store(&f->enAttente, 1);
+        s = decrocher(f);
+        if (s == NULL) {
+            cnd_wait(&f->reveil, &f->verrou);
+            s = decrocher(f);
+        }
+        atomic_store(&f->enAttente, 0);
+        mtx_unlock(&f->verrou);
+    }
+    return s;
+}
+
+/**
+ * @brief Retire la plus ancienne soumission en attendant au plus jusqu'à une échéance
+ * @param[in,out] f La file
+ * @param[in] echeanceNs Instant limite, sur l'horloge de horodatageNs
+ * @return Soumission* La soumission ou NULL si l'échéance est passée
+ */
+Soumission* retirerSoumissionAvant(FileSoumissions* f, unsigned long long echeanceNs) {
+    Soumission* s = decrocher(f);
+
+    /* horodatageNs lit TIME_UTC, l'horloge de cnd_timedwait */
+    struct timespec limite;
+    limite.tv_sec = (time_t)(echeanceNs / 1000000000ULL);
+    limite.tv_nsec = (long)(echeanceNs % 1000000000ULL);
+
+    while (s == NULL && horodatageNs() < echeanceNs) {
+        mtx_lock(&f->verrou);
+        atomic_store(&f->enAttente, 1);
+        s = decrocher(f);
+        if (s == NULL) {
+            cnd_timedwait(&f->reveil, &f->verrou, &limite);
+            s = decrocher(f);
+        }
+        atomic_store(&f->enAttente, 0);
+        mtx_unlock(&f->verrou);
+    }
+    return s;
+}
+
+
+
+/**
+ * @brief Rejoue la séquence d'une soumission sur une copie de l'état courant
+ * @param[in] courant État de départ
+ * @param[in] objectif État cible
+ * @param[in] config La configuration, ou NULL
+ * @param[in,out] effets Le cache, ou NULL
+ * @param[in,out] s La soumission à juger
+ */
+void jugerSoumission(const EtatJeu* courant, const EtatJeu* objectif, const ConfigJeu* config, CacheEffets* effets,
+                     Soumission* s) {
+    unsigned long long debut = horodatageNs();
+
+    if (effets != NULL) {
+        s->codeRetour = jugerParEffet(effets, courant, objectif, config, s->sequence, &s->bonneSolution);
+        s->jugee = 1;
+        s->dureeJugement = horodatageNs() - debut;
+        return;
+    }
+
+    int cellules = attribuerCellules(MEM_ESSAIS);
+    EtatJeu testState;
+    initEtat(&testState);
+    unsigned long long sonde = debutSonde();
+    copierEtat(courant, &testState);
+    finSonde(SONDE_COPIE, sonde);
+
+    sonde = debutSonde();
+    s->codeRetour = executerSequenceConfig(&testState, s->sequence, config);
+    finSonde(SONDE_EXECUTION, sonde);
+
+    s->bonneSolution = 0;
+    if (s->codeRetour == 1) {
+        sonde = debutSonde();
+        s->bonneSolution = estMemeEtat(&testState, objectif);
+        finSonde(SONDE_COMPARAISON, sonde);
+    }
+    s->jugee = 1;
+
+    libererEtat(&testState);
+    attribuerCellules(cellules);
+    s->dureeJugement = horodatageNs() - debut;
+}
+
+/**
+ * @brief Indique si une soumission doit passer par les juges
+ * @param[in] s La soumission
+ * @param[in] registre Registre des joueurs
+ * @param[in] tour Tour en cours
+ * @return int 1 si elle doit être jugée
+ */
+static int aJuger(const Soumission* s, const Registre* registre, int tour) {
+    if (s->fin || s->jugee || s->idJoueur < 0 || s->sequence == NULL) return 0;
+    /* Proposition d'un robot pour un tour déjà terminé, écartée à l'arbitrage */
+    if (s->tour != 0 && s->tour != tour) return 0;
+    return estEnLice(registre, s->idJoueur);
+}
+
+/**
+ * @brief Boucle d'un fil de jugement : attend un lot puis réclame des soumissions une à une
+ * @param[in] arg Le pool
+ * @return int 0
+ */
+static int boucleJuge(void* arg) {
+    PoolJuges* pool = (PoolJuges*)arg;
+    unsigned long vue = 0;
+
+    for (;;) {
+        mtx_lock(&pool->verrou);
+        while (!pool->arret && pool->generation == vue) {
+            cnd_wait(&pool->travail, &pool->verrou);
+        }
+        if (pool->arret) {
+            mtx_unlock(&pool->verrou);
+            return 0;
+        }
+        vue = pool->generation;
+        mtx_unlock(&pool->verrou);
+
+        int i;
+        while ((i = atomic_fetch_add(&pool->prochain, 1)) < pool->taille) {
+            Soumission* s = pool->lot[i];
+            if (aJuger(s, pool->registre, pool->tour)) {
+                jugerSoumission(pool->courant, pool->objectif, pool->config, pool->effets, s);
+            }
+        }
+
+        mtx_lock(&pool->verrou);
+        pool->restants--;
+        if (pool->restants == 0) cnd_signal(&pool->termine);
+        mtx_unlock(&pool->verrou);
+    }
+}
+
+/**
+ * @brief Démarre les fils de jugement
+ * @param[out] pool Le pool
+ * @param[in] nbFils Nombre de fils
+ */
+void initPoolJuges(PoolJuges* pool, int nbFils) {
+    if (nbFils < 1) nbFils = 1;
+
+    pool->fils = (thrd_t*)allouerMem(MEM_DIVERS, sizeof(thrd_t) * nbFils);
+    if (pool->fils == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour les juges.\n");
+        exit(EXIT_FAILURE);
+    }
+    mtx_init(&pool->verrou, mtx_plain);
+    cnd_init(&pool->travail);
+    cnd_init(&pool->termine);
+    pool->generation = 0;
+    pool->arret = 0;
+    pool->restants = 0;
+    atomic_store(&pool->prochain, 0);
+    pool->lot = NULL;
+    pool->taille = 0;
+
+    pool->nbFils = 0;
+    for (int i = 0; i < nbFils; i++) {
+        if (thrd_create(&pool->fils[i], boucleJuge, pool) != thrd_success) break;
+        pool->nbFils++;
+    }
+}
+
+/**
+ * @brief Arrête les fils de jugement
+ * @param[in,out] pool Le pool
+ */
+void detruirePoolJuges(PoolJuges* pool) {
+    mtx_lock(&pool->verrou);
+    pool->arret = 1;
+    cnd_broadcast(&pool->travail);
+    mtx_unlock(&pool->verrou);
+
+    for (int i = 0; i < pool->nbFils; i++) {
+        thrd_join(pool->fils[i], NULL);
+    }
+    libererMem(pool->fils);
+    cnd_destroy(&pool->termine);
+    cnd_destroy(&pool->travail);
+    mtx_destroy(&pool->verrou);
+}
+
+/**
+ * @brief Juge un lot de soumissions en le répartissant entre les fils
+ * @param[in,out] pool Le pool
+ * @param[in] courant État de départ
+ * @param[in] objectif État cible
+ * @param[in] config La configuration, ou NULL
+ * @param[in,out] effets Le cache, ou NULL
+ * @param[in] registre Registre des joueurs
+ * @param[in] tour Tour en cours
+ * @param[in,out] lot Les soumissions
+ * @param[in] taille Nombre de soumissions
+ */
+void jugerLot(PoolJuges* pool, const EtatJeu* courant, const EtatJeu* objectif, const ConfigJeu* config,
+              CacheEffets* effets, const Registre* registre, int tour, Soumission** lot, int taille) {
+    int nbAJuger = 0;
+    for (int i = 0; i < taille; i++) {
+        if (aJuger(lot[i], registre, tour)) nbAJuger++;
+    }
+
+    /* Inutile de réveiller les fils pour une seule soumission */
+    if (nbAJuger <= 1 || pool == NULL || pool->nbFils == 0) {
+        for (int i = 0; i < taille; i++) {
+            if (aJuger(lot[i], registre, tour)) jugerSoumission(courant, objectif, config, effets, lot[i]);
+        }
+        return;
+    }
+
+    mtx_lock(&pool->verrou);
+    pool->lot = lot;
+    pool->taille = taille;
+    pool->courant = courant;
+    pool->objectif = objectif;
+    pool->config = config;
+    pool->effets = effets;
+    pool->registre = registre;
+    pool->tour = tour;
+    atomic_store(&pool->prochain, 0);
+    pool->restants = pool->nbFils;
+    pool->generation++;
+    cnd_broadcast(&pool->travail);
+
+    while (pool->restants > 0) {
+        cnd_wait(&pool->termine, &pool->verrou);
+    }
+    mtx_unlock(&pool->verrou);
+}
\ No newline at end of file
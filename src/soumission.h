@@ -0,0 +1,174 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <threads.h>
+#include "jeu.h"
+#include "joueurs.h"
+#include "effets.h"
+
+/**
+ * @def LEN_CMD
+ * @brief Taille maximale d'une ligne saisie par un joueur
+ */
+#define LEN_CMD 256
+
+/**
+ * @def LOT_MAX
+ * @brief Nombre maximum de soumissions jugées ensemble
+ */
+#define LOT_MAX 64
+
+
+/**
+ * @struct Soumission
+ * @brief Une ligne proposée par un joueur, horodatée à son arrivée
+ */
+typedef struct Soumission {
+    struct Soumission* _Atomic suivant; /* Maillon suivant dans la file */
+    unsigned long long horodatage;      /* Instant d'arrivée en nanosecondes */
+    int fin;                            /* 1 si c'est le marqueur de fin d'entrée */
+    int tour;                           /* Tour visé par un robot (à partir de 1), 0 pour une ligne saisie */
+    int analysee;                       /* 1 si la ligne a déjà été découpée */
+    int idJoueur;                       /* Indice du joueur, -1 si inconnu */
+    char* nomJoueur;                    /* Pointe dans ligne */
+    char* sequence;                     /* Pointe dans ligne, NULL si absente */
+    int jugee;                          /* 1 si codeRetour et bonneSolution sont à jour */
+    int codeRetour;                     /* Retour de executerSequence */
+    int bonneSolution;                  /* 1 si la séquence atteint l'objectif */
+    unsigned long long dureeJugement;   /* Durée du jugement en nanosecondes */
+    size_t longueur;                    /* Longueur de ligne, sans '\n' */
+    char ligne[LEN_CMD];                /* Texte brut saisi */
+} Soumission;
+
+
+/**
+ * @struct FileSoumissions
+ * @brief File sans verrou à plusieurs producteurs et un seul consommateur
+ */
+typedef struct {
+    Soumission* _Atomic entree;  /* Dernier maillon déposé (côté producteurs) */
+    Soumission* sortie;          /* Prochain maillon à retirer (côté consommateur) */
+    Soumission bouchon;          /* Maillon factice qui évite une file vraiment vide */
+    atomic_int enAttente;        /* 1 si le consommateur est endormi */
+    mtx_t verrou;                /* Sert uniquement à endormir le consommateur */
+    cnd_t reveil;
+} FileSoumissions;
+
+
+/**
+ * @struct PoolJuges
+ * @brief Ensemble de fils qui vérifient les soumissions d'un lot en parallèle
+ */
+typedef struct {
+    thrd_t* fils;
+    int nbFils;
+    mtx_t verrou;
+    cnd_t travail;
+    cnd_t termine;
+    unsigned long generation;     /* Incrémenté à chaque nouveau lot */
+    int arret;
+    int restants;                 /* Nombre de fils encore occupés sur le lot */
+    atomic_int prochain;          /* Prochaine soumission à réclamer */
+    Soumission** lot;
+    int taille;
+    const EtatJeu* courant;
+    const EtatJeu* objectif;
+    const ConfigJeu* config;
+    CacheEffets* effets;
+    const Registre* registre;
+    int tour;                     /* Tour en cours : les propositions des robots pour un autre tour sont ignorées */
+} PoolJuges;
+
+
+
+/**
+ * @brief Renvoie l'instant présent en nanosecondes
+ * @return unsigned long long L'horodatage
+ */
+unsigned long long horodatageNs(void);
+
+/**
+ * @brief Renvoie le nombre de coeurs disponibles sur la machine
+ * @return int Au moins 1
+ */
+int nombreCoeurs(void);
+
+
+/**
+ * @brief Initialise une file de soumissions vide
+ * @param[out] f Pointeur vers la file à initialiser
+ */
+void initFile(FileSoumissions* f);
+
+/**
+ * @brief Libère les soumissions restantes et les ressources de la file
+ * @param[in,out] f Pointeur vers la file à détruire
+ */
+void detruireFile(FileSoumissions* f);
+
+/**
+ * @brief Dépose une soumission dans la file. Peut être appelé depuis plusieurs fils
+ * @param[in,out] f Pointeur vers la file
+ * @param[in] s Soumission allouée par l'appelant, la file en devient propriétaire
+ */
+void deposerSoumission(FileSoumissions* f, Soumission* s);
+
+/**
+ * @brief Retire la plus ancienne soumission. Un seul fil doit l'appeler
+ * @param[in,out] f Pointeur vers la file
+ * @param[in] bloquant 1 pour attendre une soumission si la file est vide
+ * @return Soumission* La soumission retirée ou NULL si la file est vide
+ */
+Soumission* retirerSoumission(FileSoumissions* f, int bloquant);
+
+/**
+ * @brief Retire la plus ancienne soumission, en attendant au plus jusqu'à une échéance si la
+ *        file est vide. Un seul fil doit l'appeler
+ * @param[in,out] f Pointeur vers la file
+ * @param[in] echeanceNs Instant limite, sur l'horloge de horodatageNs
+ * @return Soumission* La soumission retirée ou NULL si rien n'est arrivé avant l'échéance
+ */
+Soumission* retirerSoumissionAvant(FileSoumissions* f, unsigned long long echeanceNs);
+
+
+/**
+ * @brief Juge une soumission, par le cache des effets s'il y en a un, sinon sur une copie de
+ *        l'état courant
+ * @param[in] courant État de départ du tour
+ * @param[in] objectif État à atteindre
+ * @param[in] config Configuration dont les macros sont acceptées, ou NULL
+ * @param[in,out] effets Cache des effets de séquences, ou NULL
+ * @param[in,out] s Soumission dont codeRetour et bonneSolution sont remplis
+ */
+void jugerSoumission(const EtatJeu* courant, const EtatJeu* objectif, const ConfigJeu* config, CacheEffets* effets,
+                     Soumission* s);
+
+/**
+ * @brief Démarre les fils de jugement
+ * @param[out] pool Pointeur vers le pool à initialiser
+ * @param[in] nbFils Nombre de fils à lancer
+ */
+void initPoolJuges(PoolJuges* pool, int nbFils);
+
+/**
+ * @brief Arrête et libère les fils de jugement
+ * @param[in,out] pool Pointeur vers le pool à détruire
+ */
+void detruirePoolJuges(PoolJuges* pool);
+
+/**
+ * @brief Juge en parallèle toutes les soumissions d'un lot qui ne le sont pas encore.
+ *        Les joueurs qui ne sont plus en lice et les propositions des robots pour un tour déjà
+ *        terminé ne sont pas vérifiés
+ * @param[in,out] pool Pointeur vers le pool de juges, NULL pour juger sur le fil appelant
+ * @param[in] courant État de départ du tour
+ * @param[in] objectif État à atteindre
+ * @param[in] config Configuration dont les macros sont acceptées, ou NULL
+ * @param[in,out] effets Cache des effets de séquences, ou NULL
+ * @param[in] registre Registre des joueurs et de leurs droits de jeu
+ * @param[in] tour Tour en cours, celui que visent les robots (à partir de 1)
+ * @param[in,out] lot Soumissions à juger
+ * @param[in] taille Nombre de soumissions du lot
+ */
+void jugerLot(PoolJuges* pool, const EtatJeu* courant, const EtatJeu* objectif, const ConfigJeu* config,
+              CacheEffets* effets, const Registre* registre, int tour, Soumission** lot, int taille);
\ No newline at end of file
@@ -0,0 +1,243 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "tournoi.h"
+#include "memoire.h"
+
+/* Retours de volerTache */
+#define TACHE_AUCUNE -1
+#define TACHE_CONFLIT -2
+
+
+/**
+ * @struct FileDouble
+ * @brief File à deux bouts de Chase et Lev. Le propriétaire travaille par le bas, les voleurs
+ *        prennent par le haut. Toutes les parties sont déposées avant le départ des fils, la
+ *        capacité ne change donc jamais
+ */
+typedef struct {
+    long* taches;       /* Numéros de parties */
+    atomic_long haut;   /* Prochaine tâche à voler */
+    atomic_long bas;    /* Case après la dernière tâche du propriétaire */
+} FileDouble;
+
+/**
+ * @struct Ouvrier
+ * @brief Un fil du tournoi et ses résultats, cumulés sans verrou puis additionnés à la fin
+ */
+typedef struct {
+    const Tournoi* tournoi;
+    FileDouble* files;           /* Files de tous les fils */
+    int nbFils;
+    int indice;                  /* Indice de sa propre file */
+    ResultatStrategie* resultats;
+} Ouvrier;
+
+
+
+/**
+ * @brief Reprend la dernière tâche de sa propre file
+ * @param[in,out] f La file du fil appelant
+ * @return long La tâche ou TACHE_AUCUNE
+ */
+static long reprendreTache(FileDouble* f) {
+    long b = atomic_load(&f->bas) - 1;
+    atomic_store(&f->bas, b);
+    long t = atomic_load(&f->haut);
+
+    if (t > b) {
+        atomic_store(&f->bas, b + 1);
+        return TACHE_AUCUNE;
+    }
+
+    long tache = f->taches[b];
+    if (t == b) {
+        /* Dernière tâche : on la dispute aux voleurs */
+        if (!atomic_compare_exchange_strong(&f->haut, &t, t + 1)) tache = TACHE_AUCUNE;
+        atomic_store(&f->bas, b + 1);
+    }
+    return tache;
+}
+
+/**
+ * @brief Vole la plus ancienne tâche d'une autre file
+ * @param[in,out] f La file visée
+ * @return long La tâche, TACHE_AUCUNE si la file est vide, TACHE_CONFLIT si un autre fil l'a prise avant
+ */
+static long volerTache(FileDouble* f) {
+    long t = atomic_load(&f->haut);
+    long b = atomic_load(&f->bas);
+
+    if (t >= b) return TACHE_AUCUNE;
+
+    long tache = f->taches[t];
+    if (!atomic_compare_exchange_strong(&f->haut, &t, t + 1)) return TACHE_CONFLIT;
+    return tache;
+}
+
+/**
+ * @brief Cherche une tâche : d'abord dans sa file, puis chez les autres
+ * @param[in,out] o L'ouvrier
+ * @return long La tâche ou TACHE_AUCUNE quand toutes les files sont vides
+ */
+static long prochaineTache(Ouvrier* o) {
+    long tache = reprendreTache(&o->files[o->indice]);
+    if (tache >= 0) return tache;
+
+    int conflit;
+    do {
+        conflit = 0;
+        for (int k = 1; k < o->nbFils; k++) {
+            tache = volerTache(&o->files[(o->indice + k) % o->nbFils]);
+            if (tache >= 0) return tache;
+            if (tache == TACHE_CONFLIT) conflit = 1;
+        }
+    } while (conflit);
+    return TACHE_AUCUNE;
+}
+
+/**
+ * @brief Joue une partie du tournoi et cumule ses scores
+ * @param[in] t Le tournoi
+ * @param[in] numero Numéro de la partie, qui fixe son générateur
+ * @param[in,out] deck Deck du fil, remis à neuf
+ * @param[in,out] solveur Solveur du fil
+ * @param[in,out] resultats Cumul du fil
+ */
+static void jouerUnePartie(const Tournoi* t, long numero, Deck* deck, Solveur* solveur, ResultatStrategie* resultats) {
+    Registre registre;
+    initRegistre(&registre);
+    for (int i = 0; i < t->nbStrategies; i++) {
+        ajouterJoueur(&registre, t->strategies[i]);
+    }
+
+    Classement classement;
+    initClassement(&classement, &registre);
+
+    FileSoumissions file;
+    initFile(&file);
+
+    Alea alea;
+    initAlea(&alea, t->graine ^ ((uint64_t)(numero + 1) * 0xD1B54A32D192ED03ULL));
+
+    reinitialiserDeck(deck);
+
+    Partie p = { t->config, &registre, &classement, deck, &alea, t->robots, solveur, &file,
+                 NULL, NULL, NULL, NULL, t->distances, t->distanceMin, t->distanceMax,
+                 t->journal, (uint32_t)(numero + 1), NULL, NULL, t->graine, t->effets, NULL, 0, 0, NULL, NULL,
+                 NULL, 0, 0 };
+    jouerPartie(&p);
+
+    for (int i = 0; i < registre.nbJoueurs; i++) {
+        resultats[i].parties++;
+        resultats[i].points += registre.joueurs[i].score;
+    }
+
+    /* Victoire seulement pour un premier qui n'est pas à égalité */
+    int premiers[2];
+    int nb = meilleursJoueurs(&classement, 2, premiers);
+    if (nb == 1 || (nb == 2 && registre.joueurs[premiers[0]].score > registre.joueurs[premiers[1]].score)) {
+        resultats[premiers[0]].victoires++;
+    }
+
+    detruireFile(&file);
+    libererClassement(&classement);
+    libererRegistre(&registre);
+}
+
+/**
+ * @brief Boucle d'un fil du tournoi
+ * @param[in] arg L'ouvrier
+ * @return int 0
+ */
+static int boucleOuvrier(void* arg) {
+    Ouvrier* o = (Ouvrier*)arg;
+    const Tournoi* t = o->tournoi;
+
+    Deck deck;
+    partagerPositions(t->modele, &deck);
+    Solveur solveur;
+    initSolveur(&solveur, t->config);
+
+    long tache;
+    while ((tache = prochaineTache(o)) != TACHE_AUCUNE) {
+        jouerUnePartie(t, tache, &deck, &solveur, o->resultats);
+    }
+
+    libererSolveur(&solveur);
+    libererDeck(&deck);
+    return 0;
+}
+
+/**
+ * @brief Joue un tournoi
+ * @param[in] t Le tournoi
+ * @param[in] nbFils Nombre de fils
+ * @param[out] resultats Cumul par stratégie
+ * @return double Durée en secondes
+ */
+double jouerTournoi(const Tournoi* t, int nbFils, ResultatStrategie* resultats) {
+    if (nbFils < 1) nbFils = 1;
+
+    FileDouble* files = (FileDouble*)allouerMem(MEM_DIVERS, sizeof(FileDouble) * nbFils);
+    Ouvrier* ouvriers = (Ouvrier*)allouerMem(MEM_DIVERS, sizeof(Ouvrier) * nbFils);
+    thrd_t* fils = (thrd_t*)allouerMem(MEM_DIVERS, sizeof(thrd_t) * nbFils);
+    if (files == NULL || ouvriers == NULL || fils == NULL) {
+        fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le tournoi.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Chaque fil reçoit une tranche contiguë de parties */
+    for (int i = 0; i < nbFils; i++) {
+        long debut = t->nbParties * i / nbFils;
+        long fin = t->nbParties * (i + 1) / nbFils;
+
+        files[i].taches = (long*)allouerMem(MEM_DIVERS, sizeof(long) * (fin - debut + 1));
+        ouvriers[i].resultats = (ResultatStrategie*)allouerMemZero(MEM_DIVERS, t->nbStrategies, sizeof(ResultatStrategie));
+        if (files[i].taches == NULL || ouvriers[i].resultats == NULL) {
+            fprintf(stderr, "Erreur fatale : Memoire insuffisante pour le tournoi.\n");
+            exit(EXIT_FAILURE);
+        }
+        /* Déposées à l'envers : le propriétaire commence par le début de sa tranche */
+        for (long k = 0; k < fin - debut; k++) files[i].taches[k] = fin - 1 - k;
+        atomic_init(&files[i].haut, 0);
+        atomic_init(&files[i].bas, fin - debut);
+
+        ouvriers[i].tournoi = t;
+        ouvriers[i].files = files;
+        ouvriers[i].nbFils = nbFils;
+        ouvriers[i].indice = i;
+    }
+
+    unsigned long long debut = horodatageNs();
+
+    int nbLances = 0;
+    for (int i = 1; i < nbFils; i++) {
+        if (thrd_create(&fils[i], boucleOuvrier, &ouvriers[i]) != thrd_success) break;
+        nbLances++;
+    }
+    /* Le fil appelant est l'ouvrier 0 ; les tâches d'un fil non lancé sont volées par les autres */
+    boucleOuvrier(&ouvriers[0]);
+    for (int i = 1; i <= nbLances; i++) {
+        thrd_join(fils[i], NULL);
+    }
+
+    double secondes = (double)(horodatageNs() - debut) / 1e9;
+
+    memset(resultats, 0, sizeof(ResultatStrategie) * t->nbStrategies);
+    for (int i = 0; i < nbFils; i++) {
+        for (int s = 0; s < t->nbStrategies; s++) {
+            resultats[s].parties += ouvriers[i].resultats[s].parties;
+            resultats[s].victoires += ouvriers[i].resultats[s].victoires;
+            resultats[s].points += ouvriers[i].resultats[s].points;
+        }
+        libererMem(ouvriers[i].resultats);
+        libererMem(files[i].taches);
+    }
+    libererMem(fils);
+    libererMem(ouvriers);
+    libererMem(files);
+    return secondes;
+}
\ No newline at end of file
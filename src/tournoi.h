@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "partie.h"
+
+
+/**
+ * @struct ResultatStrategie
+ * @brief Cumul des parties d'une stratégie (un nom de robot)
+ */
+typedef struct {
+    long parties;     /* Parties jouées */
+    long victoires;   /* Parties finies seul en tête */
+    long points;      /* Points marqués */
+} ResultatStrategie;
+
+/**
+ * @struct Tournoi
+ * @brief Série de parties indépendantes entre les mêmes robots. Chaque partie a son deck, son
+ *        état et son générateur, amorcé par la graine du tournoi et le numéro de la partie :
+ *        les résultats ne dépendent donc pas du nombre de fils
+ */
+typedef struct {
+    const ConfigJeu* config;
+    const Deck* modele;         /* Positions partagées en lecture par tous les decks */
+    char** strategies;          /* Nom de chaque joueur, tous des robots */
+    const Robot* robots;        /* Réglages lus dans ces noms */
+    int nbStrategies;
+    long nbParties;
+    uint64_t graine;
+    const Distances* distances; /* Calculées sur les positions du modèle, NULL sans bande de difficulté */
+    int distanceMin;
+    int distanceMax;
+    Journal* journal;           /* Partagé par toutes les parties, NULL pour ne rien journaliser */
+    CacheEffets* effets;        /* Partagé par toutes les parties, NULL pour juger sur une copie des piles */
+} Tournoi;
+
+
+
+/**
+ * @brief Joue toutes les parties du tournoi en les répartissant entre des fils. Chaque fil pioche
+ *        dans sa propre file à deux bouts et vole dans celles des autres quand elle est vide
+ * @param[in] t Pointeur vers le tournoi
+ * @param[in] nbFils Nombre de fils à utiliser
+ * @param[out] resultats Cumul par stratégie (t->nbStrategies cases)
+ * @return double Durée du tournoi en secondes
+ */
+double jouerTournoi(const Tournoi* t, int nbFils, ResultatStrategie* resultats);
\ No newline at end of file